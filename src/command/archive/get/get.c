@@ -39,6 +39,11 @@ Constants for log messages that are used multiple times to keep them consistent
 #define UNABLE_TO_FIND_VALID_REPO_MSG                               "unable to find a valid repository"
 #define REPO_INVALID_OR_ERR_MSG                                     "some repositories were invalid or encountered errors"
 
+/***********************************************************************************************************************************
+File in the spool path where the async process persists WAL path lists between runs
+***********************************************************************************************************************************/
+STRING_STATIC(ARCHIVE_GET_LIST_CACHE_FILE_STR,                      STORAGE_SPOOL_ARCHIVE "/archive-get.list");
+
 /***********************************************************************************************************************************
 Check for a list of archive files in the repository
 ***********************************************************************************************************************************/
@@ -83,12 +88,14 @@ typedef struct ArchiveGetFindCachePath
 {
     const String *path;                                             // Cached path in the archiveId
     const StringList *fileList;                                     // List of files in the cache path
+    bool loaded;                                                    // Loaded from the persistent cache so it may be stale
 } ArchiveGetFindCachePath;
 
 typedef struct ArchiveGetFindCacheArchive
 {
     const String *archiveId;                                        // ArchiveId in the repo
     List *pathList;                                                 // List of paths cached for archiveId
+    List *pathLoadList;                                             // List of paths loaded from the persistent cache
 } ArchiveGetFindCacheArchive;
 
 typedef struct ArchiveGetFindCacheRepo
@@ -100,6 +107,29 @@ typedef struct ArchiveGetFindCacheRepo
     StringList *warnList;                                           // Track repo warnings so each is only reported once
 } ArchiveGetFindCacheRepo;
 
+// Get files in a cached path list that match the requested archive file
+static StringList *
+archiveGetFindMatch(const StringList *const fileList, const String *const archiveFileRequest)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, fileList);
+        FUNCTION_TEST_PARAM(STRING, archiveFileRequest);
+    FUNCTION_TEST_END();
+
+    ASSERT(fileList != NULL);
+    ASSERT(archiveFileRequest != NULL);
+
+    StringList *const result = strLstNew();
+
+    for (unsigned int fileIdx = 0; fileIdx < strLstSize(fileList); fileIdx++)
+    {
+        if (strBeginsWith(strLstGet(fileList, fileIdx), archiveFileRequest))
+            strLstAdd(result, strLstGet(fileList, fileIdx));
+    }
+
+    FUNCTION_TEST_RETURN(STRING_LIST, result);
+}
+
 static bool
 archiveGetFind(
     const String *const archiveFileRequest, ArchiveGetCheckResult *const getCheckResult, List *const cacheRepoList,
@@ -169,10 +199,23 @@ archiveGetFind(
                             // Partial files cannot be in a list with multiple requests
                             ASSERT(!walIsPartial(archiveFileRequest));
 
-                            // If the path does not exist in the cache then fetch it
-                            const ArchiveGetFindCachePath *cachePath = lstFind(cacheArchive->pathList, &path);
+                            // If the path does not exist in the cache then use the persistent cache when available
+                            ArchiveGetFindCachePath *cachePath = lstFind(cacheArchive->pathList, &path);
 
                             if (cachePath == NULL)
+                            {
+                                const ArchiveGetFindCachePath *const cachePathLoad = lstFind(cacheArchive->pathLoadList, &path);
+
+                                if (cachePathLoad != NULL)
+                                    cachePath = lstAdd(cacheArchive->pathList, cachePathLoad);
+                            }
+
+                            // Get a list of all WAL segments that match
+                            segmentList = cachePath == NULL ? NULL : archiveGetFindMatch(cachePath->fileList, archiveFileRequest);
+
+                            // If the path is not in the cache then fetch it. A list loaded from the persistent cache may be stale so
+                            // also fetch the list again when no match is found.
+                            if (cachePath == NULL || (strLstEmpty(segmentList) && cachePath->loaded))
                             {
                                 MEM_CONTEXT_BEGIN(lstMemContext(cacheArchive->pathList))
                                 {
@@ -186,18 +229,14 @@ archiveGetFind(
                                                 "^%s[0-F]{8}-[0-f]{40}" COMPRESS_TYPE_REGEXP "{0,1}$", strZ(path))),
                                     };
 
-                                    cachePath = lstAdd(cacheArchive->pathList, &archiveGetFindCachePath);
+                                    if (cachePath == NULL)
+                                        cachePath = lstAdd(cacheArchive->pathList, &archiveGetFindCachePath);
+                                    else
+                                        *cachePath = archiveGetFindCachePath;
                                 }
                                 MEM_CONTEXT_END();
-                            }
 
-                            // Get a list of all WAL segments that match
-                            segmentList = strLstNew();
-
-                            for (unsigned int fileIdx = 0; fileIdx < strLstSize(cachePath->fileList); fileIdx++)
-                            {
-                                if (strBeginsWith(strLstGet(cachePath->fileList, fileIdx), archiveFileRequest))
-                                    strLstAdd(segmentList, strLstGet(cachePath->fileList, fileIdx));
+                                segmentList = archiveGetFindMatch(cachePath->fileList, archiveFileRequest);
                             }
                         }
 
@@ -361,6 +400,129 @@ archiveGetFind(
     FUNCTION_LOG_RETURN(BOOL, result);
 }
 
+// Load path lists persisted by a prior run of the async process. The lists are only used to find files that are known to exist and
+// a path is listed again when a requested file is not found, so lists that are out of date do not cause files to be missed.
+static void
+archiveGetFindCacheLoad(const List *const cacheRepoList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(LIST, cacheRepoList);
+    FUNCTION_LOG_END();
+
+    ASSERT(cacheRepoList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // The cache is only an optimization so ignore it if it cannot be read for any reason
+        TRY_BEGIN()
+        {
+            const Buffer *const buffer = storageGetP(
+                storageNewReadP(storageSpool(), ARCHIVE_GET_LIST_CACHE_FILE_STR, .ignoreMissing = true));
+
+            if (buffer != NULL)
+            {
+                PackRead *const read = pckReadNew(pckFromBuf(buffer));
+
+                while (pckReadNext(read))
+                {
+                    pckReadObjBeginP(read);
+
+                    const unsigned int repoKey = pckReadU32P(read);
+                    const String *const archiveId = pckReadStrP(read);
+                    const String *const path = pckReadStrP(read);
+                    const StringList *const fileList = pckReadStrLstP(read);
+
+                    pckReadObjEndP(read);
+
+                    // Add the path to the matching repo/archiveId if it is still in use
+                    for (unsigned int repoCacheIdx = 0; repoCacheIdx < lstSize(cacheRepoList); repoCacheIdx++)
+                    {
+                        const ArchiveGetFindCacheRepo *const cacheRepo = lstGet(cacheRepoList, repoCacheIdx);
+
+                        if (cfgOptionGroupIdxToKey(cfgOptGrpRepo, cacheRepo->repoIdx) != repoKey)
+                            continue;
+
+                        for (unsigned int archiveCacheIdx = 0; archiveCacheIdx < lstSize(cacheRepo->archiveList); archiveCacheIdx++)
+                        {
+                            const ArchiveGetFindCacheArchive *const cacheArchive = lstGet(cacheRepo->archiveList, archiveCacheIdx);
+
+                            if (strEq(cacheArchive->archiveId, archiveId))
+                            {
+                                MEM_CONTEXT_BEGIN(lstMemContext(cacheArchive->pathLoadList))
+                                {
+                                    const ArchiveGetFindCachePath archiveGetFindCachePath =
+                                    {
+                                        .path = strDup(path),
+                                        .fileList = strLstDup(fileList),
+                                        .loaded = true,
+                                    };
+
+                                    lstAdd(cacheArchive->pathLoadList, &archiveGetFindCachePath);
+                                }
+                                MEM_CONTEXT_END();
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        CATCH_ANY()
+        {
+            LOG_DETAIL_FMT("unable to load WAL path list cache: [%s] %s", errorTypeName(errorType()), errorMessage());
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+// Persist path lists used by this run so the next run of the async process can avoid listing them again
+static void
+archiveGetFindCacheSave(const List *const cacheRepoList)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(LIST, cacheRepoList);
+    FUNCTION_LOG_END();
+
+    ASSERT(cacheRepoList != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const write = pckWriteNewP();
+
+        for (unsigned int repoCacheIdx = 0; repoCacheIdx < lstSize(cacheRepoList); repoCacheIdx++)
+        {
+            const ArchiveGetFindCacheRepo *const cacheRepo = lstGet(cacheRepoList, repoCacheIdx);
+
+            for (unsigned int archiveCacheIdx = 0; archiveCacheIdx < lstSize(cacheRepo->archiveList); archiveCacheIdx++)
+            {
+                const ArchiveGetFindCacheArchive *const cacheArchive = lstGet(cacheRepo->archiveList, archiveCacheIdx);
+
+                for (unsigned int pathCacheIdx = 0; pathCacheIdx < lstSize(cacheArchive->pathList); pathCacheIdx++)
+                {
+                    const ArchiveGetFindCachePath *const cachePath = lstGet(cacheArchive->pathList, pathCacheIdx);
+
+                    pckWriteObjBeginP(write);
+                    pckWriteU32P(write, cfgOptionGroupIdxToKey(cfgOptGrpRepo, cacheRepo->repoIdx));
+                    pckWriteStrP(write, cacheArchive->archiveId);
+                    pckWriteStrP(write, cachePath->path);
+                    pckWriteStrLstP(write, cachePath->fileList);
+                    pckWriteObjEndP(write);
+                }
+            }
+        }
+
+        pckWriteEndP(write);
+
+        storagePutP(
+            storageNewWriteP(storageSpoolWrite(), ARCHIVE_GET_LIST_CACHE_FILE_STR), pckToBuf(pckWriteResult(write)));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 static ArchiveGetCheckResult
 archiveGetCheck(const StringList *const archiveRequestList)
 {
@@ -455,6 +617,7 @@ archiveGetCheck(const StringList *const archiveRequestList)
                             ArchiveGetFindCacheArchive cacheArchive =
                             {
                                 .pathList = lstNewP(sizeof(ArchiveGetFindCachePath), .comparator = lstComparatorStr),
+                                .pathLoadList = lstNewP(sizeof(ArchiveGetFindCachePath), .comparator = lstComparatorStr),
                             };
 
                             // Copy archiveId into the result list context once rather than making a copy per candidate file later
@@ -513,17 +676,22 @@ archiveGetCheck(const StringList *const archiveRequestList)
             }
             MEM_CONTEXT_END();
 
+            // When multiple files are requested the path lists are cached and persisted between runs of the async process
+            const bool single = strLstSize(archiveRequestList) == 1;
+
+            if (!single)
+                archiveGetFindCacheLoad(cacheRepoList);
+
             // Find files in the list
             for (unsigned int archiveRequestIdx = 0; archiveRequestIdx < strLstSize(archiveRequestList); archiveRequestIdx++)
             {
-                if (!archiveGetFind(
-                        strLstGet(archiveRequestList, archiveRequestIdx), &result, cacheRepoList, warnList,
-                        strLstSize(archiveRequestList) == 1))
-                {
+                if (!archiveGetFind(strLstGet(archiveRequestList, archiveRequestIdx), &result, cacheRepoList, warnList, single))
                     break;
-                }
             }
 
+            if (!single)
+                archiveGetFindCacheSave(cacheRepoList);
+
             // Sort the list to make searching for files faster
             lstSort(result.archiveFileMapList, sortOrderAsc);
         }
@@ -1017,6 +1185,9 @@ cmdArchiveGetAsync(void)
                             // Else the job errored
                             else
                             {
+                                // Remove the persistent cache in case the error was caused by a stale path list
+                                storageRemoveP(storageSpoolWrite(), ARCHIVE_GET_LIST_CACHE_FILE_STR);
+
                                 LOG_WARN_PID_FMT(
                                     processId, "[%s] %s", errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(job))),
                                     strZ(protocolParallelJobErrorMessage(job)));
@@ -617,6 +617,18 @@ backupBuildIncrPrior(const InfoBackup *const infoBackup)
                         cfgOptCompressLevel, cfgSourceParam, VARINT64(varUInt(manifestPriorData->backupOptionCompressLevel)));
                 }
 
+                // Warn if checksum-type option changed. Files are referenced from the prior backup by checksum so all backups in a
+                // set must use the same checksum type.
+                if (cfgOptionStrId(cfgOptChecksumType) != manifestPriorData->backupOptionChecksumType)
+                {
+                    LOG_WARN_FMT(
+                        "%s backup cannot alter " CFGOPT_CHECKSUM_TYPE " option to '%s', reset to value in %s",
+                        strZ(cfgOptionDisplay(cfgOptType)), strZ(cfgOptionDisplay(cfgOptChecksumType)), strZ(backupLabelPrior));
+
+                    cfgOptionSet(
+                        cfgOptChecksumType, cfgSourceParam, VARSTR(strIdToStr(manifestPriorData->backupOptionChecksumType)));
+                }
+
                 // If not defined this backup was done in a version prior to page checksums being introduced. Just set checksum-page
                 // to false and move on without a warning. Page checksums will start on the next full backup.
                 if (manifestData(result)->backupOptionChecksumPage == NULL)
@@ -962,6 +974,16 @@ backupResumeFind(const Manifest *const manifest, const String *const cipherPassB
                                         strZ(cfgOptionDisplay(cfgOptCompressType)),
                                         strZ(compressTypeStr(manifestResumeData->backupOptionCompressType)));
                                 }
+                                // Check checksum type since checksums of resumed files must match the new backup
+                                else if (
+                                    manifestResumeData->backupOptionChecksumType !=
+                                    manifestData(manifest)->backupOptionChecksumType)
+                                {
+                                    reason = strNewFmt(
+                                        "new checksum type '%s' does not match resumable checksum type '%s'",
+                                        strZ(strIdToStr(manifestData(manifest)->backupOptionChecksumType)),
+                                        strZ(strIdToStr(manifestResumeData->backupOptionChecksumType)));
+                                }
                                 else
                                     usable = true;
                             }
@@ -1175,8 +1197,8 @@ backupFilePut(
 
             IoFilterGroup *const filterGroup = ioWriteFilterGroup(storageWriteIo(write));
 
-            // Add SHA1 filter
-            ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
+            // Add checksum filter
+            ioFilterGroupAdd(filterGroup, cryptoHashNew(manifestData(manifest)->backupOptionChecksumType));
 
             // Add compression
             if (compressType != compressTypeNone)
@@ -1200,7 +1222,7 @@ backupFilePut(
 
             // Capture checksum of file stored in the repo if filters that modify the output have been applied
             if (repoChecksum)
-                ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
+                ioFilterGroupAdd(filterGroup, cryptoHashNew(manifestData(manifest)->backupOptionChecksumType));
 
             // Add size filter last to calculate repo size
             ioFilterGroupAdd(filterGroup, ioSizeNew());
@@ -1502,7 +1524,8 @@ backupJobResult(
                             " continue but this may be an issue unless the resumed backup path in the repository is known to be"
                             " corrupted.\n"
                             "NOTE: this does not indicate a problem with the PostgreSQL page checksums.",
-                            strZ(file.name), strZ(strNewEncode(encodingHex, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE))));
+                            strZ(file.name),
+                            strZ(strNewEncode(encodingHex, BUF(file.checksumSha1, manifestChecksumSize(manifest)))));
                     }
 
                     // If the file had page checksums calculated during the copy
@@ -1694,6 +1717,13 @@ typedef struct BackupJobData
     const PgPageSize pageSize;                                      // Page size
     const CompressType compressType;                                // Backup compression type
     const int compressLevel;                                        // Compress level if backup is compressed
+    const unsigned int compressThread;                              // Threads to compress large files with
+    const uint64_t compressThreadSize;                              // Minimum file size to compress with threads
+    const bool compressLong;                                        // Compress with long distance matching?
+    const bool compressAdapt;                                       // Use minimum compress level for incompressible data?
+    const bool compressSeek;                                        // Compress as independent frames with a seek table?
+    const bool pipeline;                                            // Run filters on separate threads for large files?
+    const uint64_t pipelineSize;                                    // Minimum file size to run filters on separate threads
     const bool delta;                                               // Is this a checksum delta backup?
     const bool bundle;                                              // Bundle files?
     uint64_t bundleSize;                                            // Target bundle size
@@ -1721,6 +1751,25 @@ backupProcessFilePrimary(RegExp *const standbyExp, const String *const name)
         BOOL, strEqZ(name, MANIFEST_TARGET_PGDATA "/" PG_PATH_GLOBAL "/" PG_FILE_PGCONTROL) || !regExpMatch(standbyExp, name));
 }
 
+// Identify files that should be compressed with long distance matching. Only large files in full backups are included since small
+// files have little distant repeated data to find and do not justify the additional memory. Block incremental files are excluded
+// since blocks are compressed separately.
+#define BACKUP_COMPRESS_LONG_SIZE_MIN                               ((uint64_t)16 * 1024 * 1024)
+
+static bool
+backupProcessFileCompressLong(const bool compressLong, const BackupType backupType, const uint64_t size, const bool blockIncr)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BOOL, compressLong);
+        FUNCTION_TEST_PARAM(STRING_ID, backupType);
+        FUNCTION_TEST_PARAM(UINT64, size);
+        FUNCTION_TEST_PARAM(BOOL, blockIncr);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(
+        BOOL, compressLong && backupType == backupTypeFull && size >= BACKUP_COMPRESS_LONG_SIZE_MIN && !blockIncr);
+}
+
 // Comparator to order ManifestFile objects by size, date, and name
 static const Manifest *backupProcessQueueComparatorManifest = NULL;
 static bool backupProcessQueueComparatorBundle;
@@ -2003,8 +2052,9 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
 
                     pckWriteU32P(param, jobData->compressType);
                     pckWriteI32P(param, jobData->compressLevel);
-                    pckWriteU64P(param, jobData->cipherSubPass == NULL ? cipherTypeNone : cipherTypeAes256Cbc);
+                    pckWriteU64P(param, jobData->cipherSubPass == NULL ? cipherTypeNone : jobData->cipherType);
                     pckWriteStrP(param, jobData->cipherSubPass);
+                    pckWriteStrIdP(param, manifestData(jobData->manifest)->backupOptionChecksumType);
                     pckWriteU32P(param, jobData->pageSize);
                     pckWriteStrP(param, cfgOptionStrNull(cfgOptPgVersionForce));
                 }
@@ -2015,7 +2065,8 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
                 pckWriteU64P(param, file.size);
                 pckWriteU64P(param, file.sizeOriginal);
                 pckWriteBoolP(param, !backupProcessFilePrimary(jobData->standbyExp, file.name));
-                pckWriteBinP(param, file.checksumSha1 != NULL ? BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE) : NULL);
+                pckWriteBinP(
+                    param, file.checksumSha1 != NULL ? BUF(file.checksumSha1, manifestChecksumSize(jobData->manifest)) : NULL);
                 pckWriteBoolP(param, file.checksumPage);
                 pckWriteBoolP(param, cfgOptionBool(cfgOptPageHeaderCheck));
 
@@ -2041,8 +2092,24 @@ backupJobCallback(void *const data, const unsigned int clientIdx)
                 else
                     pckWriteU64P(param, 0);
 
+                // Compress large files with threads, use long distance matching for large files in full backups, and use adaptive
+                // compression and seekable compression when enabled. Block incremental files are excluded since blocks are
+                // compressed separately.
+                pckWriteU32P(param, !blockIncr && file.size >= jobData->compressThreadSize ? jobData->compressThread : 0);
+                pckWriteBoolP(
+                    param,
+                    backupProcessFileCompressLong(
+                        jobData->compressLong, manifestData(jobData->manifest)->backupType, file.size, blockIncr));
+                pckWriteBoolP(param, !blockIncr && jobData->compressAdapt);
+                pckWriteBoolP(param, !blockIncr && jobData->compressSeek);
+
+                // Run filters on separate threads for large files when enabled
+                pckWriteBoolP(param, jobData->pipeline && file.size >= jobData->pipelineSize);
+
                 pckWriteStrP(param, file.name);
-                pckWriteBinP(param, file.checksumRepoSha1 != NULL ? BUF(file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE) : NULL);
+                pckWriteBinP(
+                    param,
+                    file.checksumRepoSha1 != NULL ? BUF(file.checksumRepoSha1, manifestChecksumSize(jobData->manifest)) : NULL);
                 pckWriteU64P(param, file.sizeRepo);
                 pckWriteBoolP(param, file.resume);
                 pckWriteBoolP(param, file.reference != NULL);
@@ -2114,6 +2181,13 @@ backupProcess(const BackupData *const backupData, Manifest *const manifest, cons
             .backupStandby = backupData->dbStandby != NULL,
             .compressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressType)),
             .compressLevel = cfgOptionInt(cfgOptCompressLevel),
+            .compressThread = cfgOptionUInt(cfgOptCompressThread),
+            .compressThreadSize = cfgOptionUInt64(cfgOptCompressThreadSize),
+            .compressLong = cfgOptionBool(cfgOptCompressLong),
+            .compressAdapt = cfgOptionBool(cfgOptCompressAdapt),
+            .compressSeek = cfgOptionBool(cfgOptCompressSeek),
+            .pipeline = cfgOptionBool(cfgOptPipeline),
+            .pipelineSize = cfgOptionUInt64(cfgOptPipelineSize),
             .cipherType = cfgOptionStrId(cfgOptRepoCipherType),
             .cipherSubPass = manifestCipherSubPass(manifest),
             .pageSize = backupData->pageSize,
@@ -2374,6 +2448,10 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
                         const CompressType archiveCompressType = compressTypeFromName(archiveFile);
                         const CompressType backupCompressType = compressTypeEnum(cfgOptionStrId(cfgOptCompressType));
 
+                        // The WAL segment name contains a sha1 checksum so the segment only needs to be checksummed for other types
+                        const HashType checksumType = manifestData(manifest)->backupOptionChecksumType;
+                        const bool checksum = checksumType != hashTypeSha1;
+
                         // Open the archive file
                         StorageRead *const read = storageNewReadP(
                             storageRepo(),
@@ -2385,12 +2463,16 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
                             filterGroup, cfgOptionStrId(cfgOptRepoCipherType), cipherModeDecrypt,
                             infoArchiveCipherPass(backupData->archiveInfo));
 
-                        // Compress/decompress if archive and backup do not have the same compression settings
-                        if (archiveCompressType != backupCompressType)
+                        // Compress/decompress if archive and backup do not have the same compression settings or a checksum is
+                        // required
+                        if (archiveCompressType != backupCompressType || checksum)
                         {
                             if (archiveCompressType != compressTypeNone)
                                 ioFilterGroupAdd(filterGroup, decompressFilterP(archiveCompressType));
 
+                            if (checksum)
+                                ioFilterGroupAdd(filterGroup, cryptoHashNew(checksumType));
+
                             if (backupCompressType != compressTypeNone)
                             {
                                 ioFilterGroupAdd(
@@ -2428,7 +2510,10 @@ backupArchiveCheckCopy(const BackupData *const backupData, Manifest *const manif
                             .sizeOriginal = backupData->walSegmentSize,
                             .sizeRepo = pckReadU64P(ioFilterGroupResultP(filterGroup, SIZE_FILTER_TYPE)),
                             .timestamp = manifestData(manifest)->backupTimestampStop,
-                            .checksumSha1 = bufPtr(bufNewDecode(encodingHex, strSubN(archiveFile, 25, 40))),
+                            .checksumSha1 = bufPtr(
+                                checksum ?
+                                    pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE)) :
+                                    bufNewDecode(encodingHex, strSubN(archiveFile, 25, 40))),
                         };
 
                         manifestFileAdd(manifest, &file);
@@ -2576,8 +2661,9 @@ cmdBackup(void)
 
         Manifest *const manifest = manifestNewBuild(
             backupData->storagePrimary, infoPg.version, infoPg.catalogVersion, timestampStart, cfgOptionBool(cfgOptOnline),
-            cfgOptionBool(cfgOptChecksumPage), cfgOptionBool(cfgOptRepoBundle), cfgOptionBool(cfgOptRepoBlock), &blockIncrMap,
-            strLstNewVarLst(cfgOptionLst(cfgOptExclude)), backupStartResult.tablespaceList);
+            cfgOptionBool(cfgOptChecksumPage), cfgOptionBool(cfgOptRepoBundle), cfgOptionBool(cfgOptRepoBlock),
+            (HashType)cfgOptionStrId(cfgOptChecksumType), &blockIncrMap, strLstNewVarLst(cfgOptionLst(cfgOptExclude)),
+            backupStartResult.tablespaceList);
 
         // Validate the manifest using the copy start time
         manifestBuildValidate(
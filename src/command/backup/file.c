@@ -41,7 +41,8 @@ FN_EXTERN List *
 backupFile(
     const String *const repoFile, const uint64_t bundleId, const bool bundleRaw, const unsigned int blockIncrReference,
     const CompressType repoFileCompressType, const int repoFileCompressLevel, const CipherType cipherType,
-    const String *const cipherPass, const String *const pgVersionForce, const PgPageSize pageSize, const List *const fileList)
+    const String *const cipherPass, const HashType checksumType, const String *const pgVersionForce, const PgPageSize pageSize,
+    const List *const fileList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, repoFile);                       // Repo file
@@ -52,6 +53,7 @@ backupFile(
         FUNCTION_LOG_PARAM(INT, repoFileCompressLevel);             // Compression level for repo file
         FUNCTION_LOG_PARAM(STRING_ID, cipherType);                  // Encryption type
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
+        FUNCTION_LOG_PARAM(STRING_ID, checksumType);                // Checksum type
         FUNCTION_LOG_PARAM(ENUM, pageSize);                         // Page size
         FUNCTION_LOG_PARAM(STRING, pgVersionForce);                 // Force pg version
         FUNCTION_LOG_PARAM(LIST, fileList);                         // List of files to backup
@@ -94,7 +96,7 @@ backupFile(
                         storageNewReadP(
                             storagePg(), file->pgFile, .ignoreMissing = file->pgFileIgnoreMissing,
                             .limit = file->pgFileCopyExactSize ? VARUINT64(file->pgFileSizeOriginal) : NULL));
-                    ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
+                    ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(checksumType));
                     ioFilterGroupAdd(ioReadFilterGroup(read), ioSizeNew());
 
                     // If the pg file exists check the checksum/size
@@ -144,7 +146,7 @@ backupFile(
                     {
                         // Generate checksum/size for the repo file
                         IoRead *const read = storageReadIo(storageNewReadP(storageRepo(), repoFile));
-                        ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
+                        ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(checksumType));
                         ioFilterGroupAdd(ioReadFilterGroup(read), ioSizeNew());
                         ioReadDrain(read);
 
@@ -211,7 +213,7 @@ backupFile(
                                 .limit = file->pgFileCopyExactSize ? VARUINT64(file->pgFileSizeOriginal) : NULL));
                     }
 
-                    ioFilterGroupAdd(ioReadFilterGroup(readIo), cryptoHashNew(hashTypeSha1));
+                    ioFilterGroupAdd(ioReadFilterGroup(readIo), cryptoHashNew(checksumType));
                     ioFilterGroupAdd(ioReadFilterGroup(readIo), ioSizeNew());
 
                     // Add page checksum filter
@@ -228,7 +230,9 @@ backupFile(
                     IoFilter *const compress =
                         repoFileCompressType != compressTypeNone ?
                             compressFilterP(
-                                repoFileCompressType, repoFileCompressLevel, .raw = bundleRaw || file->blockIncrSize != 0) :
+                                repoFileCompressType, repoFileCompressLevel, .raw = bundleRaw || file->blockIncrSize != 0,
+                                .thread = file->repoFileCompressThread, .longDistance = file->repoFileCompressLong,
+                                .adapt = file->repoFileCompressAdapt, .seek = file->repoFileCompressSeek) :
                             NULL;
 
                     // Encrypt filter
@@ -290,11 +294,14 @@ backupFile(
 
                     // Capture checksum of file stored in the repo if filters that modify the output have been applied
                     if (repoChecksum)
-                        ioFilterGroupAdd(ioReadFilterGroup(readIo), cryptoHashNew(hashTypeSha1));
+                        ioFilterGroupAdd(ioReadFilterGroup(readIo), cryptoHashNew(checksumType));
 
                     // Add size filter last to calculate repo size
                     ioFilterGroupAdd(ioReadFilterGroup(readIo), ioSizeNew());
 
+                    // Run filters on separate threads when requested
+                    ioFilterGroupPipelineSet(ioReadFilterGroup(readIo), file->pgFilePipeline);
+
                     // Open the source
                     if (ioReadOpen(readIo))
                     {
@@ -320,7 +327,7 @@ backupFile(
                             if (bundleId != 0 && fileResult->copySize == 0)
                             {
                                 fileResult->backupCopyResult = backupCopyResultTruncate;
-                                fileResult->copyChecksum = HASH_TYPE_SHA1_ZERO_BUF;
+                                fileResult->copyChecksum = cryptoHashZero(checksumType);
 
                                 ASSERT(
                                     bufEq(
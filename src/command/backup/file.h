@@ -42,6 +42,11 @@ typedef struct BackupFile
     const String *blockIncrMapPriorFile;                            // File containing prior block incremental map (NULL if none)
     uint64_t blockIncrMapPriorOffset;                               // Offset of prior block incremental map
     uint64_t blockIncrMapPriorSize;                                 // Size of prior block incremental map
+    unsigned int repoFileCompressThread;                            // Threads to compress with (0 or 1 for one thread)
+    bool repoFileCompressLong;                                      // Compress with long distance matching?
+    bool repoFileCompressAdapt;                                     // Use minimum compress level for incompressible data?
+    bool repoFileCompressSeek;                                      // Compress as independent frames with a seek table?
+    bool pgFilePipeline;                                            // Run filters on separate threads?
     const String *manifestFile;                                     // Repo file
     const Buffer *repoFileChecksum;                                 // Expected repo file checksum
     uint64_t repoFileSize;                                          // Expected repo file size
@@ -65,7 +70,7 @@ typedef struct BackupFileResult
 
 FN_EXTERN List *backupFile(
     const String *repoFile, uint64_t bundleId, bool bundleRaw, unsigned int blockIncrReference, CompressType repoFileCompressType,
-    int repoFileCompressLevel, CipherType cipherType, const String *cipherPass, const String *pgVersionForce, PgPageSize pageSize,
-    const List *fileList);
+    int repoFileCompressLevel, CipherType cipherType, const String *cipherPass, HashType checksumType, const String *pgVersionForce,
+    PgPageSize pageSize, const List *fileList);
 
 #endif
@@ -37,6 +37,7 @@ backupFileProtocol(PackRead *const param)
         const int repoFileCompressLevel = pckReadI32P(param);
         const CipherType cipherType = (CipherType)pckReadU64P(param);
         const String *const cipherPass = pckReadStrP(param);
+        const HashType checksumType = (HashType)pckReadStrIdP(param);
         const PgPageSize pageSize = pckReadU32P(param);
         const String *const pgVersionForce = pckReadStrP(param);
 
@@ -69,6 +70,11 @@ backupFileProtocol(PackRead *const param)
                 }
             }
 
+            file.repoFileCompressThread = pckReadU32P(param);
+            file.repoFileCompressLong = pckReadBoolP(param);
+            file.repoFileCompressAdapt = pckReadBoolP(param);
+            file.repoFileCompressSeek = pckReadBoolP(param);
+            file.pgFilePipeline = pckReadBoolP(param);
             file.manifestFile = pckReadStrP(param);
             file.repoFileChecksum = pckReadBinP(param);
             file.repoFileSize = pckReadU64P(param);
@@ -81,7 +87,7 @@ backupFileProtocol(PackRead *const param)
         // Backup file
         const List *const resultList = backupFile(
             repoFile, bundleId, bundleRaw, blockIncrReference, repoFileCompressType, repoFileCompressLevel, cipherType, cipherPass,
-            pgVersionForce, pageSize, fileList);
+            checksumType, pgVersionForce, pageSize, fileList);
 
         // Return result
         PackWrite *const data = protocolServerResultData(result);
@@ -92,7 +98,7 @@ backupFileProtocol(PackRead *const param)
 
             ASSERT(
                 fileResult->backupCopyResult == backupCopyResultSkip || fileResult->copySize != 0 ||
-                bufEq(fileResult->copyChecksum, HASH_TYPE_SHA1_ZERO_BUF));
+                bufEq(fileResult->copyChecksum, cryptoHashZero(checksumType)));
 
             pckWriteStrP(data, fileResult->manifestFile);
             pckWriteU32P(data, fileResult->backupCopyResult);
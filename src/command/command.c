@@ -8,6 +8,7 @@ Common Command Routines
 
 #include "command/command.h"
 #include "common/debug.h"
+#include "common/io/filter/stat.h"
 #include "common/log.h"
 #include "common/memContext.h"
 #include "common/stat.h"
@@ -190,6 +191,42 @@ cmdBegin(void)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Log filter stats collected by this process and any locals/remotes it started, and add them to the command statistics
+***********************************************************************************************************************************/
+static void
+cmdEndFilterStat(void)
+{
+    FUNCTION_TEST_VOID();
+
+    const List *const totalList = ioFilterStatTotalList();
+
+    if (totalList != NULL)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            for (unsigned int totalIdx = 0; totalIdx < lstSize(totalList); totalIdx++)
+            {
+                const IoFilterStatTotal *const total = lstGet(totalList, totalIdx);
+                const String *const type = strIdToStr(total->type);
+
+                LOG_INFO_FMT(
+                    "filter %s: in %s, out %s, cpu %" PRIu64 "ms, wall %" PRIu64 "ms", strZ(type),
+                    strZ(strSizeFormat(total->stat.bytesIn)), strZ(strSizeFormat(total->stat.bytesOut)),
+                    total->stat.timeCpu / 1000000, total->stat.timeWall / 1000000);
+
+                statAdd(strNewFmt("filter.%s.bytes-in", strZ(type)), total->stat.bytesIn);
+                statAdd(strNewFmt("filter.%s.bytes-out", strZ(type)), total->stat.bytesOut);
+                statAdd(strNewFmt("filter.%s.cpu-ms", strZ(type)), total->stat.timeCpu / 1000000);
+                statAdd(strNewFmt("filter.%s.wall-ms", strZ(type)), total->stat.timeWall / 1000000);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 cmdEnd(const int code, const String *const errorMessage)
@@ -206,6 +243,9 @@ cmdEnd(const int code, const String *const errorMessage)
     {
         MEM_CONTEXT_TEMP_BEGIN()
         {
+            // Log filter stats and add them to the statistics
+            cmdEndFilterStat();
+
             // Output statistics if there are any
             const String *const statJson = statToJson();
 
@@ -203,7 +203,7 @@ cmdManifestBlockDeltaRender(const Manifest *const manifest, const ManifestFile *
         if (cfgOptionSource(cfgOptPg) != cfgSourceDefault)
         {
             IoRead *const read = storageReadIo(storageNewReadP(storagePg(), manifestPathPg(file->name)));
-            ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
+            ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(manifestData(manifest)->backupOptionChecksumType));
             ioFilterGroupAdd(ioReadFilterGroup(read), blockChecksumNew(file->blockIncrSize, file->blockIncrChecksumSize));
             ioReadDrain(read);
 
@@ -212,7 +212,7 @@ cmdManifestBlockDeltaRender(const Manifest *const manifest, const ManifestFile *
         }
 
         // If the file is up-to-date
-        if (checksum != NULL && bufEq(checksum, BUF(file->checksumSha1, HASH_TYPE_SHA1_SIZE)))
+        if (checksum != NULL && bufEq(checksum, BUF(file->checksumSha1, manifestChecksumSize(manifest))))
         {
             if (json)
                 strCatZ(result, "null");
@@ -236,7 +236,8 @@ cmdManifestBlockDeltaRender(const Manifest *const manifest, const ManifestFile *
                 ioFilterGroupAdd(
                     ioReadFilterGroup(storageReadIo(read)),
                     cipherBlockNewP(
-                        cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(manifestCipherSubPass(manifest)), .raw = true));
+                        cipherModeDecrypt, cfgOptionStrId(cfgOptRepoCipherType), BUFSTR(manifestCipherSubPass(manifest)),
+                        .raw = true));
             }
 
             ioReadOpen(storageReadIo(read));
@@ -369,7 +370,8 @@ cmdManifestFileRender(const Manifest *const manifest, const ManifestFile *const
 
             strCatFmt(result, ",\"size\":%" PRIu64, file->size);
             strCatFmt(
-                result, ",\"checksum\":\"%s\"", strZ(strNewEncode(encodingHex, BUF(file->checksumSha1, HASH_TYPE_SHA1_SIZE))));
+                result, ",\"checksum\":\"%s\"",
+                strZ(strNewEncode(encodingHex, BUF(file->checksumSha1, manifestChecksumSize(manifest)))));
             strCatFmt(result, ",\"repo\":{\"size\":%" PRIu64 "}", file->sizeRepo);
 
             if (file->bundleId != 0)
@@ -397,7 +399,9 @@ cmdManifestFileRender(const Manifest *const manifest, const ManifestFile *const
 
             strCatFmt(
                 result, "      size: %s, repo %s\n", strZ(strSizeFormat(file->size)), strZ(strSizeFormat(file->sizeRepo)));
-            strCatFmt(result, "      checksum: %s\n", strZ(strNewEncode(encodingHex, BUF(file->checksumSha1, HASH_TYPE_SHA1_SIZE))));
+            strCatFmt(
+                result, "      checksum: %s\n",
+                strZ(strNewEncode(encodingHex, BUF(file->checksumSha1, manifestChecksumSize(manifest)))));
 
             if (file->bundleId != 0)
                 strCatFmt(result, "      bundle: %" PRIu64 "\n", file->bundleId);
@@ -442,7 +446,7 @@ cmdManifestRender(void)
             storageRepo(), INFO_BACKUP_PATH_FILE_STR, cfgOptionStrId(cfgOptRepoCipherType),
             cfgOptionStrNull(cfgOptRepoCipherPass));
         const String *const cipherPass = infoPgCipherPass(infoBackupPg(infoBackup));
-        const CipherType cipherType = cipherPass == NULL ? cipherTypeNone : cipherTypeAes256Cbc;
+        const CipherType cipherType = cipherPass == NULL ? cipherTypeNone : cfgOptionStrId(cfgOptRepoCipherType);
 
         // Load manifest
         const Manifest *const manifest = manifestLoadFile(
@@ -7,6 +7,8 @@ Repository Get Command
 
 #include "command/repo/common.h"
 #include "command/repo/get.h"
+#include "common/compress/helper.h"
+#include "common/compress/zst/seek.h"
 #include "common/crypto/cipherBlock.h"
 #include "common/debug.h"
 #include "common/io/fdWrite.h"
@@ -20,29 +22,126 @@ Repository Get Command
 #include "info/infoBackup.h"
 
 /***********************************************************************************************************************************
-Write source file to destination IO
+Write a range of a seekable zst file to destination IO. The seek table is used to read and decompress only the frames that contain
+the range.
 ***********************************************************************************************************************************/
 static int
-storageGetProcess(IoWrite *const destination)
+storageGetRange(const String *const file, IoWrite *const destination)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
-        FUNCTION_LOG_PARAM(IO_READ, destination);
+        FUNCTION_LOG_PARAM(STRING, file);
+        FUNCTION_LOG_PARAM(IO_WRITE, destination);
     FUNCTION_LOG_END();
 
-    // Get source file
-    if (strLstSize(cfgCommandParam()) != 1)
-        THROW(ParamRequiredError, "source file required");
+    ASSERT(file != NULL);
+    ASSERT(destination != NULL);
 
-    const String *file = strLstGet(cfgCommandParam(), 0);
+    // Frames are read directly from storage so the data must not be transformed other than by decompression
+    if (cfgOptionBool(cfgOptRaw))
+        THROW(OptionInvalidError, "option '" CFGOPT_OFFSET "' and '" CFGOPT_LIMIT "' cannot be used with '" CFGOPT_RAW "'");
+
+    if (cfgOptionStrId(cfgOptRepoCipherType) != cipherTypeNone)
+        THROW(OptionInvalidError, "option '" CFGOPT_OFFSET "' and '" CFGOPT_LIMIT "' cannot be used with an encrypted repository");
 
     // Assume the file is missing
     int result = 1;
 
+#ifdef HAVE_LIBZST
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Is path valid for repo?
-        file = repoPathIsValid(file);
+        const StorageInfo info = storageInfoP(storageRepo(), file, .ignoreMissing = cfgOptionBool(cfgOptIgnoreMissing));
+
+        if (info.exists)
+        {
+            // Load the seek table from the end of the file
+            const Buffer *const footer = storageGetP(
+                storageNewReadP(
+                    storageRepo(), file, .offset = info.size > ZST_SEEK_FOOTER_SIZE ? info.size - ZST_SEEK_FOOTER_SIZE : 0));
+
+            if (bufUsed(footer) < ZST_SEEK_FOOTER_SIZE || zstSeekTableSize(footer) == 0)
+                THROW_FMT(FormatError, "'%s' is not a seekable zst file", strZ(file));
+
+            const size_t tableSize = zstSeekTableSize(footer);
+            const ZstSeekTable *const table = zstSeekTableNew(
+                storageGetP(storageNewReadP(storageRepo(), file, .offset = info.size > tableSize ? info.size - tableSize : 0)));
+
+            // Open the destination file now that we know the source exists and is readable
+            ioWriteOpen(destination);
+
+            // Write the range, if any of it is in the file
+            const uint64_t offset = cfgOptionUInt64(cfgOptOffset);
+            const uint64_t sizeDecompressed = zstSeekTableSizeDecompressed(table);
+
+            if (offset < sizeDecompressed)
+            {
+                uint64_t size = sizeDecompressed - offset;
+
+                if (cfgOptionTest(cfgOptLimit) && cfgOptionUInt64(cfgOptLimit) < size)
+                    size = cfgOptionUInt64(cfgOptLimit);
+
+                // Read only the frames that contain the range
+                const ZstSeekRange range = zstSeekTableRange(table, offset, size);
+                IoRead *const source = storageReadIo(
+                    storageNewReadP(storageRepo(), file, .offset = range.offset, .limit = VARUINT64(range.size)));
+
+                ioFilterGroupAdd(ioReadFilterGroup(source), decompressFilterP(compressTypeZst));
+                ioReadOpen(source);
+
+                // Skip data in the first frame before the range and stop writing at the end of the range
+                Buffer *const buffer = bufNew(ioBufferSize());
+                uint64_t skip = range.skip;
+
+                while (!ioReadEof(source))
+                {
+                    ioRead(source, buffer);
+
+                    const size_t skipSize = skip < bufUsed(buffer) ? (size_t)skip : bufUsed(buffer);
+                    const size_t writeSize = bufUsed(buffer) - skipSize < size ? bufUsed(buffer) - skipSize : (size_t)size;
+
+                    ioWrite(destination, BUF(bufPtrConst(buffer) + skipSize, writeSize));
+
+                    skip -= skipSize;
+                    size -= writeSize;
+                    bufUsedZero(buffer);
+                }
+
+                ioReadClose(source);
+            }
+
+            ioWriteClose(destination);
+
+            // Source file exists
+            result = 0;
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+#else
+    // Seekable files are only written with zst compression
+    compressTypePresent(compressTypeZst);
+#endif
+
+    FUNCTION_LOG_RETURN(INT, result);
+}
 
+/***********************************************************************************************************************************
+Write an entire file to destination IO
+***********************************************************************************************************************************/
+static int
+storageGetFile(const String *const file, IoWrite *const destination)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STRING, file);
+        FUNCTION_LOG_PARAM(IO_WRITE, destination);
+    FUNCTION_LOG_END();
+
+    ASSERT(file != NULL);
+    ASSERT(destination != NULL);
+
+    // Assume the file is missing
+    int result = 1;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
         // Create new file read
         IoRead *const source = storageReadIo(
             storageNewReadP(storageRepo(), file, .ignoreMissing = cfgOptionBool(cfgOptIgnoreMissing)));
@@ -164,6 +263,42 @@ storageGetProcess(IoWrite *const destination)
     FUNCTION_LOG_RETURN(INT, result);
 }
 
+/***********************************************************************************************************************************
+Write source file to destination IO
+***********************************************************************************************************************************/
+static int
+storageGetProcess(IoWrite *const destination)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(IO_READ, destination);
+    FUNCTION_LOG_END();
+
+    // Get source file
+    if (strLstSize(cfgCommandParam()) != 1)
+        THROW(ParamRequiredError, "source file required");
+
+    const String *file = strLstGet(cfgCommandParam(), 0);
+
+    // Assume the file is missing
+    int result = 1;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Is path valid for repo?
+        file = repoPathIsValid(file);
+
+        // Get a range of a seekable file
+        if (cfgOptionUInt64(cfgOptOffset) != 0 || cfgOptionTest(cfgOptLimit))
+            result = storageGetRange(file, destination);
+        // Else get the entire file
+        else
+            result = storageGetFile(file, destination);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(INT, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN int
 cmdStorageGet(void)
@@ -6,6 +6,7 @@ Block Restore
 #include "command/backup/blockIncr.h"
 #include "command/restore/blockDelta.h"
 #include "common/crypto/cipherBlock.h"
+#include "common/crypto/xxhash.h"
 #include "common/debug.h"
 #include "common/io/limitRead.h"
 #include "common/log.h"
@@ -272,6 +273,23 @@ blockDeltaNext(BlockDelta *const this, const BlockDeltaRead *const readDelta, Io
             {
                 ASSERT(result == NULL);
 
+                // Verify the block against the checksum in the block map. Unchanged blocks were verified against the block map when
+                // the block checksum list was generated, so the reconstructed file does not need to be read back to verify it.
+                MEM_CONTEXT_TEMP_BEGIN()
+                {
+                    const Buffer *const checksum = xxHashOne(this->checksumSize, this->write.block);
+
+                    if (memcmp(bufPtrConst(checksum), this->blockData->checksum, this->checksumSize) != 0)
+                    {
+                        THROW_FMT(
+                            ChecksumError,
+                            "block at offset %" PRIu64 " actual checksum '%s' does not match expected checksum '%s'",
+                            this->blockData->offset, strZ(strNewEncode(encodingHex, checksum)),
+                            strZ(strNewEncode(encodingHex, BUF(this->blockData->checksum, this->checksumSize))));
+                    }
+                }
+                MEM_CONTEXT_TEMP_END();
+
                 this->write.offset = this->blockData->offset;
                 result = &this->write;
                 this->blockFindIdx++;
@@ -25,12 +25,42 @@ Restore File
 #include "info/manifest.h"
 #include "storage/helper.h"
 
+/***********************************************************************************************************************************
+Number of super block reads to prefetch ahead of the read being processed during block incremental restore
+***********************************************************************************************************************************/
+#define RESTORE_FILE_PREFETCH                                       4
+
+/***********************************************************************************************************************************
+Write a batch of contiguous blocks to the file at the specified offset
+***********************************************************************************************************************************/
+static void
+restoreFileWriteBatch(const int fd, const Buffer *const batch, const uint64_t offset, const String *const pgFile)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, fd);
+        FUNCTION_TEST_PARAM(BUFFER, batch);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(STRING, pgFile);
+    FUNCTION_TEST_END();
+
+    ASSERT(fd != -1);
+    ASSERT(batch != NULL);
+    ASSERT(pgFile != NULL);
+
+    THROW_ON_SYS_ERROR_FMT(
+        pwrite(fd, bufPtrConst(batch), bufUsed(batch), (off_t)offset) != (ssize_t)bufUsed(batch), FileWriteError,
+        "unable to write '%s'", strZ(pgFile));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN List *
 restoreFile(
     const String *const repoFile, const unsigned int repoIdx, const CompressType repoFileCompressType, const time_t copyTimeBegin,
-    const bool delta, const bool deltaForce, const bool bundleRaw, const String *const cipherPass,
-    const StringList *const referenceList, List *const fileList)
+    const bool delta, const bool deltaForce, const bool bundleRaw, const CipherType cipherType, const String *const cipherPass,
+    const HashType checksumType, const StringList *const referenceList, const uint64_t bundleGap, const bool blockIncrVerify,
+    const bool preallocate, List *const fileList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, repoFile);
@@ -40,12 +70,18 @@ restoreFile(
         FUNCTION_LOG_PARAM(BOOL, delta);
         FUNCTION_LOG_PARAM(BOOL, deltaForce);
         FUNCTION_LOG_PARAM(BOOL, bundleRaw);
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);
         FUNCTION_TEST_PARAM(STRING, cipherPass);
+        FUNCTION_LOG_PARAM(STRING_ID, checksumType);
         FUNCTION_LOG_PARAM(STRING_LIST, referenceList);             // List of references (for block incremental)
+        FUNCTION_LOG_PARAM(UINT64, bundleGap);                      // Largest gap to read through between bundled files
+        FUNCTION_LOG_PARAM(BOOL, blockIncrVerify);                  // Read block incremental files back to verify checksum
+        FUNCTION_LOG_PARAM(BOOL, preallocate);                      // Preallocate space instead of writing zero pages as holes
         FUNCTION_LOG_PARAM(LIST, fileList);                         // List of files to restore
     FUNCTION_LOG_END();
 
     ASSERT(repoFile != NULL);
+    ASSERT((cipherType == cipherTypeNone && cipherPass == NULL) || (cipherType != cipherTypeNone && cipherPass != NULL));
 
     // Restore file results
     List *const result = lstNewP(sizeof(RestoreFileResult));
@@ -102,7 +138,7 @@ restoreFile(
                                     IoWrite *const pgWriteTruncate = storageWriteIo(
                                         storageNewWriteP(
                                             storagePgWrite(), file->name, .noAtomic = true, .noCreatePath = true,
-                                            .noSyncPath = true, .noTruncate = true));
+                                            .noSyncPath = true, .noTruncate = true, .syncDefer = true));
                                     ioWriteOpen(pgWriteTruncate);
 
                                     // Truncate to original size
@@ -132,7 +168,7 @@ restoreFile(
 
                                     // Calculate checksum only when size matches
                                     if (info.size == file->size)
-                                        ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
+                                        ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(checksumType));
 
                                     // Generate block checksum list if block incremental
                                     if (file->blockIncrMapSize != 0)
@@ -195,7 +231,8 @@ restoreFile(
                     // Create destination file
                     StorageWrite *const pgFileWrite = storageNewWriteP(
                         storagePgWrite(), file->name, .modeFile = file->mode, .user = file->user, .group = file->group,
-                        .timeModified = file->timeModified, .noAtomic = true, .noCreatePath = true, .noSyncPath = true);
+                        .timeModified = file->timeModified, .noAtomic = true, .noCreatePath = true, .noSyncPath = true,
+                        .syncDefer = true);
 
                     ioWriteOpen(storageWriteIo(pgFileWrite));
 
@@ -218,7 +255,8 @@ restoreFile(
 
         // Copy files from repository to database
         StorageRead *repoFileRead = NULL;
-        uint64_t repoFileLimit = 0;
+        uint64_t repoFileOffset = 0;                                // Offset of the next byte to be read from the repo file
+        uint64_t repoFileEnd = 0;                                   // Offset where the current read of the repo file ends
 
         for (unsigned int fileIdx = 0; fileIdx < lstSize(fileList); fileIdx++)
         {
@@ -232,16 +270,18 @@ restoreFile(
                 if (fileResult->result == restoreResultCopy)
                 {
                     // If no repo file is currently open
-                    if (repoFileLimit == 0)
+                    if (repoFileRead == NULL)
                     {
                         // If a limit is specified then we need to use it, even if there is only one pg file to copy, because we
                         // might be reading from the middle of a repo file containing many pg files
                         if (file->limit != NULL)
                         {
                             ASSERT(varUInt64(file->limit) != 0);
-                            repoFileLimit = varUInt64(file->limit);
+                            repoFileEnd = file->offset + varUInt64(file->limit);
 
-                            // Determine how many files can be copied with one read
+                            // Determine how many files can be copied with one read. Files that are not being copied leave a gap in
+                            // the repo file. Small gaps are read and discarded since that is cheaper than starting a new read,
+                            // especially on object stores where each read is a separate request.
                             for (unsigned int fileNextIdx = fileIdx + 1; fileNextIdx < lstSize(fileList); fileNextIdx++)
                             {
                                 // Only files that are being copied are considered
@@ -249,16 +289,14 @@ restoreFile(
                                 {
                                     const RestoreFile *const fileNext = lstGet(fileList, fileNextIdx);
                                     ASSERT(fileNext->limit != NULL && varUInt64(fileNext->limit) != 0);
+                                    ASSERT(fileNext->offset >= repoFileEnd);
 
-                                    // Break if the offset is not the first file's offset + limit of all additional files so far
-                                    if (fileNext->offset != file->offset + repoFileLimit)
+                                    // Break if the gap between the files read so far and the next file is too large
+                                    if (fileNext->offset - repoFileEnd > bundleGap)
                                         break;
 
-                                    repoFileLimit += varUInt64(fileNext->limit);
+                                    repoFileEnd = fileNext->offset + varUInt64(fileNext->limit);
                                 }
-                                // Else if the file was not copied then there is a gap so break
-                                else
-                                    break;
                             }
                         }
 
@@ -269,18 +307,30 @@ restoreFile(
                             repoFileRead = storageNewReadP(
                                 storageRepoIdx(repoIdx), repoFile,
                                 .compressible = repoFileCompressType == compressTypeNone && cipherPass == NULL,
-                                .offset = file->offset, .limit = repoFileLimit != 0 ? VARUINT64(repoFileLimit) : NULL);
+                                .offset = file->offset,
+                                .limit = file->limit != NULL ? VARUINT64(repoFileEnd - file->offset) : NULL);
 
                             ioReadOpen(storageReadIo(repoFileRead));
                         }
                         MEM_CONTEXT_PRIOR_END();
                     }
+                    // Else skip the gap between the prior file and this one
+                    else if (file->offset != repoFileOffset)
+                    {
+                        ASSERT(file->offset > repoFileOffset);
+                        ioReadDrain(ioLimitReadNew(storageReadIo(repoFileRead), file->offset - repoFileOffset));
+                    }
 
-                    // Create pg file
+                    // Create pg file. When requested, space is preallocated so files written at the same time by other processes
+                    // do not end up fragmented. Otherwise, when the file is sparse, all-zero pages are not written, except for
+                    // block incremental files which are written directly through the file descriptor. The file sync is deferred
+                    // until restore syncs the filesystem of each target.
                     StorageWrite *const pgFileWrite = storageNewWriteP(
                         storagePgWrite(), file->name, .modeFile = file->mode, .user = file->user, .group = file->group,
                         .timeModified = file->timeModified, .noAtomic = true, .noCreatePath = true, .noSyncPath = true,
-                        .noTruncate = file->blockChecksum != NULL);
+                        .syncDefer = true, .noTruncate = file->blockChecksum != NULL,
+                        .sparse = file->sparse && !preallocate && file->blockIncrMapSize == 0,
+                        .preallocate = preallocate ? file->size : 0);
 
                     // If block incremental file
                     const Buffer *checksum = NULL;
@@ -297,7 +347,7 @@ restoreFile(
                         {
                             ioFilterGroupAdd(
                                 ioReadFilterGroup(blockMapRead),
-                                cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(cipherPass), .raw = true));
+                                cipherBlockNewP(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), .raw = true));
                         }
 
                         ioReadOpen(blockMapRead);
@@ -308,23 +358,46 @@ restoreFile(
                         // Open file to write
                         ioWriteOpen(storageWriteIo(pgFileWrite));
 
+                        const int pgFileFd = ioWriteFd(storageWriteIo(pgFileWrite));
+                        const String *const pgFile = storagePathP(storagePg(), file->name);
+
                         // Apply delta to file
                         BlockDelta *const blockDelta = blockDeltaNew(
                             blockMap, file->blockIncrSize, file->blockIncrChecksumSize, file->blockChecksum,
-                            cipherPass == NULL ? cipherTypeNone : cipherTypeAes256Cbc, cipherPass, repoFileCompressType);
+                            cipherType, cipherPass, repoFileCompressType);
+
+                        // Contiguous blocks are collected into a batch so they can be written with a single call. The block
+                        // returned by blockDeltaNext() is reused so it must be copied into the batch.
+                        Buffer *const writeBatch = bufNew(ioBufferSize());
+                        uint64_t writeBatchOffset = 0;
+
+                        // Super block reads are prefetched ahead of the read being processed so the latency of each request
+                        // overlaps with other reads and writes, which is especially noticeable on object stores
+                        List *const superBlockReadList = lstNewP(sizeof(StorageRead *));
 
                         for (unsigned int readIdx = 0; readIdx < blockDeltaReadSize(blockDelta); readIdx++)
                         {
+                            while (lstSize(superBlockReadList) < blockDeltaReadSize(blockDelta) &&
+                                   lstSize(superBlockReadList) <= readIdx + RESTORE_FILE_PREFETCH)
+                            {
+                                const BlockDeltaRead *const read = blockDeltaReadGet(blockDelta, lstSize(superBlockReadList));
+
+                                // Using one read for all super blocks is cheaper than reading from the file multiple times
+                                StorageRead *const superBlockRead = storageNewReadP(
+                                    storageRepoIdx(repoIdx),
+                                    backupFileRepoPathP(
+                                        strLstGet(referenceList, read->reference), .manifestName = file->manifestFile,
+                                        .bundleId = read->bundleId, .blockIncr = true),
+                                    .offset = read->offset, .limit = VARUINT64(read->size));
+
+                                storageReadPrefetch(superBlockRead);
+                                lstAdd(superBlockReadList, &superBlockRead);
+                            }
+
+                            // Open the super block list for read
                             const BlockDeltaRead *const read = blockDeltaReadGet(blockDelta, readIdx);
+                            StorageRead *const superBlockRead = *(StorageRead **)lstGet(superBlockReadList, readIdx);
 
-                            // Open the super block list for read. Using one read for all super blocks is cheaper than reading from
-                            // the file multiple times, which is especially noticeable on object stores.
-                            StorageRead *const superBlockRead = storageNewReadP(
-                                storageRepoIdx(repoIdx),
-                                backupFileRepoPathP(
-                                    strLstGet(referenceList, read->reference), .manifestName = file->manifestFile,
-                                    .bundleId = read->bundleId, .blockIncr = true),
-                                .offset = read->offset, .limit = VARUINT64(read->size));
                             ioReadOpen(storageReadIo(superBlockRead));
 
                             // Write updated blocks to the file
@@ -332,19 +405,21 @@ restoreFile(
 
                             while (deltaWrite != NULL)
                             {
-                                // Seek to the block offset. It is possible we are already at the correct position but it is easier
-                                // and safer to let lseek() figure this out.
-                                THROW_ON_SYS_ERROR_FMT(
-                                    lseek(ioWriteFd(storageWriteIo(pgFileWrite)), (off_t)deltaWrite->offset, SEEK_SET) == -1,
-                                    FileOpenError, STORAGE_ERROR_READ_SEEK, deltaWrite->offset,
-                                    strZ(storagePathP(storagePg(), file->name)));
-
-                                // Write block
-                                ioWrite(storageWriteIo(pgFileWrite), deltaWrite->block);
-                                fileResult->blockIncrDeltaSize += bufUsed(deltaWrite->block);
+                                // Write the batch when the block does not follow it or would not fit in it
+                                if (!bufEmpty(writeBatch) &&
+                                    (deltaWrite->offset != writeBatchOffset + bufUsed(writeBatch) ||
+                                     bufRemains(writeBatch) < bufUsed(deltaWrite->block)))
+                                {
+                                    restoreFileWriteBatch(pgFileFd, writeBatch, writeBatchOffset, pgFile);
+                                    bufUsedZero(writeBatch);
+                                }
+
+                                // Add block to the batch. The batch will be resized if the block is larger than the buffer size.
+                                if (bufEmpty(writeBatch))
+                                    writeBatchOffset = deltaWrite->offset;
 
-                                // Flush writes since we may seek to a new location for the next block
-                                ioWriteFlush(storageWriteIo(pgFileWrite));
+                                bufCat(writeBatch, deltaWrite->block);
+                                fileResult->blockIncrDeltaSize += bufUsed(deltaWrite->block);
 
                                 deltaWrite = blockDeltaNext(blockDelta, read, storageReadIo(superBlockRead));
                             }
@@ -352,18 +427,30 @@ restoreFile(
                             storageReadFree(superBlockRead);
                         }
 
+                        lstFree(superBlockReadList);
+
+                        // Write the last batch. The batch may be empty when all blocks in the pg file were already valid, e.g. when
+                        // only the file checksum differed.
+                        if (!bufEmpty(writeBatch))
+                            restoreFileWriteBatch(pgFileFd, writeBatch, writeBatchOffset, pgFile);
+
+                        bufFree(writeBatch);
+
                         // Close the file to complete the update
                         ioWriteClose(storageWriteIo(pgFileWrite));
 
-                        // Calculate checksum. In theory this is not needed because the file should always be reconstructed
-                        // correctly. However, it seems better to check and the pages should still be buffered making the operation
-                        // very fast.
-                        IoRead *const read = storageReadIo(storageNewReadP(storagePg(), file->name));
+                        // Calculate checksum. Every block written was verified by blockDeltaNext() and every block kept was
+                        // verified by the block checksum list, but this is the only check of the file as a whole. Reading the file
+                        // back doubles the I/O when the pages are no longer cached so it can be disabled.
+                        if (blockIncrVerify)
+                        {
+                            IoRead *const read = storageReadIo(storageNewReadP(storagePg(), file->name));
 
-                        ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(hashTypeSha1));
-                        ioReadDrain(read);
+                            ioFilterGroupAdd(ioReadFilterGroup(read), cryptoHashNew(checksumType));
+                            ioReadDrain(read);
 
-                        checksum = pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(read), CRYPTO_HASH_FILTER_TYPE));
+                            checksum = pckReadBinP(ioFilterGroupResultP(ioReadFilterGroup(read), CRYPTO_HASH_FILTER_TYPE));
+                        }
                     }
                     // Else normal file
                     else
@@ -375,15 +462,15 @@ restoreFile(
                         {
                             ioFilterGroupAdd(
                                 filterGroup,
-                                cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(cipherPass), .raw = bundleRaw));
+                                cipherBlockNewP(cipherModeDecrypt, cipherType, BUFSTR(cipherPass), .raw = bundleRaw));
                         }
 
                         // Add decompression filter
                         if (repoFileCompressType != compressTypeNone)
                             ioFilterGroupAdd(filterGroup, decompressFilterP(repoFileCompressType, .raw = bundleRaw));
 
-                        // Add sha1 filter
-                        ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
+                        // Add checksum filter
+                        ioFilterGroupAdd(filterGroup, cryptoHashNew(checksumType));
 
                         // Add size filter
                         ioFilterGroupAdd(filterGroup, ioSizeNew());
@@ -397,22 +484,24 @@ restoreFile(
                         checksum = pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE));
                     }
 
-                    // If more than one file is being copied from a single read then decrement the limit
-                    if (repoFileLimit != 0)
-                        repoFileLimit -= varUInt64(file->limit);
-
-                    // Free the repo file when there are no more files to copy from it
-                    if (repoFileLimit == 0)
-                        storageReadFree(repoFileRead);
-
                     // Validate checksum
-                    if (!bufEq(file->checksum, checksum))
+                    if (checksum != NULL && !bufEq(file->checksum, checksum))
                     {
                         THROW_FMT(
                             ChecksumError,
                             "error restoring '%s': actual checksum '%s' does not match expected checksum '%s'", strZ(file->name),
                             strZ(strNewEncode(encodingHex, checksum)), strZ(strNewEncode(encodingHex, file->checksum)));
                     }
+
+                    // Free the repo file when there are no more files to copy from it
+                    if (file->limit == NULL || file->offset + varUInt64(file->limit) == repoFileEnd)
+                    {
+                        storageReadFree(repoFileRead);
+                        repoFileRead = NULL;
+                    }
+                    // Else more files will be copied from this read
+                    else
+                        repoFileOffset = file->offset + varUInt64(file->limit);
                 }
             }
             MEM_CONTEXT_TEMP_END();
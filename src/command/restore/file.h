@@ -5,6 +5,7 @@ Restore File
 #define COMMAND_RESTORE_FILE_H
 
 #include "common/compress/helper.h"
+#include "common/crypto/common.h"
 #include "common/type/variant.h"
 
 /***********************************************************************************************************************************
@@ -29,6 +30,7 @@ typedef struct RestoreFile
     time_t timeModified;                                            // Original modification time
     mode_t mode;                                                    // Original mode
     bool zero;                                                      // Should the file be zeroed?
+    bool sparse;                                                    // Should all-zero blocks be written as holes?
     const String *user;                                             // Original user
     const String *group;                                            // Original group
     uint64_t offset;                                                // Offset into repo file where pg file is located
@@ -49,6 +51,7 @@ typedef struct RestoreFileResult
 
 FN_EXTERN List *restoreFile(
     const String *repoFile, unsigned int repoIdx, CompressType repoFileCompressType, time_t copyTimeBegin, bool delta,
-    bool deltaForce, bool bundleRaw, const String *cipherPass, const StringList *referenceList, List *fileList);
+    bool deltaForce, bool bundleRaw, CipherType cipherType, const String *cipherPass, HashType checksumType,
+    const StringList *referenceList, uint64_t bundleGap, bool blockIncrVerify, bool preallocate, List *fileList);
 
 #endif
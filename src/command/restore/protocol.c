@@ -34,8 +34,13 @@ restoreFileProtocol(PackRead *const param)
         const bool delta = pckReadBoolP(param);
         const bool deltaForce = pckReadBoolP(param);
         const bool bundleRaw = pckReadBoolP(param);
+        const CipherType cipherType = (CipherType)pckReadU64P(param);
         const String *const cipherPass = pckReadStrP(param);
+        const HashType checksumType = (HashType)pckReadStrIdP(param);
         const StringList *const referenceList = pckReadStrLstP(param);
+        const uint64_t bundleGap = pckReadU64P(param);
+        const bool blockIncrVerify = pckReadBoolP(param);
+        const bool preallocate = pckReadBoolP(param);
 
         // Build the file list
         List *const fileList = lstNewP(sizeof(RestoreFile));
@@ -48,6 +53,7 @@ restoreFileProtocol(PackRead *const param)
             file.timeModified = pckReadTimeP(param);
             file.mode = pckReadModeP(param);
             file.zero = pckReadBoolP(param);
+            file.sparse = pckReadBoolP(param);
             file.user = pckReadStrP(param);
             file.group = pckReadStrP(param);
 
@@ -73,8 +79,8 @@ restoreFileProtocol(PackRead *const param)
 
         // Restore files
         const List *const resultList = restoreFile(
-            repoFile, repoIdx, repoFileCompressType, copyTimeBegin, delta, deltaForce, bundleRaw, cipherPass, referenceList,
-            fileList);
+            repoFile, repoIdx, repoFileCompressType, copyTimeBegin, delta, deltaForce, bundleRaw, cipherType, cipherPass,
+            checksumType, referenceList, bundleGap, blockIncrVerify, preallocate, fileList);
 
         // Return result
         PackWrite *const data = protocolServerResultData(result);
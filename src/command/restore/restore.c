@@ -13,9 +13,13 @@ Restore Command
 #include "command/restore/restore.h"
 #include "command/restore/timeline.h"
 #include "common/crypto/cipherBlock.h"
+#include "common/crypto/hash.h"
 #include "common/debug.h"
+#include "common/io/bufferWrite.h"
+#include "common/io/filter/sink.h"
 #include "common/log.h"
 #include "common/regExp.h"
+#include "common/time.h"
 #include "common/user.h"
 #include "config/config.h"
 #include "config/exec.h"
@@ -754,6 +758,8 @@ typedef struct RestoreCleanCallbackData
     bool exists;                                                    // Does the target path exist?
     bool delta;                                                     // Is this a delta restore?
     StringList *fileIgnore;                                         // Files to ignore during clean
+    StringList *pathExists;                                         // Manifest paths that exist after clean
+    StringList *linkExists;                                         // Manifest links that exist after clean
     const String *rootReplaceUser;                                  // User to replace invalid users when root
     const String *rootReplaceGroup;                                 // Group to replace invalid group when root
 } RestoreCleanCallbackData;
@@ -919,6 +925,7 @@ restoreCleanBuildRecurse(StorageIterator *const storageItr, const RestoreCleanCa
                             restoreCleanOwnership(
                                 pgPath, manifestLink->user, cleanData->rootReplaceUser, manifestLink->group,
                                 cleanData->rootReplaceGroup, info.userId, info.groupId, false);
+                            strLstAdd(cleanData->linkExists, manifestName);
                         }
                     }
                     else
@@ -941,6 +948,7 @@ restoreCleanBuildRecurse(StorageIterator *const storageItr, const RestoreCleanCa
                             pgPath, manifestPath->user, cleanData->rootReplaceUser, manifestPath->group,
                             cleanData->rootReplaceGroup, info.userId, info.groupId, false);
                         restoreCleanMode(pgPath, manifestPath->mode, &info);
+                        strLstAdd(cleanData->pathExists, manifestName);
 
                         // Recurse into the path
                         RestoreCleanCallbackData cleanDataSub = *cleanData;
@@ -978,6 +986,35 @@ restoreCleanBuildRecurse(StorageIterator *const storageItr, const RestoreCleanCa
     FUNCTION_TEST_RETURN_VOID();
 }
 
+// Helper to determine if a path is in a target that was scanned (or created) during clean. If so, the path exists only if it was
+// found during clean.
+static bool
+restoreCleanBuildScanned(const StringList *const targetScanned, const String *const name)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_LIST, targetScanned);
+        FUNCTION_TEST_PARAM(STRING, name);
+    FUNCTION_TEST_END();
+
+    ASSERT(targetScanned != NULL);
+    ASSERT(name != NULL);
+
+    bool result = false;
+
+    for (unsigned int targetIdx = 0; targetIdx < strLstSize(targetScanned); targetIdx++)
+    {
+        const String *const targetName = strLstGet(targetScanned, targetIdx);
+
+        if (strBeginsWith(name, targetName) && strZ(name)[strSize(targetName)] == '/')
+        {
+            result = true;
+            break;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
 static void
 restoreCleanBuild(const Manifest *const manifest, const String *const rootReplaceUser, const String *const rootReplaceGroup)
 {
@@ -997,6 +1034,11 @@ restoreCleanBuild(const Manifest *const manifest, const String *const rootReplac
         // Allocate data for each target
         RestoreCleanCallbackData *const cleanDataList = memNew(sizeof(RestoreCleanCallbackData) * manifestTargetTotal(manifest));
 
+        // Paths and links found while cleaning so they do not need to be checked again when creating missing paths and links
+        StringList *const pathExists = strLstNew();
+        StringList *const linkExists = strLstNew();
+        StringList *const targetScanned = strLstNew();
+
         // Step 1: Check permissions and validity (is the directory empty without delta?) if the target directory exists
         // -------------------------------------------------------------------------------------------------------------------------
         StringList *const pathChecked = strLstNew();
@@ -1011,6 +1053,8 @@ restoreCleanBuild(const Manifest *const manifest, const String *const rootReplac
                 .target = manifestTarget(manifest, targetIdx),
                 .delta = delta,
                 .fileIgnore = strLstNew(),
+                .pathExists = pathExists,
+                .linkExists = linkExists,
                 .rootReplaceUser = rootReplaceUser,
                 .rootReplaceGroup = rootReplaceGroup,
             };
@@ -1157,6 +1201,9 @@ restoreCleanBuild(const Manifest *const manifest, const String *const rootReplac
                     restoreCleanMode(cleanData->targetPath, manifestPath->mode, &info);
 
                     // Clean the target
+                    strLstAdd(pathExists, cleanData->targetName);
+                    strLstAdd(targetScanned, cleanData->targetName);
+
                     restoreCleanBuildRecurse(
                         storageNewItrP(
                             storageLocalWrite(), cleanData->targetPath, .errorOnMissing = true, .sortOrder = sortOrderAsc),
@@ -1175,7 +1222,11 @@ restoreCleanBuild(const Manifest *const manifest, const String *const rootReplac
                 }
                 // Else grab the info for the path that matches the link name
                 else
+                {
                     path = manifestPathFind(manifest, cleanData->target->name);
+                    strLstAdd(pathExists, cleanData->targetName);
+                    strLstAdd(targetScanned, cleanData->targetName);
+                }
 
                 storagePathCreateP(storageLocalWrite(), cleanData->targetPath, .mode = path->mode);
                 restoreCleanOwnership(
@@ -1183,8 +1234,17 @@ restoreCleanBuild(const Manifest *const manifest, const String *const rootReplac
             }
         }
 
+        // Sort so paths and links can be found quickly. Links are always in the data directory, which is scanned or created, so a
+        // link that was not found does not exist. The same is true for paths in a target that was scanned or created, which saves
+        // checking each path individually.
+        strLstSort(pathExists, sortOrderAsc);
+        strLstSort(linkExists, sortOrderAsc);
+
         // Step 3: Create missing paths and path links
         // -------------------------------------------------------------------------------------------------------------------------
+        // Links created here are stored separately so linkExists stays sorted while it is searched
+        StringList *const linkCreated = strLstNew();
+
         for (unsigned int pathIdx = 0; pathIdx < manifestPathTotal(manifest); pathIdx++)
         {
             const ManifestPath *const path = manifestPath(manifest, pathIdx);
@@ -1204,27 +1264,31 @@ restoreCleanBuild(const Manifest *const manifest, const String *const rootReplac
 
             if (link != NULL)
             {
-                const String *const pgPath = storagePathP(storagePg(), manifestPathPg(link->name));
-                const StorageInfo linkInfo = storageInfoP(storagePg(), pgPath, .ignoreMissing = true);
-
                 // Create the link if it is missing. If it exists it should already have the correct ownership and destination.
-                if (!linkInfo.exists)
+                if (!strLstExists(linkExists, link->name))
                 {
+                    const String *const pgPath = storagePathP(storagePg(), manifestPathPg(link->name));
+
                     LOG_DETAIL_FMT("create symlink '%s' to '%s'", strZ(pgPath), strZ(link->destination));
 
                     storageLinkCreateP(storagePgWrite(), link->destination, pgPath);
                     restoreCleanOwnership(
                         pgPath, link->user, rootReplaceUser, link->group, rootReplaceGroup, userId(), groupId(), true);
+                    strLstAdd(linkCreated, link->name);
                 }
             }
             // Create the path normally
             else
             {
                 const String *const pgPath = storagePathP(storagePg(), manifestPathPg(path->name));
-                const StorageInfo pathInfo = storageInfoP(storagePg(), pgPath, .ignoreMissing = true);
+                bool exists = strLstExists(pathExists, path->name);
+
+                // Check paths that are not in a scanned target
+                if (!exists && !restoreCleanBuildScanned(targetScanned, path->name))
+                    exists = storageInfoP(storagePg(), pgPath, .ignoreMissing = true).exists;
 
                 // Create the path if it is missing. If it exists it should already have the correct ownership and mode.
-                if (!pathInfo.exists)
+                if (!exists)
                 {
                     LOG_DETAIL_FMT("create path '%s'", strZ(pgPath));
 
@@ -1238,15 +1302,21 @@ restoreCleanBuild(const Manifest *const manifest, const String *const rootReplac
 
         // Step 4: Create file links. These don't get created during path creation because they do not have a matching path entry.
         // -------------------------------------------------------------------------------------------------------------------------
+        // Add the links created above and sort again so links can be found quickly
+        for (unsigned int linkIdx = 0; linkIdx < strLstSize(linkCreated); linkIdx++)
+            strLstAdd(linkExists, strLstGet(linkCreated, linkIdx));
+
+        strLstSort(linkExists, sortOrderAsc);
+
         for (unsigned int linkIdx = 0; linkIdx < manifestLinkTotal(manifest); linkIdx++)
         {
             const ManifestLink *const link = manifestLink(manifest, linkIdx);
-            const String *const pgPath = storagePathP(storagePg(), manifestPathPg(link->name));
-            const StorageInfo linkInfo = storageInfoP(storagePg(), pgPath, .ignoreMissing = true);
 
             // Create the link if it is missing. If it exists it should already have the correct ownership and destination.
-            if (!linkInfo.exists)
+            if (!strLstExists(linkExists, link->name))
             {
+                const String *const pgPath = storagePathP(storagePg(), manifestPathPg(link->name));
+
                 LOG_DETAIL_FMT("create symlink '%s' to '%s'", strZ(pgPath), strZ(link->destination));
 
                 storageLinkCreateP(storagePgWrite(), link->destination, pgPath);
@@ -1921,11 +1991,12 @@ restoreProcessQueueComparator(const void *const item1, const void *const item2)
 }
 
 static uint64_t
-restoreProcessQueue(const Manifest *const manifest, List **const queueList)
+restoreProcessQueue(const Manifest *const manifest, List **const queueList, List **const queueSizeList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(MANIFEST, manifest);
         FUNCTION_LOG_PARAM_P(LIST, queueList);
+        FUNCTION_LOG_PARAM_P(LIST, queueSizeList);
     FUNCTION_LOG_END();
 
     FUNCTION_AUDIT_HELPER();
@@ -1936,8 +2007,9 @@ restoreProcessQueue(const Manifest *const manifest, List **const queueList)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Create list of process queues (use void * instead of List * to avoid Coverity false positive)
+        // Create list of process queues (use void * instead of List * to avoid Coverity false positive) and the size of each queue
         *queueList = lstNewP(sizeof(void *));
+        *queueSizeList = lstNewP(sizeof(uint64_t));
 
         // Generate the list of processing queues (there is always at least one)
         StringList *const targetList = strLstNew();
@@ -1958,6 +2030,7 @@ restoreProcessQueue(const Manifest *const manifest, List **const queueList)
             {
                 List *const queue = lstNewP(sizeof(ManifestFile *), .comparator = restoreProcessQueueComparator);
                 lstAdd(*queueList, &queue);
+                lstAdd(*queueSizeList, &(uint64_t){0});
             }
         }
         MEM_CONTEXT_END();
@@ -1986,7 +2059,8 @@ restoreProcessQueue(const Manifest *const manifest, List **const queueList)
             // Add file to queue
             lstAdd(*(List **)lstGet(*queueList, targetIdx), &filePack);
 
-            // Add size to total
+            // Add size to queue and total
+            *(uint64_t *)lstGet(*queueSizeList, targetIdx) += file.size;
             result += file.size;
         }
 
@@ -1998,6 +2072,7 @@ restoreProcessQueue(const Manifest *const manifest, List **const queueList)
 
         // Move process queues to prior context
         lstMove(*queueList, memContextPrior());
+        lstMove(*queueSizeList, memContextPrior());
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -2023,6 +2098,21 @@ restoreFileZeroed(const String *const manifestName, RegExp *const zeroExp)
         zeroExp == NULL ? false : regExpMatch(zeroExp, manifestName) && !strEndsWith(manifestName, STRDEF("/" PG_FILE_PGVERSION)));
 }
 
+// Helper function to determine if a file should be restored sparse. WAL is never restored sparse because PostgreSQL expects that
+// overwriting a page in an existing segment cannot fail with ENOSPC.
+static bool
+restoreFileSparse(const String *const manifestName, const String *const excludePath)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, manifestName);
+        FUNCTION_TEST_PARAM(STRING, excludePath);
+    FUNCTION_TEST_END();
+
+    ASSERT(manifestName != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, excludePath == NULL ? false : !strBeginsWith(manifestName, excludePath));
+}
+
 // Helper function to construct the absolute pg path for any file. Add a temp extension to pg_control so a partially restored
 // cluster cannot be started.
 static String *
@@ -2142,7 +2232,11 @@ restoreJobResult(
 
                 // If not zero-length add the checksum
                 if (file.size != 0 && !zeroed)
-                    strCatFmt(log, " checksum %s", strZ(strNewEncode(encodingHex, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE))));
+                {
+                    strCatFmt(
+                        log, " checksum %s",
+                        strZ(strNewEncode(encodingHex, BUF(file.checksumSha1, manifestChecksumSize(manifest)))));
+                }
 
                 LOG_DETAIL_PID(protocolParallelJobProcessId(job), strZ(log));
             }
@@ -2159,16 +2253,305 @@ restoreJobResult(
     FUNCTION_LOG_RETURN(UINT64, sizeRestored);
 }
 
+/***********************************************************************************************************************************
+Log restore progress periodically with the current throughput and an estimate of the time remaining
+***********************************************************************************************************************************/
+#define RESTORE_PROGRESS_INTERVAL_MS                                ((TimeMSec)30000)
+
+typedef struct RestoreProgress
+{
+    uint64_t sizeTotal;                                             // Total size to restore
+    TimeMSec timeBegin;                                             // When the restore of files began
+    TimeMSec timeLast;                                              // When progress was last logged (or restore of files began)
+    uint64_t sizeLast;                                              // Size restored when progress was last logged
+} RestoreProgress;
+
+static void
+restoreProgress(RestoreProgress *const progress, const uint64_t sizeRestored, const TimeMSec time)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, progress);
+        FUNCTION_TEST_PARAM(UINT64, sizeRestored);
+        FUNCTION_TEST_PARAM(TIME_MSEC, time);
+    FUNCTION_TEST_END();
+
+    ASSERT(progress != NULL);
+    ASSERT(sizeRestored <= progress->sizeTotal);
+
+    if (time - progress->timeLast >= RESTORE_PROGRESS_INTERVAL_MS && sizeRestored < progress->sizeTotal)
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            // Throughput since progress was last logged
+            String *const log = strCatFmt(
+                strNew(), "restore progress %s (%s of %s), %s/s", strZ(strNewPct(sizeRestored, progress->sizeTotal)),
+                strZ(strSizeFormat(sizeRestored)), strZ(strSizeFormat(progress->sizeTotal)),
+                strZ(strSizeFormat((sizeRestored - progress->sizeLast) * MSEC_PER_SEC / (time - progress->timeLast))));
+
+            // Estimate the time remaining from the throughput since the restore of files began
+            if (sizeRestored != 0)
+            {
+                const uint64_t remaining = (uint64_t)(
+                    (double)(progress->sizeTotal - sizeRestored) * (double)(time - progress->timeBegin) / (double)sizeRestored /
+                    MSEC_PER_SEC);
+
+                strCatFmt(
+                    log, ", estimated %" PRIu64 ":%02u:%02u remaining", remaining / 3600, (unsigned int)(remaining / 60 % 60),
+                    (unsigned int)(remaining % 60));
+            }
+
+            LOG_INFO(strZ(log));
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        progress->timeLast = time;
+        progress->sizeLast = sizeRestored;
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get the repos to restore from. The repo where the backup set was found is always first. When striping, any other repo that holds an
+identical copy of the backup set is added so restore jobs can be spread across the repos.
+***********************************************************************************************************************************/
+typedef struct RestoreJobRepo
+{
+    unsigned int repoIdx;                                           // Internal repo idx
+    CipherType cipherType;                                          // Cipher type used to encrypt files in the backup
+    const String *cipherSubPass;                                    // Passphrase used to decrypt files in the backup
+    uint64_t sizeRunning;                                           // Repo size of jobs running on the repo
+    uint64_t sizeDone;                                              // Repo size of jobs completed on the repo
+    TimeMSec timeDone;                                              // Time spent on jobs completed on the repo
+} RestoreJobRepo;
+
+// Helper to generate a checksum of everything restore needs to read the files in the backup from the repo. Copies of the backup set
+// with the same checksum can be read interchangeably.
+static Buffer *
+restoreJobRepoLayout(const Manifest *const manifest)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(MANIFEST, manifest);
+    FUNCTION_TEST_END();
+
+    ASSERT(manifest != NULL);
+
+    Buffer *result = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        IoWrite *const write = ioBufferWriteNew(bufNew(0));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), cryptoHashNew(hashTypeSha1));
+        ioFilterGroupAdd(ioWriteFilterGroup(write), ioSinkNew());
+        ioWriteOpen(write);
+
+        const ManifestData *const data = manifestData(manifest);
+
+        ioWriteStrLine(
+            write,
+            strNewFmt(
+                "%s %" PRId64 " %u %s %d", strZ(data->backupLabel), (int64_t)data->backupTimestampCopyStart,
+                (unsigned int)data->backupOptionCompressType, strZ(strIdToStr(data->backupOptionChecksumType)), data->bundleRaw));
+
+        for (unsigned int fileIdx = 0; fileIdx < manifestFileTotal(manifest); fileIdx++)
+        {
+            const ManifestFile file = manifestFile(manifest, fileIdx);
+            String *const line = strCatFmt(
+                strNew(), "%s %s %" PRIu64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %zu %zu", strZ(file.name),
+                strZNull(file.reference), file.bundleId, file.bundleOffset, file.sizeRepo, file.blockIncrMapSize,
+                file.blockIncrSize, file.blockIncrChecksumSize);
+
+            ioWriteStr(write, line);
+            ioWrite(write, BUF(file.checksumSha1, manifestChecksumSize(manifest)));
+
+            strFree(line);
+        }
+
+        ioWriteClose(write);
+
+        const Buffer *const checksum = pckReadBinP(ioFilterGroupResultP(ioWriteFilterGroup(write), CRYPTO_HASH_FILTER_TYPE));
+
+        MEM_CONTEXT_PRIOR_BEGIN()
+        {
+            result = bufDup(checksum);
+        }
+        MEM_CONTEXT_PRIOR_END();
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(BUFFER, result);
+}
+
+static List *
+restoreJobRepoList(const RestoreBackupData *const backupData, const Manifest *const manifest)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM_P(VOID, backupData);
+        FUNCTION_LOG_PARAM(MANIFEST, manifest);
+    FUNCTION_LOG_END();
+
+    ASSERT(backupData != NULL);
+    ASSERT(manifest != NULL);
+
+    List *const result = lstNewP(sizeof(RestoreJobRepo));
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        lstAdd(
+            result,
+            &(RestoreJobRepo){
+                .repoIdx = backupData->repoIdx, .cipherType = backupData->repoCipherType,
+                .cipherSubPass = manifestCipherSubPass(manifest)});
+
+        if (cfgOptionBool(cfgOptStripe))
+        {
+            const Buffer *const layout = restoreJobRepoLayout(manifest);
+            String *const repoNameList = strCatZ(strNew(), cfgOptionGroupName(cfgOptGrpRepo, backupData->repoIdx));
+
+            for (unsigned int repoIdx = 0; repoIdx < cfgOptionGroupIdxTotal(cfgOptGrpRepo); repoIdx++)
+            {
+                // Skip the repo where the backup set was found
+                if (repoIdx == backupData->repoIdx)
+                    continue;
+
+                const CipherType cipherType = cfgOptionIdxStrId(cfgOptRepoCipherType, repoIdx);
+                const Manifest *manifestRepo = NULL;
+
+                // Attempt to load the manifest for the backup set. Repos that cannot be read or that do not have the backup set
+                // are not used.
+                TRY_BEGIN()
+                {
+                    const InfoBackup *const infoBackup = infoBackupLoadFile(
+                        storageRepoIdx(repoIdx), INFO_BACKUP_PATH_FILE_STR, cipherType,
+                        cfgOptionIdxStrNull(cfgOptRepoCipherPass, repoIdx));
+
+                    if (infoBackupLabelExists(infoBackup, backupData->backupSet))
+                    {
+                        manifestRepo = manifestLoadFile(
+                            storageRepoIdx(repoIdx),
+                            strNewFmt(STORAGE_REPO_BACKUP "/%s/" BACKUP_MANIFEST_FILE, strZ(backupData->backupSet)), cipherType,
+                            infoPgCipherPass(infoBackupPg(infoBackup)));
+                    }
+                }
+                CATCH_ANY()
+                {
+                    LOG_WARN_FMT(
+                        "%s: [%s] %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx), errorTypeName(errorType()), errorMessage());
+                }
+                TRY_END();
+
+                if (manifestRepo != NULL)
+                {
+                    // Add the repo if the backup set is an identical copy
+                    if (bufEq(layout, restoreJobRepoLayout(manifestRepo)))
+                    {
+                        MEM_CONTEXT_OBJ_BEGIN(result)
+                        {
+                            lstAdd(
+                                result,
+                                &(RestoreJobRepo){
+                                    .repoIdx = repoIdx, .cipherType = cipherType,
+                                    .cipherSubPass = strDup(manifestCipherSubPass(manifestRepo))});
+                        }
+                        MEM_CONTEXT_OBJ_END();
+
+                        strCatFmt(repoNameList, ", %s", cfgOptionGroupName(cfgOptGrpRepo, repoIdx));
+                    }
+                    else
+                    {
+                        LOG_WARN_FMT(
+                            "%s: backup set %s does not match %s and will not be used for restore",
+                            cfgOptionGroupName(cfgOptGrpRepo, repoIdx), strZ(backupData->backupSet),
+                            cfgOptionGroupName(cfgOptGrpRepo, backupData->repoIdx));
+                    }
+                }
+            }
+
+            LOG_INFO_FMT("stripe restore across %s", strZ(repoNameList));
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN(LIST, result);
+}
+
+/***********************************************************************************************************************************
+Select the repo for a new job. The repo expected to finish the job first is selected based on the size of the jobs already running
+on each repo and the throughput measured from completed jobs. Repos that have not completed any jobs yet are assumed to have the
+average throughput. When the estimates are equal, e.g. before any throughput has been measured, the repo with the least running is
+selected so jobs are spread across the repos.
+***********************************************************************************************************************************/
+static unsigned int
+restoreJobRepoSelect(const List *const repoList, const uint64_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(LIST, repoList);
+        FUNCTION_TEST_PARAM(UINT64, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(repoList != NULL);
+    ASSERT(!lstEmpty(repoList));
+
+    // Calculate average time per byte for all completed jobs
+    uint64_t sizeDone = 0;
+    TimeMSec timeDone = 0;
+
+    for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+    {
+        const RestoreJobRepo *const repo = lstGet(repoList, repoListIdx);
+
+        sizeDone += repo->sizeDone;
+        timeDone += repo->timeDone;
+    }
+
+    const double timePerByteAvg = sizeDone == 0 ? 0 : (double)timeDone / (double)sizeDone;
+
+    // Find the repo expected to finish the job first
+    unsigned int result = 0;
+    double timeMin = 0;
+    uint64_t sizeRunningMin = 0;
+
+    for (unsigned int repoListIdx = 0; repoListIdx < lstSize(repoList); repoListIdx++)
+    {
+        const RestoreJobRepo *const repo = lstGet(repoList, repoListIdx);
+        const double timePerByte = repo->sizeDone == 0 ? timePerByteAvg : (double)repo->timeDone / (double)repo->sizeDone;
+        const double time = (double)(repo->sizeRunning + size) * timePerByte;
+
+        if (repoListIdx == 0 || time < timeMin || (time == timeMin && repo->sizeRunning < sizeRunningMin))
+        {
+            result = repoListIdx;
+            timeMin = time;
+            sizeRunningMin = repo->sizeRunning;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(UINT, result);
+}
+
 /***********************************************************************************************************************************
 Return new restore jobs as requested
 ***********************************************************************************************************************************/
+typedef struct RestoreJob
+{
+    ProtocolParallelJob *job;                                       // Job running on the client
+    List *fileList;                                                 // Files to restore in the job
+    uint64_t size;                                                  // Repo size of the files to restore
+    unsigned int repoListIdx;                                       // Repo the job reads from
+    unsigned int repoListFirstIdx;                                  // Repo the job was first run on
+    TimeMSec timeBegin;                                             // When the job started running
+} RestoreJob;
+
 typedef struct RestoreJobData
 {
-    unsigned int repoIdx;                                           // Internal repo idx
+    List *repoList;                                                 // Repos to restore from
     Manifest *manifest;                                             // Backup manifest
     List *queueList;                                                // List of processing queues
+    List *queueSizeList;                                            // Size remaining in each processing queue
+    List *clientList;                                               // Job running on each client
+    List *retryList;                                                // Jobs to be retried on another repo
+    List *retryJobList;                                             // Errored jobs that have been queued for retry
     RegExp *zeroExp;                                                // Identify files that should be sparse zeroed
-    const String *cipherSubPass;                                    // Passphrase used to decrypt files in the backup
+    const String *sparseExcludePath;                                // Path excluded from sparse restore (NULL when sparse is off)
     const String *rootReplaceUser;                                  // User to replace invalid users when root
     const String *rootReplaceGroup;                                 // Group to replace invalid group when root
 } RestoreJobData;
@@ -2195,6 +2578,227 @@ restoreJobQueueNext(const unsigned int clientIdx, int queueIdx, const unsigned i
     FUNCTION_TEST_RETURN(INT, queueIdx);
 }
 
+// Helper to select the queue to get the next job from. A client uses its own queue while it has files so clients stay spread across
+// targets. After that the client helps the queue with the most left to restore since that queue will determine when the restore
+// completes. Returns -1 when all the queues are empty.
+static int
+restoreJobQueueSelect(const RestoreJobData *const jobData, const unsigned int clientIdx)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM(UINT, clientIdx);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+
+    // Determine where to begin scanning the queues (we'll stop when we get back here)
+    const unsigned int queueTotal = lstSize(jobData->queueList);
+    int queueIdx = (int)(clientIdx % queueTotal);
+    const int queueEnd = queueIdx;
+    int result = -1;
+    uint64_t resultSize = 0;
+
+    do
+    {
+        if (!lstEmpty(*(List **)lstGet(jobData->queueList, (unsigned int)queueIdx)))
+        {
+            // The client's own queue is always selected when it has files
+            if (queueIdx == queueEnd)
+            {
+                result = queueIdx;
+                break;
+            }
+
+            const uint64_t size = *(uint64_t *)lstGet(jobData->queueSizeList, (unsigned int)queueIdx);
+
+            if (result == -1 || size > resultSize)
+            {
+                result = queueIdx;
+                resultSize = size;
+            }
+        }
+
+        queueIdx = restoreJobQueueNext(clientIdx, queueIdx, queueTotal);
+    }
+    while (queueIdx != queueEnd);
+
+    FUNCTION_TEST_RETURN(INT, result);
+}
+
+// Helper to account for the job that last ran on a client. If the job errored and there is another repo to try then the job is
+// queued to be retried on the next repo.
+static void
+restoreJobComplete(RestoreJobData *const jobData, RestoreJob *const client)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, client);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(client != NULL);
+    ASSERT(client->job != NULL);
+
+    RestoreJobRepo *const repo = lstGet(jobData->repoList, client->repoListIdx);
+    repo->sizeRunning -= client->size;
+
+    // If the job was successful then update the throughput for the repo
+    if (protocolParallelJobErrorCode(client->job) == 0)
+    {
+        repo->sizeDone += client->size;
+        repo->timeDone += timeMSec() - client->timeBegin;
+        lstFree(client->fileList);
+    }
+    // Else queue the job for retry if there are repos left to try
+    else
+    {
+        const unsigned int repoListIdx = (client->repoListIdx + 1) % lstSize(jobData->repoList);
+
+        if (repoListIdx != client->repoListFirstIdx)
+        {
+            LOG_WARN_FMT(
+                "%s: [%s] %s\nHINT: retrying on %s.", cfgOptionGroupName(cfgOptGrpRepo, repo->repoIdx),
+                errorTypeName(errorTypeFromCode(protocolParallelJobErrorCode(client->job))),
+                strZ(protocolParallelJobErrorMessage(client->job)),
+                cfgOptionGroupName(cfgOptGrpRepo, ((const RestoreJobRepo *)lstGet(jobData->repoList, repoListIdx))->repoIdx));
+
+            lstAdd(jobData->retryJobList, &client->job);
+            lstAdd(
+                jobData->retryList,
+                &(RestoreJob){
+                    .fileList = client->fileList, .size = client->size, .repoListIdx = repoListIdx,
+                    .repoListFirstIdx = client->repoListFirstIdx});
+        }
+        // Else the error will be thrown when the job result is processed
+        else
+            lstFree(client->fileList);
+    }
+
+    *client = (RestoreJob){0};
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+// Helper to determine if a job errored but has been queued for retry, in which case the error should be ignored
+static bool
+restoreJobRetried(RestoreJobData *const jobData, const ProtocolParallelJob *const job)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM(PROTOCOL_PARALLEL_JOB, job);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(job != NULL);
+
+    bool result = false;
+
+    for (unsigned int retryJobIdx = 0; retryJobIdx < lstSize(jobData->retryJobList); retryJobIdx++)
+    {
+        if (*(const ProtocolParallelJob **)lstGet(jobData->retryJobList, retryJobIdx) == job)
+        {
+            lstRemoveIdx(jobData->retryJobList, retryJobIdx);
+            result = true;
+            break;
+        }
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+// Helper to build the parameters for a job
+static PackWrite *
+restoreJobParam(const RestoreJobData *const jobData, const RestoreJob *const job)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, jobData);
+        FUNCTION_TEST_PARAM_P(VOID, job);
+    FUNCTION_TEST_END();
+
+    ASSERT(jobData != NULL);
+    ASSERT(job != NULL);
+    ASSERT(!lstEmpty(job->fileList));
+
+    PackWrite *const result = protocolPackNew();
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        const RestoreJobRepo *const repo = lstGet(jobData->repoList, job->repoListIdx);
+
+        for (unsigned int fileIdx = 0; fileIdx < lstSize(job->fileList); fileIdx++)
+        {
+            const ManifestFile file = manifestFileUnpack(jobData->manifest, *(ManifestFilePack **)lstGet(job->fileList, fileIdx));
+
+            // Add common parameters before first file
+            if (fileIdx == 0)
+            {
+                pckWriteStrP(
+                    result,
+                    backupFileRepoPathP(
+                        file.reference != NULL ? file.reference : manifestData(jobData->manifest)->backupLabel,
+                        .manifestName = file.name, .bundleId = file.bundleId,
+                        .compressType = manifestData(jobData->manifest)->backupOptionCompressType,
+                        .blockIncr = file.blockIncrMapSize != 0));
+                pckWriteU32P(result, repo->repoIdx);
+                pckWriteU32P(result, manifestData(jobData->manifest)->backupOptionCompressType);
+                pckWriteTimeP(result, manifestData(jobData->manifest)->backupTimestampCopyStart);
+                pckWriteBoolP(result, cfgOptionBool(cfgOptDelta));
+                pckWriteBoolP(result, cfgOptionBool(cfgOptDelta) && cfgOptionBool(cfgOptForce));
+                pckWriteBoolP(result, file.bundleId != 0 && manifestData(jobData->manifest)->bundleRaw);
+                pckWriteU64P(result, repo->cipherSubPass == NULL ? cipherTypeNone : repo->cipherType);
+                pckWriteStrP(result, repo->cipherSubPass);
+                pckWriteStrIdP(result, manifestData(jobData->manifest)->backupOptionChecksumType);
+                pckWriteStrLstP(result, manifestReferenceList(jobData->manifest));
+                pckWriteU64P(result, cfgOptionUInt64(cfgOptBundleGap));
+                pckWriteBoolP(result, cfgOptionBool(cfgOptBlockIncrVerify));
+                pckWriteBoolP(result, cfgOptionBool(cfgOptPreallocate));
+            }
+
+            pckWriteStrP(result, restoreFilePgPath(jobData->manifest, file.name));
+            pckWriteBinP(result, BUF(file.checksumSha1, manifestChecksumSize(jobData->manifest)));
+            pckWriteU64P(result, file.size);
+            pckWriteTimeP(result, file.timestamp);
+            pckWriteModeP(result, file.mode);
+            pckWriteBoolP(result, restoreFileZeroed(file.name, jobData->zeroExp));
+            pckWriteBoolP(result, restoreFileSparse(file.name, jobData->sparseExcludePath));
+            pckWriteStrP(result, restoreManifestOwnerReplace(file.user, jobData->rootReplaceUser));
+            pckWriteStrP(result, restoreManifestOwnerReplace(file.group, jobData->rootReplaceGroup));
+
+            // If block incremental then modify offset and size to where the map is stored since we need to read that first.
+            if (file.blockIncrMapSize != 0)
+            {
+                pckWriteBoolP(result, true);
+                pckWriteU64P(result, file.bundleOffset + file.sizeRepo - file.blockIncrMapSize);
+                pckWriteU64P(result, file.blockIncrMapSize);
+            }
+            // Else write bundle offset/size
+            else if (file.bundleId != 0)
+            {
+                pckWriteBoolP(result, true);
+                pckWriteU64P(result, file.bundleOffset);
+                pckWriteU64P(result, file.sizeRepo);
+            }
+            // Else restore as a whole file
+            else
+                pckWriteBoolP(result, false);
+
+            // Block incremental
+            pckWriteU64P(result, file.blockIncrMapSize);
+
+            if (file.blockIncrMapSize != 0)
+            {
+                pckWriteU64P(result, file.blockIncrSize);
+                pckWriteU64P(result, file.blockIncrChecksumSize);
+            }
+
+            pckWriteStrP(result, file.name);
+        }
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(PACK_WRITE, result);
+}
+
 // Callback to fetch restore jobs for the parallel executor
 static ProtocolParallelJob *
 restoreJobCallback(void *const data, const unsigned int clientIdx)
@@ -2210,125 +2814,93 @@ restoreJobCallback(void *const data, const unsigned int clientIdx)
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
-        // Get a new job if there are any left
         RestoreJobData *const jobData = data;
+        RestoreJob *const client = lstGet(jobData->clientList, clientIdx);
 
-        // Determine where to begin scanning the queue (we'll stop when we get back here)
-        PackWrite *param = NULL;
-        int queueIdx = (int)(clientIdx % lstSize(jobData->queueList));
-        const int queueEnd = queueIdx;
+        // Account for the job that just completed on this client
+        if (client->job != NULL)
+            restoreJobComplete(jobData, client);
 
-        // Create restore job
-        do
+        // Retry errored jobs first
+        RestoreJob job = {0};
+
+        if (!lstEmpty(jobData->retryList))
         {
-            List *const queue = *(List **)lstGet(jobData->queueList, (unsigned int)queueIdx);
-            bool fileAdded = false;
-            const String *fileName = NULL;
-            uint64_t bundleId = 0;
-            const String *reference = NULL;
+            job = *(RestoreJob *)lstGet(jobData->retryList, 0);
+            lstRemoveIdx(jobData->retryList, 0);
+        }
+        // Else get a new job if there are any left
+        else
+        {
+            const int queueIdx = restoreJobQueueSelect(jobData, clientIdx);
 
-            while (!lstEmpty(queue))
+            if (queueIdx != -1)
             {
-                const ManifestFile file = manifestFileUnpack(jobData->manifest, *(ManifestFilePack **)lstGet(queue, 0));
+                List *const queue = *(List **)lstGet(jobData->queueList, (unsigned int)queueIdx);
+                uint64_t *const queueSize = lstGet(jobData->queueSizeList, (unsigned int)queueIdx);
+                uint64_t bundleId = 0;
+                const String *reference = NULL;
 
-                // Break if bundled files have already been added and 1) the bundleId has changed or 2) the reference has changed
-                if (fileAdded && (bundleId != file.bundleId || !strEq(reference, file.reference)))
-                    break;
-
-                // Add common parameters before first file
-                if (param == NULL)
+                while (!lstEmpty(queue))
                 {
-                    param = protocolPackNew();
+                    ManifestFilePack *const filePack = *(ManifestFilePack **)lstGet(queue, 0);
+                    const ManifestFile file = manifestFileUnpack(jobData->manifest, filePack);
+
+                    // Break if bundled files have already been added and 1) the bundleId has changed or 2) the reference has
+                    // changed
+                    if (job.fileList != NULL && (bundleId != file.bundleId || !strEq(reference, file.reference)))
+                        break;
 
-                    if (file.bundleId != 0)
+                    // Create the file list before the first file
+                    if (job.fileList == NULL)
                     {
+                        MEM_CONTEXT_OBJ_BEGIN(jobData->clientList)
+                        {
+                            job.fileList = lstNewP(sizeof(ManifestFilePack *));
+                        }
+                        MEM_CONTEXT_OBJ_END();
+
                         bundleId = file.bundleId;
                         reference = file.reference;
                     }
-                    else
-                        fileName = file.name;
-
-                    pckWriteStrP(
-                        param,
-                        backupFileRepoPathP(
-                            file.reference != NULL ? file.reference : manifestData(jobData->manifest)->backupLabel,
-                            .manifestName = file.name, .bundleId = file.bundleId,
-                            .compressType = manifestData(jobData->manifest)->backupOptionCompressType,
-                            .blockIncr = file.blockIncrMapSize != 0));
-                    pckWriteU32P(param, jobData->repoIdx);
-                    pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
-                    pckWriteTimeP(param, manifestData(jobData->manifest)->backupTimestampCopyStart);
-                    pckWriteBoolP(param, cfgOptionBool(cfgOptDelta));
-                    pckWriteBoolP(param, cfgOptionBool(cfgOptDelta) && cfgOptionBool(cfgOptForce));
-                    pckWriteBoolP(param, file.bundleId != 0 && manifestData(jobData->manifest)->bundleRaw);
-                    pckWriteStrP(param, jobData->cipherSubPass);
-                    pckWriteStrLstP(param, manifestReferenceList(jobData->manifest));
-
-                    fileAdded = true;
-                }
 
-                pckWriteStrP(param, restoreFilePgPath(jobData->manifest, file.name));
-                pckWriteBinP(param, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE));
-                pckWriteU64P(param, file.size);
-                pckWriteTimeP(param, file.timestamp);
-                pckWriteModeP(param, file.mode);
-                pckWriteBoolP(param, restoreFileZeroed(file.name, jobData->zeroExp));
-                pckWriteStrP(param, restoreManifestOwnerReplace(file.user, jobData->rootReplaceUser));
-                pckWriteStrP(param, restoreManifestOwnerReplace(file.group, jobData->rootReplaceGroup));
-
-                // If block incremental then modify offset and size to where the map is stored since we need to read that first.
-                if (file.blockIncrMapSize != 0)
-                {
-                    pckWriteBoolP(param, true);
-                    pckWriteU64P(param, file.bundleOffset + file.sizeRepo - file.blockIncrMapSize);
-                    pckWriteU64P(param, file.blockIncrMapSize);
-                }
-                // Else write bundle offset/size
-                else if (file.bundleId != 0)
-                {
-                    pckWriteBoolP(param, true);
-                    pckWriteU64P(param, file.bundleOffset);
-                    pckWriteU64P(param, file.sizeRepo);
-                }
-                // Else restore as a whole file
-                else
-                    pckWriteBoolP(param, false);
+                    lstAdd(job.fileList, &filePack);
+                    job.size += file.sizeRepo;
 
-                // Block incremental
-                pckWriteU64P(param, file.blockIncrMapSize);
+                    // Remove job from the queue and its size from the queue size
+                    lstRemoveIdx(queue, 0);
+                    *queueSize -= file.size;
 
-                if (file.blockIncrMapSize != 0)
-                {
-                    pckWriteU64P(param, file.blockIncrSize);
-                    pckWriteU64P(param, file.blockIncrChecksumSize);
+                    // Break if the file is not bundled
+                    if (bundleId == 0)
+                        break;
                 }
 
-                pckWriteStrP(param, file.name);
-
-                // Remove job from the queue
-                lstRemoveIdx(queue, 0);
-
-                // Break if the file is not bundled
-                if (bundleId == 0)
-                    break;
+                job.repoListIdx = restoreJobRepoSelect(jobData->repoList, job.size);
+                job.repoListFirstIdx = job.repoListIdx;
             }
+        }
 
-            if (fileAdded)
-            {
-                // Assign job to result
-                MEM_CONTEXT_PRIOR_BEGIN()
-                {
-                    result = protocolParallelJobNew(
-                        bundleId != 0 ? VARUINT64(bundleId) : VARSTR(fileName), PROTOCOL_COMMAND_RESTORE_FILE, param);
-                }
-                MEM_CONTEXT_PRIOR_END();
+        if (job.fileList != NULL)
+        {
+            // Assign job to result
+            const ManifestFile file = manifestFileUnpack(jobData->manifest, *(ManifestFilePack **)lstGet(job.fileList, 0));
+            PackWrite *const param = restoreJobParam(jobData, &job);
 
-                break;
+            MEM_CONTEXT_PRIOR_BEGIN()
+            {
+                result = protocolParallelJobNew(
+                    file.bundleId != 0 ? VARUINT64(file.bundleId) : VARSTR(file.name), PROTOCOL_COMMAND_RESTORE_FILE, param);
             }
+            MEM_CONTEXT_PRIOR_END();
 
-            queueIdx = restoreJobQueueNext(clientIdx, queueIdx, lstSize(jobData->queueList));
+            // Track the job so the repo throughput can be measured and the job retried on error
+            job.job = result;
+            job.timeBegin = timeMSec();
+            ((RestoreJobRepo *)lstGet(jobData->repoList, job.repoListIdx))->sizeRunning += job.size;
+
+            *client = job;
         }
-        while (queueIdx != queueEnd);
     }
     MEM_CONTEXT_TEMP_END();
 
@@ -2361,7 +2933,7 @@ cmdRestore(void)
         const RestoreBackupData backupData = restoreBackupSet();
 
         // Load manifest
-        RestoreJobData jobData = {.repoIdx = backupData.repoIdx};
+        RestoreJobData jobData = {0};
 
         jobData.manifest = manifestLoadFile(
             storageRepoIdx(backupData.repoIdx),
@@ -2385,6 +2957,9 @@ cmdRestore(void)
                 cfgOptionIdxStrId(cfgOptRepoCipherType, backupData.repoIdx), infoArchiveCipherPass(archiveInfo));
         }
 
+        // Get the repos to restore from
+        jobData.repoList = restoreJobRepoList(&backupData, jobData.manifest);
+
         // Remotes (if any) are no longer needed since the rest of the repository reads will be done by the local processes
         protocolFree();
 
@@ -2398,9 +2973,6 @@ cmdRestore(void)
         // Validate manifest. Don't use strict mode because we'd rather ignore problems that won't affect a restore.
         manifestValidate(jobData.manifest, false);
 
-        // Get the cipher subpass used to decrypt files in the backup
-        jobData.cipherSubPass = manifestCipherSubPass(jobData.manifest);
-
         // Validate the manifest
         restoreManifestValidate(jobData.manifest, backupData.backupSet);
 
@@ -2430,11 +3002,18 @@ cmdRestore(void)
         const String *const expression = restoreSelectiveExpression(jobData.manifest);
         jobData.zeroExp = expression == NULL ? NULL : regExpNew(expression);
 
+        // Files to restore sparse, excluding WAL
+        if (cfgOptionBool(cfgOptSparse))
+        {
+            jobData.sparseExcludePath = strNewFmt(
+                MANIFEST_TARGET_PGDATA "/%s/", strZ(pgWalPath(manifestData(jobData.manifest)->pgVersion)));
+        }
+
         // Clean the data directory and build path/link structure
         restoreCleanBuild(jobData.manifest, jobData.rootReplaceUser, jobData.rootReplaceGroup);
 
         // Generate processing queues
-        const uint64_t sizeTotal = restoreProcessQueue(jobData.manifest, &jobData.queueList);
+        const uint64_t sizeTotal = restoreProcessQueue(jobData.manifest, &jobData.queueList, &jobData.queueSizeList);
 
         // Save manifest to the data directory so we can restart a delta restore even if the PG_VERSION file is missing
         manifestSave(jobData.manifest, storageWriteIo(storageNewWriteP(storagePgWrite(), BACKUP_MANIFEST_FILE_STR)));
@@ -2446,8 +3025,18 @@ cmdRestore(void)
         for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
             protocolParallelClientAdd(parallelExec, protocolLocalGet(protocolStorageTypeRepo, 0, processIdx));
 
+        // Track jobs running on each client so they can be retried on another repo
+        jobData.clientList = lstNewP(sizeof(RestoreJob));
+        jobData.retryList = lstNewP(sizeof(RestoreJob));
+        jobData.retryJobList = lstNewP(sizeof(ProtocolParallelJob *));
+
+        for (unsigned int processIdx = 1; processIdx <= cfgOptionUInt(cfgOptProcessMax); processIdx++)
+            lstAdd(jobData.clientList, &(RestoreJob){0});
+
         // Process jobs
         uint64_t sizeRestored = 0;
+        const TimeMSec timeBegin = timeMSec();
+        RestoreProgress progress = {.sizeTotal = sizeTotal, .timeBegin = timeBegin, .timeLast = timeBegin};
 
         MEM_CONTEXT_TEMP_RESET_BEGIN()
         {
@@ -2457,10 +3046,17 @@ cmdRestore(void)
 
                 for (unsigned int jobIdx = 0; jobIdx < completed; jobIdx++)
                 {
-                    sizeRestored = restoreJobResult(
-                        jobData.manifest, protocolParallelResult(parallelExec), jobData.zeroExp, sizeTotal, sizeRestored);
+                    ProtocolParallelJob *const job = protocolParallelResult(parallelExec);
+
+                    // Ignore the error when the job will be retried on another repo
+                    if (restoreJobRetried(&jobData, job))
+                        protocolParallelJobFree(job);
+                    else
+                        sizeRestored = restoreJobResult(jobData.manifest, job, jobData.zeroExp, sizeTotal, sizeRestored);
                 }
 
+                restoreProgress(&progress, sizeRestored, timeMSec());
+
                 // Reset the memory context occasionally so we don't use too much memory or slow down processing
                 MEM_CONTEXT_TEMP_RESET(1000);
             }
@@ -2479,6 +3075,23 @@ cmdRestore(void)
         // Remove backup.manifest
         storageRemoveP(storagePgWrite(), BACKUP_MANIFEST_FILE_STR);
 
+        // Sync the filesystem of each target. Restored files only started writeback when they were closed, so this makes them
+        // durable with one sync per target rather than one per file. The path syncs that follow have little left to write.
+        StringList *const fsSynced = strLstNew();
+
+        for (unsigned int targetIdx = 0; targetIdx < manifestTargetTotal(jobData.manifest); targetIdx++)
+        {
+            const String *const pgPath = manifestTargetPath(jobData.manifest, manifestTarget(jobData.manifest, targetIdx));
+
+            if (!strLstExists(fsSynced, pgPath))
+            {
+                LOG_DETAIL_FMT("sync filesystem '%s'", strZ(pgPath));
+                storagePathSyncP(storageLocalWrite(), pgPath, .fs = true);
+
+                strLstAdd(fsSynced, pgPath);
+            }
+        }
+
         // Sync file link paths. These need to be synced separately because they are not linked from the data directory.
         StringList *const pathSynced = strLstNew();
 
@@ -18,21 +18,25 @@ Verify File
 FN_EXTERN VerifyResult
 verifyFile(
     const String *const filePathName, const uint64_t offset, const Variant *const limit, const CompressType compressType,
-    const Buffer *const fileChecksum, const uint64_t fileSize, const String *const cipherPass)
+    const HashType checksumType, const Buffer *const fileChecksum, const uint64_t fileSize, const CipherType cipherType,
+    const String *const cipherPass)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STRING, filePathName);                   // Fully qualified file name
         FUNCTION_LOG_PARAM(UINT64, offset);                         // Offset to read in file
         FUNCTION_LOG_PARAM(VARIANT, limit);                         // Limit to read from file
         FUNCTION_LOG_PARAM(ENUM, compressType);                     // Compression type
+        FUNCTION_LOG_PARAM(STRING_ID, checksumType);                // Checksum type
         FUNCTION_LOG_PARAM(BUFFER, fileChecksum);                   // Checksum for the file
         FUNCTION_LOG_PARAM(UINT64, fileSize);                       // Size of file
+        FUNCTION_LOG_PARAM(STRING_ID, cipherType);                  // Cipher type used to encrypt the repo file
         FUNCTION_TEST_PARAM(STRING, cipherPass);                    // Password to access the repo file if encrypted
     FUNCTION_LOG_END();
 
     ASSERT(filePathName != NULL);
     ASSERT(fileChecksum != NULL);
     ASSERT(limit == NULL || varType(limit) == varTypeUInt64);
+    ASSERT((cipherType == cipherTypeNone && cipherPass == NULL) || (cipherType != cipherTypeNone && cipherPass != NULL));
 
     // Is the file valid?
     VerifyResult result = verifyOk;
@@ -46,14 +50,14 @@ verifyFile(
 
         // Add decryption filter
         if (cipherPass != NULL)
-            ioFilterGroupAdd(filterGroup, cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Cbc, BUFSTR(cipherPass)));
+            ioFilterGroupAdd(filterGroup, cipherBlockNewP(cipherModeDecrypt, cipherType, BUFSTR(cipherPass)));
 
         // Add decompression filter
         if (compressType != compressTypeNone)
             ioFilterGroupAdd(filterGroup, decompressFilterP(compressType));
 
         // Add sha1 filter
-        ioFilterGroupAdd(filterGroup, cryptoHashNew(hashTypeSha1));
+        ioFilterGroupAdd(filterGroup, cryptoHashNew(checksumType));
 
         // Add size filter
         ioFilterGroupAdd(filterGroup, ioSizeNew());
@@ -61,20 +65,37 @@ verifyFile(
         // Add IoSink so the file data is not transmitted from the remote
         ioFilterGroupAdd(filterGroup, ioSinkNew());
 
-        // If the file exists check the checksum/size
-        if (ioReadDrain(read))
+        // Authenticated encryption fails on decrypt if the file has been modified or truncated, which is reported as a checksum
+        // mismatch. The checksum and size are still checked since authentication does not show that this is the expected file.
+        volatile bool exists = false;
+
+        if (cipherType == cipherTypeAes256Gcm)
         {
-            // Validate checksum
-            if (!bufEq(fileChecksum, pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE))))
+            TRY_BEGIN()
+            {
+                exists = ioReadDrain(read);
+            }
+            CATCH(CryptoError)
             {
                 result = verifyChecksumMismatch;
             }
+            TRY_END();
+        }
+        else
+            exists = ioReadDrain(read);
+
+        // If the file was decrypted then check that it exists and the checksum/size match
+        if (result == verifyOk)
+        {
+            if (!exists)
+                result = verifyFileMissing;
+            // Validate checksum
+            else if (!bufEq(fileChecksum, pckReadBinP(ioFilterGroupResultP(filterGroup, CRYPTO_HASH_FILTER_TYPE))))
+                result = verifyChecksumMismatch;
             // If the size can be checked, do so
             else if (fileSize != pckReadU64P(ioFilterGroupResultP(ioReadFilterGroup(read), SIZE_FILTER_TYPE)))
                 result = verifySizeInvalid;
         }
-        else
-            result = verifyFileMissing;
     }
     MEM_CONTEXT_TEMP_END();
 
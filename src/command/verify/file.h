@@ -24,7 +24,7 @@ Functions
 ***********************************************************************************************************************************/
 // Verify a file in the pgBackRest repository
 FN_EXTERN VerifyResult verifyFile(
-    const String *filePathName, uint64_t offset, const Variant *limit, CompressType compressType, const Buffer *fileChecksum,
-    uint64_t fileSize, const String *cipherPass);
+    const String *filePathName, uint64_t offset, const Variant *limit, CompressType compressType, HashType checksumType,
+    const Buffer *fileChecksum, uint64_t fileSize, CipherType cipherType, const String *cipherPass);
 
 #endif
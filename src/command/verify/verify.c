@@ -123,6 +123,7 @@ typedef struct VerifyJobData
     String *currentBackup;                                          // In progress backup, if any
     const InfoPg *pgHistory;                                        // Database history list
     bool backupProcessing;                                          // Are we processing WAL or are we processing backups
+    CipherType cipherType;                                          // Cipher type used to encrypt the repo
     const String *manifestCipherPass;                               // Cipher pass for reading backup manifests
     const String *walCipherPass;                                    // Cipher pass for reading WAL files
     const String *backupCipherPass;                                 // Cipher pass for reading backup files referenced in a manifest
@@ -870,8 +871,10 @@ verifyArchive(VerifyJobData *const jobData)
                         pckWriteStrP(param, filePathName);
                         pckWriteBoolP(param, false);
                         pckWriteU32P(param, compressTypeFromName(filePathName));
+                        pckWriteStrIdP(param, hashTypeSha1);
                         pckWriteBinP(param, checksum);
                         pckWriteU64P(param, archiveResult->pgWalInfo.size);
+                        pckWriteU64P(param, jobData->cipherType);
                         pckWriteStrP(param, jobData->walCipherPass);
 
                         // Assign job to result, prepending the archiveId to the key for consistency with backup processing
@@ -1112,16 +1115,20 @@ verifyBackup(VerifyJobData *const jobData)
                             if (fileData.checksumRepoSha1 != NULL)
                             {
                                 pckWriteU32P(param, compressTypeNone);
-                                pckWriteBinP(param, BUF(fileData.checksumRepoSha1, HASH_TYPE_SHA1_SIZE));
+                                pckWriteStrIdP(param, manifestData(jobData->manifest)->backupOptionChecksumType);
+                                pckWriteBinP(param, BUF(fileData.checksumRepoSha1, manifestChecksumSize(jobData->manifest)));
                                 pckWriteU64P(param, fileData.sizeRepo);
+                                pckWriteU64P(param, cipherTypeNone);
                                 pckWriteStrP(param, NULL);
                             }
                             // Else use the file checksum, which may require additional filters, e.g. decompression
                             else
                             {
                                 pckWriteU32P(param, manifestData(jobData->manifest)->backupOptionCompressType);
-                                pckWriteBinP(param, BUF(fileData.checksumSha1, HASH_TYPE_SHA1_SIZE));
+                                pckWriteStrIdP(param, manifestData(jobData->manifest)->backupOptionChecksumType);
+                                pckWriteBinP(param, BUF(fileData.checksumSha1, manifestChecksumSize(jobData->manifest)));
                                 pckWriteU64P(param, fileData.size);
+                                pckWriteU64P(param, jobData->cipherType);
                                 pckWriteStrP(param, jobData->backupCipherPass);
                             }
 
@@ -1639,6 +1646,7 @@ verifyProcess(const bool verboseText)
                 .walPathList = NULL,
                 .walFileList = strLstNew(),
                 .pgHistory = infoArchivePg(archiveInfo),
+                .cipherType = cfgOptionStrId(cfgOptRepoCipherType),
                 .manifestCipherPass = infoPgCipherPass(infoBackupPg(backupInfo)),
                 .walCipherPass = infoPgCipherPass(infoArchivePg(archiveInfo)),
                 .archiveIdResultList = lstNewP(sizeof(VerifyArchiveResult), .comparator = archiveIdComparator),
@@ -2,13 +2,19 @@
 Gz Compress
 
 Based on the documentation at https://github.com/madler/zlib/blob/master/zlib.h
+
+When more than one thread is requested the input is split into chunks that are compressed in parallel by worker threads, the same
+approach used by pigz. Each chunk is compressed as raw deflate using the end of the prior chunk as a dictionary and ends on a byte
+boundary (with a sync flush) so the chunks can simply be concatenated. The calling thread writes the gzip header, the chunks in
+order, and a trailer containing the combined crc, so the result is a standard single member gzip stream that any gz decompressor can
+read.
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <pthread.h>
 #include <stdio.h>
 #include <zlib.h>
 
-#include "common/compress/common.h"
 #include "common/compress/gz/common.h"
 #include "common/compress/gz/compress.h"
 #include "common/debug.h"
@@ -18,12 +24,69 @@ Based on the documentation at https://github.com/madler/zlib/blob/master/zlib.h
 #include "common/type/object.h"
 #include "common/type/pack.h"
 
+/***********************************************************************************************************************************
+Parallel compression constants
+***********************************************************************************************************************************/
+#define GZ_COMPRESS_CHUNK_SIZE                                      (128 * 1024)
+#define GZ_COMPRESS_DICTIONARY_SIZE                                 (32 * 1024)
+#define GZ_COMPRESS_JOB_PER_THREAD                                  2
+#define GZ_COMPRESS_HEADER_SIZE                                     10
+#define GZ_COMPRESS_TRAILER_SIZE                                    8
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
+// Chunk compressed by a worker thread
+typedef struct GzCompressJob
+{
+    Buffer *input;                                                  // Uncompressed chunk
+    Buffer *output;                                                 // Compressed chunk
+    size_t outputOffset;                                            // Output already written
+    bool last;                                                      // Is this the last chunk?
+    bool done;                                                      // Has the chunk been compressed?
+    int result;                                                     // Result of deflate
+    uLong crc;                                                      // Crc of the uncompressed chunk
+} GzCompressJob;
+
+// Worker thread
+typedef struct GzCompressWorker
+{
+    pthread_t thread;                                               // Thread id
+    z_stream stream;                                                // Raw deflate stream used by the thread
+    struct GzCompressParallel *parallel;                            // Parallel compression state
+} GzCompressWorker;
+
+// Parallel compression state. The mutex protects the job counters, done flags, and stop.
+typedef struct GzCompressParallel
+{
+    pthread_mutex_t mutex;                                          // Protects shared state
+    pthread_cond_t cond;                                            // Broadcast when a job is submitted or done, or on stop
+    bool stop;                                                      // Stop worker threads?
+
+    GzCompressWorker *workerList;                                   // Worker threads
+    unsigned int workerTotal;                                       // Total worker threads
+    unsigned int workerStarted;                                     // Worker threads started
+
+    GzCompressJob *jobList;                                         // Ring of jobs
+    unsigned int jobTotal;                                          // Total jobs in the ring
+    uint64_t jobSubmitted;                                          // Jobs submitted for compression
+    uint64_t jobStarted;                                            // Jobs taken by worker threads
+    uint64_t jobWritten;                                            // Jobs written to output
+
+    size_t inputOffset;                                             // Input already added to jobs
+    bool filling;                                                   // Is the next job being filled with input?
+    Buffer *pending;                                                // Header or trailer to be written
+    size_t pendingOffset;                                           // Pending already written
+    bool lastSubmitted;                                             // Has the last chunk been submitted?
+    bool lastWritten;                                               // Has the last chunk been written?
+    uLong crc;                                                      // Combined crc of all chunks written
+    uint64_t size;                                                  // Uncompressed size of all chunks written
+} GzCompressParallel;
+
 typedef struct GzCompress
 {
     z_stream stream;                                                // Compression stream state
+    GzCompressParallel *parallel;                                   // Parallel compression state (NULL when single-threaded)
 
     bool inputSame;                                                 // Is the same input required on the next process call?
     bool flushing;                                                  // Is input complete and flushing in progress?
@@ -51,6 +114,135 @@ Compression constants
 ***********************************************************************************************************************************/
 #define MEM_LEVEL                                                   9
 
+/***********************************************************************************************************************************
+Worker thread. Jobs are taken in the order they were submitted and compressed without holding the mutex. No memory is allocated
+from mem contexts here since all buffers belong to the job.
+***********************************************************************************************************************************/
+static void *
+gzCompressWorker(void *const param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, param);
+    FUNCTION_TEST_END();
+
+    GzCompressWorker *const worker = param;
+    GzCompressParallel *const parallel = worker->parallel;
+
+    pthread_mutex_lock(&parallel->mutex);
+
+    while (!parallel->stop)
+    {
+        // Wait for a job
+        if (parallel->jobStarted == parallel->jobSubmitted)
+        {
+            pthread_cond_wait(&parallel->cond, &parallel->mutex);
+        }
+        // Else compress the next job
+        else
+        {
+            const uint64_t jobIdx = parallel->jobStarted++;
+            GzCompressJob *const job = &parallel->jobList[jobIdx % parallel->jobTotal];
+
+            pthread_mutex_unlock(&parallel->mutex);
+
+            // Use the end of the prior chunk as a dictionary so compression does not suffer from splitting the input. The prior
+            // chunk cannot be refilled until this chunk has been written so it is safe to read. Reset and set dictionary can only
+            // fail on an invalid stream and the stream was checked when it was initialized.
+            deflateReset(&worker->stream);
+
+            if (jobIdx > 0)
+            {
+                const Buffer *const prior = parallel->jobList[(jobIdx - 1) % parallel->jobTotal].input;
+
+                deflateSetDictionary(
+                    &worker->stream, bufPtrConst(prior) + bufUsed(prior) - GZ_COMPRESS_DICTIONARY_SIZE,
+                    GZ_COMPRESS_DICTIONARY_SIZE);
+            }
+
+            // Compress the chunk. The output buffer is large enough to hold the chunk even if it is not compressible so one call is
+            // enough. A sync flush ends the chunk on a byte boundary so the next chunk can be appended.
+            worker->stream.avail_in = (unsigned int)bufUsed(job->input);
+            worker->stream.next_in = bufPtr(job->input);
+            worker->stream.avail_out = (unsigned int)bufSize(job->output);
+            worker->stream.next_out = bufPtr(job->output);
+
+            job->result = deflate(&worker->stream, job->last ? Z_FINISH : Z_SYNC_FLUSH);
+
+            bufUsedSet(job->output, bufSize(job->output) - worker->stream.avail_out);
+            job->crc = crc32(crc32(0, Z_NULL, 0), bufPtr(job->input), (unsigned int)bufUsed(job->input));
+
+            pthread_mutex_lock(&parallel->mutex);
+
+            job->done = true;
+            pthread_cond_broadcast(&parallel->cond);
+        }
+    }
+
+    pthread_mutex_unlock(&parallel->mutex);
+
+    FUNCTION_TEST_RETURN_P(VOID, NULL);
+}
+
+/***********************************************************************************************************************************
+Start worker threads
+***********************************************************************************************************************************/
+static void
+gzCompressParallelStart(GzCompressParallel *const this, const int level)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM_P(VOID, this);
+        FUNCTION_LOG_PARAM(INT, level);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    for (unsigned int workerIdx = 0; workerIdx < this->workerTotal; workerIdx++)
+    {
+        GzCompressWorker *const worker = &this->workerList[workerIdx];
+
+        *worker = (GzCompressWorker){.parallel = this};
+
+        errno = pthread_create(&worker->thread, NULL, gzCompressWorker, worker);
+        THROW_ON_SYS_ERROR(errno != 0, KernelError, "unable to create compress thread");
+
+        this->workerStarted++;
+
+        // The stream is not used until a job is submitted so it is safe to initialize after the thread has started. If this fails
+        // the stream is left zeroed, which deflateEnd() ignores.
+        gzError(deflateInit2(&worker->stream, level, Z_DEFLATED, -WINDOW_BITS, MEM_LEVEL, Z_DEFAULT_STRATEGY));
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Stop worker threads and free their deflate streams
+***********************************************************************************************************************************/
+static void
+gzCompressParallelStop(GzCompressParallel *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM_P(VOID, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    pthread_mutex_lock(&this->mutex);
+    this->stop = true;
+    pthread_cond_broadcast(&this->cond);
+    pthread_mutex_unlock(&this->mutex);
+
+    for (; this->workerStarted > 0; this->workerStarted--)
+    {
+        GzCompressWorker *const worker = &this->workerList[this->workerStarted - 1];
+
+        pthread_join(worker->thread, NULL);
+        deflateEnd(&worker->stream);
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Free deflate stream
 ***********************************************************************************************************************************/
@@ -65,7 +257,15 @@ gzCompressFreeResource(THIS_VOID)
 
     ASSERT(this != NULL);
 
-    deflateEnd(&this->stream);
+    if (this->parallel != NULL)
+    {
+        gzCompressParallelStop(this->parallel);
+
+        pthread_cond_destroy(&this->parallel->cond);
+        pthread_mutex_destroy(&this->parallel->mutex);
+    }
+    else
+        deflateEnd(&this->stream);
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -129,6 +329,190 @@ gzCompressProcess(THIS_VOID, const Buffer *const uncompressed, Buffer *const com
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Compress data in parallel
+***********************************************************************************************************************************/
+// Copy as much of the source as will fit into the compressed buffer and return the size copied
+static size_t
+gzCompressParallelCopy(Buffer *const compressed, const Buffer *const source, const size_t sourceOffset)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, compressed);
+        FUNCTION_TEST_PARAM(BUFFER, source);
+        FUNCTION_TEST_PARAM(SIZE, sourceOffset);
+    FUNCTION_TEST_END();
+
+    size_t result = bufUsed(source) - sourceOffset;
+
+    if (result > bufRemains(compressed))
+        result = bufRemains(compressed);
+
+    bufCatSub(compressed, source, sourceOffset, result);
+
+    FUNCTION_TEST_RETURN(SIZE, result);
+}
+
+// Has the job been compressed?
+static bool
+gzCompressParallelJobDone(GzCompressParallel *const this, const GzCompressJob *const job)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM_P(VOID, job);
+    FUNCTION_TEST_END();
+
+    pthread_mutex_lock(&this->mutex);
+    const bool result = job->done;
+    pthread_mutex_unlock(&this->mutex);
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+// Submit the job being filled to the worker threads
+static void
+gzCompressParallelJobSubmit(GzCompressParallel *const this, GzCompressJob *const job, const bool last)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+        FUNCTION_TEST_PARAM_P(VOID, job);
+        FUNCTION_TEST_PARAM(BOOL, last);
+    FUNCTION_TEST_END();
+
+    job->last = last;
+    this->lastSubmitted = last;
+    this->filling = false;
+
+    pthread_mutex_lock(&this->mutex);
+    job->done = false;
+    this->jobSubmitted++;
+    pthread_cond_broadcast(&this->cond);
+    pthread_mutex_unlock(&this->mutex);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+static void
+gzCompressParallelProcess(THIS_VOID, const Buffer *const uncompressed, Buffer *const compressed)
+{
+    THIS(GzCompress);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(GZ_COMPRESS, this);
+        FUNCTION_LOG_PARAM(BUFFER, uncompressed);
+        FUNCTION_LOG_PARAM(BUFFER, compressed);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->done);
+    ASSERT(compressed != NULL);
+    ASSERT(!this->flushing || uncompressed == NULL);
+
+    GzCompressParallel *const parallel = this->parallel;
+
+    // Flushing
+    if (uncompressed == NULL)
+        this->flushing = true;
+    // Else start at the beginning of new input
+    else if (!this->inputSame)
+        parallel->inputOffset = 0;
+
+    // Process until done, the output is full, or all input has been added to jobs. Only the calling thread modifies the job
+    // counters so they can be read without the mutex.
+    while (!this->done && !bufFull(compressed) && (this->flushing || parallel->inputOffset < bufUsed(uncompressed)))
+    {
+        GzCompressJob *const jobWrite = &parallel->jobList[parallel->jobWritten % parallel->jobTotal];
+
+        // Write the header or trailer
+        if (parallel->pendingOffset < bufUsed(parallel->pending))
+        {
+            parallel->pendingOffset += gzCompressParallelCopy(compressed, parallel->pending, parallel->pendingOffset);
+
+            // Compression is done once the trailer has been written
+            this->done = parallel->lastWritten && parallel->pendingOffset == bufUsed(parallel->pending);
+        }
+        // Else write the oldest job once it has been compressed
+        else if (parallel->jobWritten < parallel->jobSubmitted && gzCompressParallelJobDone(parallel, jobWrite))
+        {
+            gzError(jobWrite->result);
+
+            jobWrite->outputOffset += gzCompressParallelCopy(compressed, jobWrite->output, jobWrite->outputOffset);
+
+            if (jobWrite->outputOffset == bufUsed(jobWrite->output))
+            {
+                parallel->crc = crc32_combine(parallel->crc, jobWrite->crc, (z_off_t)bufUsed(jobWrite->input));
+                parallel->size += bufUsed(jobWrite->input);
+                parallel->jobWritten++;
+
+                // Write the trailer (crc and size modulo 2^32, little endian) after the last job
+                if (jobWrite->last)
+                {
+                    unsigned char trailer[GZ_COMPRESS_TRAILER_SIZE];
+
+                    for (unsigned int byteIdx = 0; byteIdx < 4; byteIdx++)
+                    {
+                        trailer[byteIdx] = (unsigned char)(parallel->crc >> (byteIdx * 8));
+                        trailer[byteIdx + 4] = (unsigned char)(parallel->size >> (byteIdx * 8));
+                    }
+
+                    bufUsedZero(parallel->pending);
+                    bufCat(parallel->pending, BUF(trailer, sizeof(trailer)));
+
+                    parallel->pendingOffset = 0;
+                    parallel->lastWritten = true;
+                }
+            }
+        }
+        // Else add input to the next job. The job after the oldest job is not refilled until the oldest job has been written
+        // because the job that follows it may still be using its input as a dictionary.
+        else if (!parallel->lastSubmitted && parallel->jobSubmitted - parallel->jobWritten + 1 < parallel->jobTotal)
+        {
+            GzCompressJob *const jobFill = &parallel->jobList[parallel->jobSubmitted % parallel->jobTotal];
+
+            if (!parallel->filling)
+            {
+                bufUsedZero(jobFill->input);
+                jobFill->outputOffset = 0;
+                parallel->filling = true;
+            }
+
+            // Submit the last job when flushing
+            if (this->flushing)
+            {
+                gzCompressParallelJobSubmit(parallel, jobFill, true);
+            }
+            // Else add input and submit the job when it is full
+            else
+            {
+                size_t size = bufUsed(uncompressed) - parallel->inputOffset;
+
+                if (size > bufRemains(jobFill->input))
+                    size = bufRemains(jobFill->input);
+
+                bufCatSub(jobFill->input, uncompressed, parallel->inputOffset, size);
+                parallel->inputOffset += size;
+
+                if (bufFull(jobFill->input))
+                    gzCompressParallelJobSubmit(parallel, jobFill, false);
+            }
+        }
+        // Else wait for the oldest job to be compressed
+        else
+        {
+            pthread_mutex_lock(&parallel->mutex);
+
+            while (!jobWrite->done)
+                pthread_cond_wait(&parallel->cond, &parallel->mutex);
+
+            pthread_mutex_unlock(&parallel->mutex);
+        }
+    }
+
+    // Can more input be provided on the next call?
+    this->inputSame = this->flushing ? !this->done : parallel->inputOffset < bufUsed(uncompressed);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Is compress done?
 ***********************************************************************************************************************************/
@@ -163,35 +547,115 @@ gzCompressInputSame(const THIS_VOID)
     FUNCTION_TEST_RETURN(BOOL, this->inputSame);
 }
 
+/***********************************************************************************************************************************
+Filter param list. Fields are written in the order they are read by compressFilterPack().
+***********************************************************************************************************************************/
+static Pack *
+gzCompressParamList(const int level, const GzCompressNewParam param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, level);
+        FUNCTION_TEST_PARAM(BOOL, param.raw);
+        FUNCTION_TEST_PARAM(UINT, param.thread);
+    FUNCTION_TEST_END();
+
+    Pack *result;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const packWrite = pckWriteNewP();
+
+        pckWriteI32P(packWrite, level);
+        pckWriteBoolP(packWrite, param.raw);
+        pckWriteU32P(packWrite, param.thread);
+        pckWriteEndP(packWrite);
+
+        result = pckMove(pckWriteResult(packWrite), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(PACK, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN IoFilter *
-gzCompressNew(const int level, const bool raw)
+gzCompressNew(const int level, const GzCompressNewParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(INT, level);
-        FUNCTION_LOG_PARAM(BOOL, raw);
+        FUNCTION_LOG_PARAM(BOOL, param.raw);
+        FUNCTION_LOG_PARAM(UINT, param.thread);
     FUNCTION_LOG_END();
 
     ASSERT(level >= GZ_COMPRESS_LEVEL_MIN && level <= GZ_COMPRESS_LEVEL_MAX);
 
-    OBJ_NEW_BEGIN(GzCompress, .childQty = MEM_CONTEXT_QTY_MAX, .callbackQty = 1)
+    OBJ_NEW_BEGIN(GzCompress, .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX, .callbackQty = 1)
     {
         *this = (GzCompress)
         {
             .stream = {.zalloc = NULL},
         };
 
-        // Create gz stream
-        gzError(deflateInit2(&this->stream, level, Z_DEFLATED, (raw ? 0 : WANT_GZ) | WINDOW_BITS, MEM_LEVEL, Z_DEFAULT_STRATEGY));
+        // Compress in parallel when more than one thread is requested. Parallel compression only writes the gzip format so raw
+        // output is always compressed serially.
+        if (param.thread > 1 && !param.raw)
+        {
+            GzCompressParallel *const parallel = memNew(sizeof(GzCompressParallel));
+
+            *parallel = (GzCompressParallel)
+            {
+                .workerList = memNew(sizeof(GzCompressWorker) * param.thread),
+                .workerTotal = param.thread,
+                .jobList = memNew(sizeof(GzCompressJob) * param.thread * GZ_COMPRESS_JOB_PER_THREAD),
+                .jobTotal = param.thread * GZ_COMPRESS_JOB_PER_THREAD,
+                .pending = bufNew(GZ_COMPRESS_HEADER_SIZE),
+                .crc = crc32(0, Z_NULL, 0),
+            };
+
+            // Gzip header with no file name, no modification time, and unix os
+            static const unsigned char header[GZ_COMPRESS_HEADER_SIZE] = {0x1f, 0x8b, 0x08, 0, 0, 0, 0, 0, 0, 0x03};
+            bufCat(parallel->pending, BUF(header, sizeof(header)));
+
+            // The output buffer is large enough to hold a chunk that does not compress
+            for (unsigned int jobIdx = 0; jobIdx < parallel->jobTotal; jobIdx++)
+            {
+                parallel->jobList[jobIdx] = (GzCompressJob)
+                {
+                    .input = bufNew(GZ_COMPRESS_CHUNK_SIZE),
+                    .output = bufNew(compressBound(GZ_COMPRESS_CHUNK_SIZE) + 64),
+                };
+            }
+
+            this->parallel = parallel;
+
+            // Initialize the mutex and condition. The static initializers are not used since they are only valid for statically
+            // allocated objects.
+            errno = pthread_mutex_init(&parallel->mutex, NULL);
+            THROW_ON_SYS_ERROR(errno != 0, KernelError, "unable to initialize compress mutex");
+
+            errno = pthread_cond_init(&parallel->cond, NULL);
+            THROW_ON_SYS_ERROR(errno != 0, KernelError, "unable to initialize compress condition");
+
+            // Set free callback before starting threads so they are stopped on error
+            memContextCallbackSet(objMemContext(this), gzCompressFreeResource, this);
+            gzCompressParallelStart(parallel, level);
+        }
+        else
+        {
+            // Create gz stream
+            gzError(
+                deflateInit2(
+                    &this->stream, level, Z_DEFLATED, (param.raw ? 0 : WANT_GZ) | WINDOW_BITS, MEM_LEVEL, Z_DEFAULT_STRATEGY));
 
-        // Set free callback to ensure gz context is freed
-        memContextCallbackSet(objMemContext(this), gzCompressFreeResource, this);
+            // Set free callback to ensure gz context is freed
+            memContextCallbackSet(objMemContext(this), gzCompressFreeResource, this);
+        }
     }
     OBJ_NEW_END();
 
     FUNCTION_LOG_RETURN(
         IO_FILTER,
         ioFilterNewP(
-            GZ_COMPRESS_FILTER_TYPE, this, compressParamList(level, raw), .done = gzCompressDone, .inOut = gzCompressProcess,
-            .inputSame = gzCompressInputSame));
+            GZ_COMPRESS_FILTER_TYPE, this, gzCompressParamList(level, param), .done = gzCompressDone,
+            .inOut = this->parallel != NULL ? gzCompressParallelProcess : gzCompressProcess, .inputSame = gzCompressInputSame));
 }
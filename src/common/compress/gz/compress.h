@@ -22,6 +22,16 @@ Level constants
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
-FN_EXTERN IoFilter *gzCompressNew(int level, bool raw);
+typedef struct GzCompressNewParam
+{
+    VAR_PARAM_HEADER;
+    bool raw;                                                       // Omit header and trailer
+    unsigned int thread;                                            // Threads to compress with (0 or 1 to compress serially)
+} GzCompressNewParam;
+
+#define gzCompressNewP(level, ...)                                                                                                 \
+    gzCompressNew(level, (GzCompressNewParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN IoFilter *gzCompressNew(int level, GzCompressNewParam param);
 
 #endif
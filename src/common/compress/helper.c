@@ -30,6 +30,66 @@ Compression type constants
 // Constants for currently unsupported compression types
 #define XZ_EXT                                                      "xz"
 
+/***********************************************************************************************************************************
+Create compression filters from the common parameters. Each compressor only receives the parameters it supports.
+***********************************************************************************************************************************/
+static IoFilter *
+compressHelperBz2New(const int level, const CompressFilterParam param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, level);
+        FUNCTION_TEST_PARAM(BOOL, param.raw);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(IO_FILTER, bz2CompressNew(level, param.raw));
+}
+
+static IoFilter *
+compressHelperGzNew(const int level, const CompressFilterParam param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, level);
+        FUNCTION_TEST_PARAM(BOOL, param.raw);
+        FUNCTION_TEST_PARAM(UINT, param.thread);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(IO_FILTER, gzCompressNewP(level, .raw = param.raw, .thread = param.thread));
+}
+
+static IoFilter *
+compressHelperLz4New(const int level, const CompressFilterParam param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, level);
+        FUNCTION_TEST_PARAM(BOOL, param.raw);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(IO_FILTER, lz4CompressNew(level, param.raw));
+}
+
+#ifdef HAVE_LIBZST
+
+static IoFilter *
+compressHelperZstNew(const int level, const CompressFilterParam param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, level);
+        FUNCTION_TEST_PARAM(BOOL, param.raw);
+        FUNCTION_TEST_PARAM(UINT, param.thread);
+        FUNCTION_TEST_PARAM(BOOL, param.longDistance);
+        FUNCTION_TEST_PARAM(BOOL, param.adapt);
+        FUNCTION_TEST_PARAM(BOOL, param.seek);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(
+        IO_FILTER,
+        zstCompressNewP(
+            level, .raw = param.raw, .thread = param.thread, .longDistance = param.longDistance, .adapt = param.adapt,
+            .seek = param.seek));
+}
+
+#endif // HAVE_LIBZST
+
 /***********************************************************************************************************************************
 Configuration for supported and future compression types
 ***********************************************************************************************************************************/
@@ -39,7 +99,7 @@ static const struct CompressHelperLocal
     const String *const type;                                       // Compress type -- must be extension without period prefixed
     const String *const ext;                                        // File extension with period prefixed
     StringId compressType;                                          // Type of the compression filter
-    IoFilter *(*compressNew)(int, bool);                            // Function to create new compression filter
+    IoFilter *(*compressNew)(int, CompressFilterParam);             // Function to create new compression filter
     StringId decompressType;                                        // Type of the decompression filter
     IoFilter *(*decompressNew)(bool);                               // Function to create new decompression filter
 } compressHelperLocal[] =
@@ -54,7 +114,7 @@ static const struct CompressHelperLocal
         .type = STRDEF(BZ2_EXT),
         .ext = STRDEF("." BZ2_EXT),
         .compressType = BZ2_COMPRESS_FILTER_TYPE,
-        .compressNew = bz2CompressNew,
+        .compressNew = compressHelperBz2New,
         .decompressType = BZ2_DECOMPRESS_FILTER_TYPE,
         .decompressNew = bz2DecompressNew,
     },
@@ -63,7 +123,7 @@ static const struct CompressHelperLocal
         .type = STRDEF(GZ_EXT),
         .ext = STRDEF("." GZ_EXT),
         .compressType = GZ_COMPRESS_FILTER_TYPE,
-        .compressNew = gzCompressNew,
+        .compressNew = compressHelperGzNew,
         .decompressType = GZ_DECOMPRESS_FILTER_TYPE,
         .decompressNew = gzDecompressNew,
     },
@@ -72,7 +132,7 @@ static const struct CompressHelperLocal
         .type = STRDEF(LZ4_EXT),
         .ext = STRDEF("." LZ4_EXT),
         .compressType = LZ4_COMPRESS_FILTER_TYPE,
-        .compressNew = lz4CompressNew,
+        .compressNew = compressHelperLz4New,
         .decompressType = LZ4_DECOMPRESS_FILTER_TYPE,
         .decompressNew = lz4DecompressNew,
     },
@@ -82,7 +142,7 @@ static const struct CompressHelperLocal
         .ext = STRDEF("." ZST_EXT),
 #ifdef HAVE_LIBZST
         .compressType = ZST_COMPRESS_FILTER_TYPE,
-        .compressNew = zstCompressNew,
+        .compressNew = compressHelperZstNew,
         .decompressType = ZST_DECOMPRESS_FILTER_TYPE,
         .decompressNew = zstDecompressNew,
 #endif
@@ -177,13 +237,17 @@ compressFilter(const CompressType type, const int level, const CompressFilterPar
         FUNCTION_TEST_PARAM(ENUM, type);
         FUNCTION_TEST_PARAM(INT, level);
         FUNCTION_TEST_PARAM(BOOL, param.raw);
+        FUNCTION_TEST_PARAM(UINT, param.thread);
+        FUNCTION_TEST_PARAM(BOOL, param.longDistance);
+        FUNCTION_TEST_PARAM(BOOL, param.adapt);
+        FUNCTION_TEST_PARAM(BOOL, param.seek);
     FUNCTION_TEST_END();
 
     ASSERT(type < LENGTH_OF(compressHelperLocal));
     ASSERT(type != compressTypeNone);
     compressTypePresent(type);
 
-    FUNCTION_TEST_RETURN(IO_FILTER, compressHelperLocal[type].compressNew(level, param.raw));
+    FUNCTION_TEST_RETURN(IO_FILTER, compressHelperLocal[type].compressNew(level, param));
 }
 
 /**********************************************************************************************************************************/
@@ -209,11 +273,21 @@ compressFilterPack(const StringId filterType, const Pack *const filterParam)
             {
                 ASSERT(filterParam != NULL);
 
+                // Parameters not written by a compressor are read as defaults
                 PackRead *const paramRead = pckReadNew(filterParam);
                 const int level = pckReadI32P(paramRead);
                 const bool raw = pckReadBoolP(paramRead);
-
-                result = ioFilterMove(compress->compressNew(level, raw), memContextPrior());
+                const unsigned int thread = pckReadU32P(paramRead);
+                const bool longDistance = pckReadBoolP(paramRead);
+                const bool adapt = pckReadBoolP(paramRead);
+                const bool seek = pckReadBoolP(paramRead);
+
+                result = ioFilterMove(
+                    compress->compressNew(
+                        level,
+                        (CompressFilterParam){
+                            .raw = raw, .thread = thread, .longDistance = longDistance, .adapt = adapt, .seek = seek}),
+                    memContextPrior());
                 break;
             }
             else if (filterType == compress->decompressType)
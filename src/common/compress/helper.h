@@ -54,6 +54,10 @@ typedef struct CompressFilterParam
 {
     VAR_PARAM_HEADER;
     bool raw;                                                       // Omit headers, checksum, etc. when possible
+    unsigned int thread;                                            // Threads to compress with when supported (0 or 1 for one)
+    bool longDistance;                                              // Use long distance matching when supported
+    bool adapt;                                                     // Use minimum level for incompressible data when supported
+    bool seek;                                                      // Write independent frames and a seek table when supported
 } CompressFilterParam;
 
 #define compressFilterP(type, level, ...)                                                                                          \
@@ -5,16 +5,27 @@ ZST Compress
 
 #ifdef HAVE_LIBZST
 
+#include <string.h>
 #include <zstd.h>
 
-#include "common/compress/common.h"
 #include "common/compress/zst/common.h"
 #include "common/compress/zst/compress.h"
+#include "common/compress/zst/seek.h"
 #include "common/debug.h"
 #include "common/io/filter/filter.h"
 #include "common/log.h"
 #include "common/type/object.h"
 #include "common/type/pack.h"
+#include "version.h"
+
+/***********************************************************************************************************************************
+Adaptive compression constants
+
+The sample must be large enough that the input buffered by zstd (up to a 128KiB block) does not skew the ratio. If the output is at
+least 90% of the input for the sample then the data is considered incompressible.
+***********************************************************************************************************************************/
+#define ZST_COMPRESS_ADAPT_SAMPLE_SIZE                              (4 * 1024 * 1024)
+#define ZST_COMPRESS_ADAPT_RATIO                                    90
 
 /***********************************************************************************************************************************
 Object type
@@ -23,6 +34,19 @@ typedef struct ZstCompress
 {
     ZSTD_CStream *context;                                          // Compression context
     int level;                                                      // Compression level
+    unsigned int thread;                                            // Threads used for compression (0 or 1 is single-threaded)
+    bool longDistance;                                              // Use long distance matching?
+    bool adapt;                                                     // Is the compression ratio still being sampled?
+    uint64_t adaptIn;                                               // Input bytes sampled
+    uint64_t adaptOut;                                              // Output bytes sampled
+    bool restart;                                                   // Restart at the minimum level when the frame ends?
+    bool frameEnd;                                                  // Is the current frame being ended?
+    uint64_t frameIn;                                               // Input bytes in the current frame
+    uint64_t frameOffset;                                           // Offset of the current frame in the output
+    uint64_t outputTotal;                                           // Output bytes from prior calls
+    Buffer *seekTable;                                              // Seek table (NULL when not seekable)
+    size_t seekTableOffset;                                         // Seek table already written
+    bool seekTableWrite;                                            // Is the seek table being written?
     IoFilter *filter;                                               // Filter interface
 
     bool inputSame;                                                 // Is the same input required on the next process call?
@@ -37,8 +61,12 @@ static void
 zstCompressToLog(const ZstCompress *const this, StringStatic *const debugLog)
 {
     strStcFmt(
-        debugLog, "{level: %d, inputSame: %s, inputOffset: %zu, flushing: %s}", this->level, cvtBoolToConstZ(this->inputSame),
-        this->inputOffset, cvtBoolToConstZ(this->flushing));
+        debugLog,
+        "{level: %d, thread: %u, longDistance: %s, adapt: %s, restart: %s, seek: %s, frameEnd: %s, frameIn: %" PRIu64 ","
+        " inputSame: %s, inputOffset: %zu, flushing: %s}",
+        this->level, this->thread, cvtBoolToConstZ(this->longDistance), cvtBoolToConstZ(this->adapt),
+        cvtBoolToConstZ(this->restart), cvtBoolToConstZ(this->seekTable != NULL), cvtBoolToConstZ(this->frameEnd), this->frameIn,
+        cvtBoolToConstZ(this->inputSame), this->inputOffset, cvtBoolToConstZ(this->flushing));
 }
 
 #define FUNCTION_LOG_ZST_COMPRESS_TYPE                                                                                             \
@@ -65,6 +93,30 @@ zstCompressFreeResource(THIS_VOID)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Record the end of a frame. The output position is the position in the output buffer where the frame ended.
+***********************************************************************************************************************************/
+static void
+zstCompressFrameEnd(ZstCompress *const this, const size_t outputPos)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_COMPRESS, this);
+        FUNCTION_TEST_PARAM(SIZE, outputPos);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    const uint64_t frameOffsetNext = this->outputTotal + outputPos;
+
+    if (this->seekTable != NULL)
+        zstSeekTableAdd(this->seekTable, (size_t)(frameOffsetNext - this->frameOffset), (size_t)this->frameIn);
+
+    this->frameOffset = frameOffsetNext;
+    this->frameIn = 0;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Compress data
 ***********************************************************************************************************************************/
@@ -92,26 +144,105 @@ zstCompressProcess(THIS_VOID, const Buffer *const uncompressed, Buffer *const co
     if (uncompressed == NULL)
     {
         this->flushing = true;
-        this->inputSame = zstError(ZSTD_endStream(this->context, &out)) != 0;
+
+        // End the last frame. If a frame has already ended and there has been no input since then an empty frame is not written,
+        // since decompressing an empty frame produces no output and that is an error when more input follows.
+        if (!this->seekTableWrite)
+        {
+            this->inputSame =
+                (this->frameIn > 0 || this->frameOffset == 0) && zstError(ZSTD_endStream(this->context, &out)) != 0;
+
+            // Complete the seek table when seekable. No seek table is written for empty input for the same reason.
+            if (!this->inputSame && this->seekTable != NULL)
+            {
+                if (this->frameIn > 0)
+                    zstCompressFrameEnd(this, out.pos);
+
+                if (!bufEmpty(this->seekTable))
+                {
+                    zstSeekTableEnd(this->seekTable);
+                    this->seekTableWrite = true;
+                }
+            }
+        }
+
+        // Write the seek table after the last frame
+        if (this->seekTableWrite)
+        {
+            size_t size = bufUsed(this->seekTable) - this->seekTableOffset;
+
+            if (size > out.size - out.pos)
+                size = out.size - out.pos;
+
+            memcpy((unsigned char *)out.dst + out.pos, bufPtrConst(this->seekTable) + this->seekTableOffset, size);
+            out.pos += size;
+
+            this->seekTableOffset += size;
+            this->inputSame = this->seekTableOffset < bufUsed(this->seekTable);
+        }
     }
     // Else still have input data
     else
     {
         // Initialize input buffer
-        ZSTD_inBuffer in =
+        const size_t inputSize = bufUsed(uncompressed) - this->inputOffset;
+        ZSTD_inBuffer in = {.src = bufPtrConst(uncompressed) + this->inputOffset, .size = inputSize};
+
+        // A full seekable frame is only ended when there is more input so an empty frame is not written when the input ends on a
+        // frame boundary
+        if (this->seekTable != NULL && this->frameIn == ZST_SEEK_FRAME_SIZE)
+            this->frameEnd = true;
+
+        // End the current frame before compressing more input. Decompression handles multiple frames so the frames do not need to
+        // be recorded anywhere except in the seek table. If restarting then the new frame is compressed at the minimum level.
+        if (this->frameEnd && zstError(ZSTD_endStream(this->context, &out)) == 0)
         {
-            .src = bufPtrConst(uncompressed) + this->inputOffset,
-            .size = bufUsed(uncompressed) - this->inputOffset,
-        };
+            zstCompressFrameEnd(this, out.pos);
+
+            if (this->restart)
+            {
+                zstError(ZSTD_initCStream(this->context, ZST_COMPRESS_LEVEL_MIN));
+                this->restart = false;
+            }
 
-        // Perform compression
-        zstError(ZSTD_compressStream(this->context, &out, &in));
+            this->frameEnd = false;
+        }
 
-        // If the input buffer was not entirely consumed then set inputSame and store the offset where processing will restart
-        if (in.pos < in.size)
+        // Perform compression unless the frame is still being ended
+        if (!this->frameEnd)
         {
-            // Output buffer should be completely full
-            ASSERT(out.pos == out.size);
+            // Limit input so seekable frames do not exceed the frame size
+            if (this->seekTable != NULL && in.size > ZST_SEEK_FRAME_SIZE - this->frameIn)
+                in.size = (size_t)(ZST_SEEK_FRAME_SIZE - this->frameIn);
+
+            zstError(ZSTD_compressStream(this->context, &out, &in));
+            this->frameIn += in.pos;
+
+            // Sample the ratio and restart at the minimum level if the data is incompressible. This saves CPU on data that is
+            // already compressed, e.g. images or TOAST compressed with lz4.
+            if (this->adapt)
+            {
+                this->adaptIn += in.pos;
+                this->adaptOut += out.pos;
+
+                if (this->adaptIn >= ZST_COMPRESS_ADAPT_SAMPLE_SIZE)
+                {
+                    this->adapt = false;
+                    this->restart = this->adaptOut * 100 >= this->adaptIn * ZST_COMPRESS_ADAPT_RATIO;
+                    this->frameEnd = this->restart;
+                }
+            }
+        }
+
+        // If the input buffer was not entirely consumed or the frame is being ended then set inputSame and store the offset where
+        // processing will restart
+        if (in.pos < inputSize || this->frameEnd)
+        {
+            // Output buffer should be completely full unless worker threads are enabled, in which case zstd may return before all
+            // input is consumed even though there is still space in the output buffer, or the input was limited by the frame size
+            ASSERT(
+                out.pos == out.size || this->thread > 1 || this->frameEnd ||
+                (this->seekTable != NULL && this->frameIn == ZST_SEEK_FRAME_SIZE));
 
             this->inputSame = true;
             this->inputOffset += in.pos;
@@ -125,6 +256,7 @@ zstCompressProcess(THIS_VOID, const Buffer *const uncompressed, Buffer *const co
     }
 
     bufUsedInc(compressed, out.pos);
+    this->outputTotal += out.pos;
 
     FUNCTION_LOG_RETURN_VOID();
 }
@@ -163,13 +295,102 @@ zstCompressInputSame(const THIS_VOID)
     FUNCTION_TEST_RETURN(BOOL, this->inputSame);
 }
 
+/***********************************************************************************************************************************
+Worker threads and long distance matching are only available in libzstd >= 1.4.0. Error when they are requested with an older
+version since they would otherwise be silently ignored.
+***********************************************************************************************************************************/
+#define ZST_COMPRESS_VERSION_ADVANCED                               10400
+
+static void
+zstCompressParamCheckVersion(const unsigned int version, const unsigned int thread, const bool longDistance)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT, version);
+        FUNCTION_TEST_PARAM(UINT, thread);
+        FUNCTION_TEST_PARAM(BOOL, longDistance);
+    FUNCTION_TEST_END();
+
+    if (version < ZST_COMPRESS_VERSION_ADVANCED)
+    {
+        if (thread > 1)
+        {
+            THROW_FMT(
+                OptionInvalidValueError,
+                "compress-thread > 1 requires libzstd >= 1.4.0 but " PROJECT_NAME " was built with %u.%u.%u", version / 10000,
+                version / 100 % 100, version % 100);
+        }
+
+        if (longDistance)
+        {
+            THROW_FMT(
+                OptionInvalidValueError, "compress-long requires libzstd >= 1.4.0 but " PROJECT_NAME " was built with %u.%u.%u",
+                version / 10000, version / 100 % 100, version % 100);
+        }
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+FN_EXTERN void
+zstCompressParamCheck(const unsigned int thread, const bool longDistance)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT, thread);
+        FUNCTION_TEST_PARAM(BOOL, longDistance);
+    FUNCTION_TEST_END();
+
+    zstCompressParamCheckVersion(ZSTD_VERSION_NUMBER, thread, longDistance);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Filter param list. Fields are in the order read by compressFilterPack(), which uses defaults for fields other compressors omit.
+***********************************************************************************************************************************/
+static Pack *
+zstCompressParamList(const int level, const ZstCompressNewParam param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, level);
+        FUNCTION_TEST_PARAM(BOOL, param.raw);
+        FUNCTION_TEST_PARAM(UINT, param.thread);
+        FUNCTION_TEST_PARAM(BOOL, param.longDistance);
+        FUNCTION_TEST_PARAM(BOOL, param.adapt);
+        FUNCTION_TEST_PARAM(BOOL, param.seek);
+    FUNCTION_TEST_END();
+
+    Pack *result;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        PackWrite *const packWrite = pckWriteNewP();
+
+        pckWriteI32P(packWrite, level);
+        pckWriteBoolP(packWrite, param.raw);
+        pckWriteU32P(packWrite, param.thread);
+        pckWriteBoolP(packWrite, param.longDistance);
+        pckWriteBoolP(packWrite, param.adapt);
+        pckWriteBoolP(packWrite, param.seek);
+        pckWriteEndP(packWrite);
+
+        result = pckMove(pckWriteResult(packWrite), memContextPrior());
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(PACK, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN IoFilter *
-zstCompressNew(const int level, const bool raw)
+zstCompressNew(const int level, const ZstCompressNewParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(INT, level);
-        (void)raw;                                                  // Raw unsupported
+        (void)param.raw;                                            // Raw unsupported
+        FUNCTION_LOG_PARAM(UINT, param.thread);
+        FUNCTION_LOG_PARAM(BOOL, param.longDistance);
+        FUNCTION_LOG_PARAM(BOOL, param.adapt);
+        FUNCTION_LOG_PARAM(BOOL, param.seek);
     FUNCTION_LOG_END();
 
     ASSERT(level >= ZST_COMPRESS_LEVEL_MIN && level <= ZST_COMPRESS_LEVEL_MAX);
@@ -180,21 +401,44 @@ zstCompressNew(const int level, const bool raw)
         {
             .context = ZSTD_createCStream(),
             .level = level,
+            .thread = param.thread,
+            .longDistance = param.longDistance,
+
+            // Worker threads buffer too much input for the sample to be accurate so only adapt when single-threaded
+            .adapt = param.adapt && param.thread <= 1,
         };
 
+        // Frames are compressed independently so ranges can be decompressed using the seek table written after the last frame
+        if (param.seek)
+            this->seekTable = bufNew(0);
+
         // Set callback to ensure zst context is freed
         memContextCallbackSet(objMemContext(this), zstCompressFreeResource, this);
 
         // Initialize context
         zstError(ZSTD_initCStream(this->context, this->level));
+
+        // Enable worker threads when requested. The workers are in addition to the calling thread, which only queues input and
+        // collects output, so the number of workers is the same as the number of threads requested. The error is ignored because it
+        // only happens when zstd was built without thread support, in which case compression stays single-threaded.
+#if ZSTD_VERSION_NUMBER >= ZST_COMPRESS_VERSION_ADVANCED
+        if (this->thread > 1)
+            ZSTD_CCtx_setParameter(this->context, ZSTD_c_nbWorkers, (int)this->thread);
+
+        // Enable long distance matching when requested. This increases the window to 128MiB so repeated data far apart in large
+        // files can be matched. The window is within the default decompression limit so no special handling is required to
+        // decompress.
+        if (this->longDistance)
+            zstError(ZSTD_CCtx_setParameter(this->context, ZSTD_c_enableLongDistanceMatching, 1));
+#endif
     }
     OBJ_NEW_END();
 
     FUNCTION_LOG_RETURN(
         IO_FILTER,
         ioFilterNewP(
-            ZST_COMPRESS_FILTER_TYPE, this, compressParamList(level, raw), .done = zstCompressDone, .inOut = zstCompressProcess,
-            .inputSame = zstCompressInputSame));
+            ZST_COMPRESS_FILTER_TYPE, this, zstCompressParamList(level, param),
+            .done = zstCompressDone, .inOut = zstCompressProcess, .inputSame = zstCompressInputSame));
 }
 
 #endif // HAVE_LIBZST
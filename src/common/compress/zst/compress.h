@@ -24,7 +24,26 @@ Level constants
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
-FN_EXTERN IoFilter *zstCompressNew(int level, bool raw);
+typedef struct ZstCompressNewParam
+{
+    VAR_PARAM_HEADER;
+    bool raw;                                                       // Raw is not supported but is accepted for consistency
+    unsigned int thread;                                            // Worker threads (0 or 1 to compress in the calling thread)
+    bool longDistance;                                              // Use long distance matching
+    bool adapt;                                                     // Use minimum level when data is incompressible
+    bool seek;                                                      // Write independent frames and a seek table
+} ZstCompressNewParam;
+
+#define zstCompressNewP(level, ...)                                                                                                \
+    zstCompressNew(level, (ZstCompressNewParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+FN_EXTERN IoFilter *zstCompressNew(int level, ZstCompressNewParam param);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Error when worker threads or long distance matching are requested but not supported by the libzstd version
+FN_EXTERN void zstCompressParamCheck(unsigned int thread, bool longDistance);
 
 #endif
 
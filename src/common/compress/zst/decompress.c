@@ -104,8 +104,9 @@ zstDecompressProcess(THIS_VOID, const Buffer *const compressed, Buffer *const de
         // If the input buffer was not entirely consumed then set inputSame and store the offset where processing will restart
         if (in.pos < in.size)
         {
-            // Output buffer should be completely full
-            ASSERT(out.pos == out.size);
+            // Output buffer should be completely full unless a frame ended. zstd returns at the end of each frame and files may
+            // contain more than one frame, e.g. when adaptive compression starts a new frame at a lower level.
+            ASSERT(out.pos == out.size || this->frameDone);
 
             this->inputSame = true;
             this->inputOffset += in.pos;
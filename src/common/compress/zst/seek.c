@@ -0,0 +1,282 @@
+/***********************************************************************************************************************************
+ZST Seek Table
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#ifdef HAVE_LIBZST
+
+#include "common/compress/zst/seek.h"
+#include "common/debug.h"
+#include "common/log.h"
+#include "common/type/list.h"
+
+/***********************************************************************************************************************************
+Format constants
+***********************************************************************************************************************************/
+#define ZST_SEEK_SKIPPABLE_MAGIC                                    0x184D2A5E
+#define ZST_SEEK_MAGIC                                              0x8F92EAB1
+#define ZST_SEEK_HEADER_SIZE                                        8
+#define ZST_SEEK_ENTRY_SIZE                                         8
+#define ZST_SEEK_ENTRY_CHECKSUM_SIZE                                4
+
+// Descriptor flags in the footer
+#define ZST_SEEK_DESCRIPTOR_CHECKSUM                                0x80
+#define ZST_SEEK_DESCRIPTOR_RESERVED                                0x7C
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+// Start of a frame. A final entry marks the end of the last frame so the size of every frame can be calculated.
+typedef struct ZstSeekFrame
+{
+    uint64_t compressedOffset;                                      // Offset of the frame in the compressed file
+    uint64_t decompressedOffset;                                    // Offset of the frame in the decompressed file
+} ZstSeekFrame;
+
+struct ZstSeekTable
+{
+    List *frameList;                                                // Frames in the file
+};
+
+/***********************************************************************************************************************************
+Get and put little endian integers
+***********************************************************************************************************************************/
+static uint32_t
+zstSeekU32Get(const unsigned char *const data)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+    FUNCTION_TEST_END();
+
+    FUNCTION_TEST_RETURN(
+        UINT32, (uint32_t)data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24);
+}
+
+static void
+zstSeekU32Put(unsigned char *const data, const uint32_t value)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(UINT32, value);
+    FUNCTION_TEST_END();
+
+    data[0] = (unsigned char)value;
+    data[1] = (unsigned char)(value >> 8);
+    data[2] = (unsigned char)(value >> 16);
+    data[3] = (unsigned char)(value >> 24);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get the size of a seek table entry from the footer descriptor
+***********************************************************************************************************************************/
+static size_t
+zstSeekEntrySize(const unsigned char descriptor)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(UINT, descriptor);
+    FUNCTION_TEST_END();
+
+    if (descriptor & ZST_SEEK_DESCRIPTOR_RESERVED)
+        THROW_FMT(FormatError, "zst seek table descriptor has reserved bits set (0x%02x)", descriptor);
+
+    FUNCTION_TEST_RETURN(
+        SIZE, ZST_SEEK_ENTRY_SIZE + (descriptor & ZST_SEEK_DESCRIPTOR_CHECKSUM ? ZST_SEEK_ENTRY_CHECKSUM_SIZE : 0));
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+zstSeekTableAdd(Buffer *const table, const size_t compressedSize, const size_t decompressedSize)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, table);
+        FUNCTION_TEST_PARAM(SIZE, compressedSize);
+        FUNCTION_TEST_PARAM(SIZE, decompressedSize);
+    FUNCTION_TEST_END();
+
+    ASSERT(table != NULL);
+    ASSERT(compressedSize <= UINT32_MAX);
+    ASSERT(decompressedSize <= UINT32_MAX);
+
+    // Reserve space for the header, which is written when the table is complete
+    if (bufEmpty(table))
+        bufCat(table, BUF((const unsigned char [ZST_SEEK_HEADER_SIZE]){0}, ZST_SEEK_HEADER_SIZE));
+
+    unsigned char entry[ZST_SEEK_ENTRY_SIZE];
+
+    zstSeekU32Put(entry, (uint32_t)compressedSize);
+    zstSeekU32Put(entry + 4, (uint32_t)decompressedSize);
+    bufCat(table, BUF(entry, sizeof(entry)));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+zstSeekTableEnd(Buffer *const table)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, table);
+    FUNCTION_TEST_END();
+
+    ASSERT(table != NULL);
+    ASSERT(!bufEmpty(table));
+
+    // Footer with the number of frames, a descriptor without checksums, and the seekable magic number
+    unsigned char footer[ZST_SEEK_FOOTER_SIZE];
+
+    zstSeekU32Put(footer, (uint32_t)((bufUsed(table) - ZST_SEEK_HEADER_SIZE) / ZST_SEEK_ENTRY_SIZE));
+    footer[4] = 0;
+    zstSeekU32Put(footer + 5, ZST_SEEK_MAGIC);
+    bufCat(table, BUF(footer, sizeof(footer)));
+
+    // Header with the skippable frame magic number and the size of the frame not including the header
+    zstSeekU32Put(bufPtr(table), ZST_SEEK_SKIPPABLE_MAGIC);
+    zstSeekU32Put(bufPtr(table) + 4, (uint32_t)(bufUsed(table) - ZST_SEEK_HEADER_SIZE));
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN size_t
+zstSeekTableSize(const Buffer *const end)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BUFFER, end);
+    FUNCTION_TEST_END();
+
+    ASSERT(end != NULL);
+    ASSERT(bufUsed(end) >= ZST_SEEK_FOOTER_SIZE);
+
+    size_t result = 0;
+    const unsigned char *const footer = bufPtrConst(end) + bufUsed(end) - ZST_SEEK_FOOTER_SIZE;
+
+    if (zstSeekU32Get(footer + 5) == ZST_SEEK_MAGIC)
+        result = ZST_SEEK_HEADER_SIZE + zstSeekU32Get(footer) * zstSeekEntrySize(footer[4]) + ZST_SEEK_FOOTER_SIZE;
+
+    FUNCTION_TEST_RETURN(SIZE, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN ZstSeekTable *
+zstSeekTableNew(const Buffer *const end)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(BUFFER, end);
+    FUNCTION_LOG_END();
+
+    ASSERT(end != NULL);
+
+    const size_t size = zstSeekTableSize(end);
+
+    if (size == 0)
+        THROW(FormatError, "zst seek table not found");
+
+    if (size > bufUsed(end))
+        THROW_FMT(FormatError, "zst seek table requires %zu bytes but %zu provided", size, bufUsed(end));
+
+    const unsigned char *const table = bufPtrConst(end) + bufUsed(end) - size;
+
+    if (zstSeekU32Get(table) != ZST_SEEK_SKIPPABLE_MAGIC || zstSeekU32Get(table + 4) != size - ZST_SEEK_HEADER_SIZE)
+        THROW(FormatError, "zst seek table has invalid header");
+
+    OBJ_NEW_BEGIN(ZstSeekTable, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (ZstSeekTable){.frameList = lstNewP(sizeof(ZstSeekFrame))};
+
+        // Convert frame sizes to offsets
+        const unsigned char *const footer = table + size - ZST_SEEK_FOOTER_SIZE;
+        const unsigned int frameTotal = zstSeekU32Get(footer);
+        const size_t entrySize = zstSeekEntrySize(footer[4]);
+        ZstSeekFrame frame = {0};
+
+        for (unsigned int frameIdx = 0; frameIdx < frameTotal; frameIdx++)
+        {
+            const unsigned char *const entry = table + ZST_SEEK_HEADER_SIZE + frameIdx * entrySize;
+
+            lstAdd(this->frameList, &frame);
+
+            frame.compressedOffset += zstSeekU32Get(entry);
+            frame.decompressedOffset += zstSeekU32Get(entry + 4);
+        }
+
+        lstAdd(this->frameList, &frame);
+    }
+    OBJ_NEW_END();
+
+    FUNCTION_LOG_RETURN(ZST_SEEK_TABLE, this);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN uint64_t
+zstSeekTableSizeDecompressed(const ZstSeekTable *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_SEEK_TABLE, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(UINT64, ((const ZstSeekFrame *)lstGetLast(this->frameList))->decompressedOffset);
+}
+
+/***********************************************************************************************************************************
+Find the frame that contains a decompressed offset. Empty frames are skipped since the last frame starting at or before the offset
+is returned.
+***********************************************************************************************************************************/
+static unsigned int
+zstSeekTableFind(const ZstSeekTable *const this, const uint64_t offset)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_SEEK_TABLE, this);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    // Binary search the frames, excluding the final entry that marks the end of the last frame
+    unsigned int low = 0;
+    unsigned int high = lstSize(this->frameList) - 2;
+
+    while (low < high)
+    {
+        const unsigned int middle = low + (high - low + 1) / 2;
+
+        if (((const ZstSeekFrame *)lstGet(this->frameList, middle))->decompressedOffset <= offset)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+
+    FUNCTION_TEST_RETURN(UINT, low);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN ZstSeekRange
+zstSeekTableRange(const ZstSeekTable *const this, const uint64_t offset, const uint64_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(ZST_SEEK_TABLE, this);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+        FUNCTION_TEST_PARAM(UINT64, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(size > 0);
+    ASSERT(offset + size <= zstSeekTableSizeDecompressed(this));
+
+    const ZstSeekFrame *const first = lstGet(this->frameList, zstSeekTableFind(this, offset));
+    const ZstSeekFrame *const last = lstGet(this->frameList, zstSeekTableFind(this, offset + size - 1) + 1);
+
+    FUNCTION_TEST_RETURN_TYPE(
+        ZstSeekRange,
+        (ZstSeekRange)
+        {
+            .offset = first->compressedOffset,
+            .size = last->compressedOffset - first->compressedOffset,
+            .skip = offset - first->decompressedOffset,
+        });
+}
+
+#endif // HAVE_LIBZST
@@ -0,0 +1,84 @@
+/***********************************************************************************************************************************
+ZST Seek Table
+
+Seekable files are written as independent frames followed by a seek table in a skippable frame, as described by the zstd seekable
+format (https://github.com/facebook/zstd/blob/dev/contrib/seekable_format/zstd_seekable_compression_format.md). Each frame can be
+decompressed without any prior data so a range of the file can be read by decompressing only the frames that contain it.
+Decompressors that do not understand the seek table skip it, so seekable files can be read by any version.
+***********************************************************************************************************************************/
+#ifdef HAVE_LIBZST
+
+#ifndef COMMON_COMPRESS_ZST_SEEK_H
+#define COMMON_COMPRESS_ZST_SEEK_H
+
+/***********************************************************************************************************************************
+Object type
+***********************************************************************************************************************************/
+typedef struct ZstSeekTable ZstSeekTable;
+
+#include "common/type/buffer.h"
+#include "common/type/object.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+// Uncompressed size of each frame
+#define ZST_SEEK_FRAME_SIZE                                         (1024 * 1024)
+
+// Size of the footer at the end of the seek table
+#define ZST_SEEK_FOOTER_SIZE                                        9
+
+/***********************************************************************************************************************************
+Constructors
+***********************************************************************************************************************************/
+// Load the seek table from the end of a file. The buffer must contain at least zstSeekTableSize() bytes.
+FN_EXTERN ZstSeekTable *zstSeekTableNew(const Buffer *end);
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Add a frame to a seek table being written
+FN_EXTERN void zstSeekTableAdd(Buffer *table, size_t compressedSize, size_t decompressedSize);
+
+// Add the header and footer to a seek table so it can be written after the last frame
+FN_EXTERN void zstSeekTableEnd(Buffer *table);
+
+// Range of compressed data that must be read to decompress a range of the file
+typedef struct ZstSeekRange
+{
+    uint64_t offset;                                                // Offset of the first frame containing the range
+    uint64_t size;                                                  // Compressed size of the frames containing the range
+    uint64_t skip;                                                  // Decompressed bytes to skip before the range starts
+} ZstSeekRange;
+
+FN_EXTERN ZstSeekRange zstSeekTableRange(const ZstSeekTable *this, uint64_t offset, uint64_t size);
+
+// Size of the seek table given at least ZST_SEEK_FOOTER_SIZE bytes from the end of a file. Zero when there is no seek table.
+FN_EXTERN size_t zstSeekTableSize(const Buffer *end);
+
+/***********************************************************************************************************************************
+Getters/Setters
+***********************************************************************************************************************************/
+// Total decompressed size of all frames
+FN_EXTERN uint64_t zstSeekTableSizeDecompressed(const ZstSeekTable *this);
+
+/***********************************************************************************************************************************
+Destructor
+***********************************************************************************************************************************/
+FN_INLINE_ALWAYS void
+zstSeekTableFree(ZstSeekTable *const this)
+{
+    objFree(this);
+}
+
+/***********************************************************************************************************************************
+Macros for function logging
+***********************************************************************************************************************************/
+#define FUNCTION_LOG_ZST_SEEK_TABLE_TYPE                                                                                           \
+    ZstSeekTable *
+#define FUNCTION_LOG_ZST_SEEK_TABLE_FORMAT(value, buffer, bufferSize)                                                              \
+    objNameToLog(value, "ZstSeekTable", buffer, bufferSize)
+
+#endif
+
+#endif // HAVE_LIBZST
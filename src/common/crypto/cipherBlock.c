@@ -23,9 +23,25 @@ Header constants and sizes
 #define CIPHER_BLOCK_MAGIC                                          "Salted__"
 #define CIPHER_BLOCK_MAGIC_SIZE                                     (sizeof(CIPHER_BLOCK_MAGIC) - 1)
 
+// Magic constant for authenticated (GCM) encrypt. The openssl command-line tool cannot read these files so a different magic is
+// used to record the cipher type in the file. This allows a mismatch with the configured cipher type to be reported clearly.
+#define CIPHER_BLOCK_MAGIC_AUTH                                     "SaltGCM_"
+
 // Total length of cipher header
 #define CIPHER_BLOCK_HEADER_SIZE                                    (CIPHER_BLOCK_MAGIC_SIZE + PKCS5_SALT_LEN)
 
+// Length of the random nonce written after the salt for GCM. The IV generated from the passphrase and the 8 byte salt is not used
+// for GCM since a repeated salt would repeat both the key and the nonce, which breaks GCM entirely. The nonce is generated
+// separately so the key and nonce are independent.
+#define CIPHER_BLOCK_NONCE_SIZE                                     12
+
+// Total length of cipher header for GCM
+#define CIPHER_BLOCK_HEADER_AUTH_SIZE                               (CIPHER_BLOCK_HEADER_SIZE + CIPHER_BLOCK_NONCE_SIZE)
+
+// Length of the authentication tag written after the data for GCM. The openssl command-line tool does not support GCM so the tag is
+// simply appended to the data rather than stored in a format the tool would recognize.
+#define CIPHER_BLOCK_TAG_SIZE                                       16
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -37,10 +53,13 @@ typedef struct CipherBlock
     bool processDone;                                               // Has any data been processed?
     const Buffer *pass;                                             // Passphrase used to generate encryption key
     size_t headerSize;                                              // Size of header read during decrypt
-    uint8_t header[CIPHER_BLOCK_HEADER_SIZE];                       // Buffer to hold partial header during decrypt
+    uint8_t header[CIPHER_BLOCK_HEADER_AUTH_SIZE];                  // Buffer to hold partial header during decrypt
     const EVP_CIPHER *cipher;                                       // Cipher object
     const EVP_MD *digest;                                           // Message digest object
     EVP_CIPHER_CTX *cipherContext;                                  // Encrypt/decrypt context
+    bool authenticate;                                              // Is a tag written/checked after the data (GCM)?
+    size_t tagSize;                                                 // Size of tag read during decrypt
+    uint8_t tag[CIPHER_BLOCK_TAG_SIZE];                             // Buffer to hold the last bytes read during decrypt
 
     Buffer *buffer;                                                 // Internal buffer in case destination buffer isn't large enough
     bool inputSame;                                                 // Is the same input required on next process call?
@@ -93,16 +112,42 @@ cipherBlockProcessSize(const CipherBlock *const this, const size_t sourceSize)
 
     ASSERT(this != NULL);
 
-    // Destination size is source size plus one extra block
+    // Destination size is source size plus one extra block. This is also enough room for the tag written on encrypt and the tag
+    // bytes held back on decrypt since the tag is smaller than the extra block.
     size_t destinationSize = sourceSize + EVP_MAX_BLOCK_LENGTH;
 
     // On encrypt the header size must be included before the first block
     if (this->mode == cipherModeEncrypt && !this->saltDone)
-        destinationSize += CIPHER_BLOCK_MAGIC_SIZE + PKCS5_SALT_LEN;
+        destinationSize += this->authenticate ? CIPHER_BLOCK_HEADER_AUTH_SIZE : CIPHER_BLOCK_HEADER_SIZE;
 
     FUNCTION_LOG_RETURN(SIZE, destinationSize);
 }
 
+/***********************************************************************************************************************************
+Encrypt/decrypt bytes with the cipher context
+***********************************************************************************************************************************/
+static size_t
+cipherBlockUpdate(CipherBlock *const this, const uint8_t *const source, const size_t sourceSize, uint8_t *const destination)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(CIPHER_BLOCK, this);
+        FUNCTION_LOG_PARAM_P(BYTEDATA, source);
+        FUNCTION_LOG_PARAM(SIZE, sourceSize);
+        FUNCTION_LOG_PARAM_P(BYTEDATA, destination);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(source != NULL);
+    ASSERT(destination != NULL);
+
+    int destinationSize = 0;
+
+    cryptoError(
+        !EVP_CipherUpdate(this->cipherContext, destination, &destinationSize, source, (int)sourceSize), "unable to process cipher");
+
+    FUNCTION_LOG_RETURN(SIZE, (size_t)destinationSize);
+}
+
 /***********************************************************************************************************************************
 Encrypt/decrypt data
 ***********************************************************************************************************************************/
@@ -127,6 +172,7 @@ cipherBlockProcessBlock(CipherBlock *const this, const uint8_t *source, size_t s
     if (!this->saltDone)
     {
         const uint8_t *salt = NULL;
+        const uint8_t *nonce = NULL;
 
         // On encrypt the salt is generated
         if (this->mode == cipherModeEncrypt)
@@ -134,7 +180,7 @@ cipherBlockProcessBlock(CipherBlock *const this, const uint8_t *source, size_t s
             // Add magic to the destination buffer so openssl knows the file is salted
             if (!this->raw)
             {
-                memcpy(destination, CIPHER_BLOCK_MAGIC, CIPHER_BLOCK_MAGIC_SIZE);
+                memcpy(destination, this->authenticate ? CIPHER_BLOCK_MAGIC_AUTH : CIPHER_BLOCK_MAGIC, CIPHER_BLOCK_MAGIC_SIZE);
                 destination += CIPHER_BLOCK_MAGIC_SIZE;
                 destinationSize += CIPHER_BLOCK_MAGIC_SIZE;
             }
@@ -144,12 +190,22 @@ cipherBlockProcessBlock(CipherBlock *const this, const uint8_t *source, size_t s
             salt = destination;
             destination += PKCS5_SALT_LEN;
             destinationSize += PKCS5_SALT_LEN;
+
+            // Add nonce to the destination buffer for GCM
+            if (this->authenticate)
+            {
+                cryptoRandomBytes(destination, CIPHER_BLOCK_NONCE_SIZE);
+                nonce = destination;
+                destination += CIPHER_BLOCK_NONCE_SIZE;
+                destinationSize += CIPHER_BLOCK_NONCE_SIZE;
+            }
         }
         // On decrypt the salt is read from the header
         else if (sourceSize > 0)
         {
             // Check if the entire header has been read
-            const size_t headerExpected = this->raw ? PKCS5_SALT_LEN : CIPHER_BLOCK_HEADER_SIZE;
+            const size_t headerExpected =
+                (this->raw ? 0 : CIPHER_BLOCK_MAGIC_SIZE) + PKCS5_SALT_LEN + (this->authenticate ? CIPHER_BLOCK_NONCE_SIZE : 0);
 
             if (this->headerSize + sourceSize >= headerExpected)
             {
@@ -157,14 +213,33 @@ cipherBlockProcessBlock(CipherBlock *const this, const uint8_t *source, size_t s
                 memcpy(this->header + this->headerSize, source, headerExpected - this->headerSize);
                 salt = this->header + (this->raw ? 0 : CIPHER_BLOCK_MAGIC_SIZE);
 
+                if (this->authenticate)
+                    nonce = salt + PKCS5_SALT_LEN;
+
                 // Advance source and source size by the number of bytes read
                 source += headerExpected - this->headerSize;
                 sourceSize -= headerExpected - this->headerSize;
 
-                // The first bytes of the file to decrypt should be equal to the magic. If not then this is not an encrypted file,
-                // or at least not in a format we recognize.
-                if (!this->raw && memcmp(this->header, CIPHER_BLOCK_MAGIC, CIPHER_BLOCK_MAGIC_SIZE) != 0)
-                    THROW(CryptoError, "cipher header invalid");
+                // The first bytes of the file to decrypt should be equal to the magic. If the magic is for the other cipher type
+                // then the file was encrypted with a different cipher type than the one requested. Otherwise this is not an
+                // encrypted file, or at least not in a format we recognize.
+                if (!this->raw)
+                {
+                    const char *const magic = this->authenticate ? CIPHER_BLOCK_MAGIC_AUTH : CIPHER_BLOCK_MAGIC;
+                    const char *const magicOther = this->authenticate ? CIPHER_BLOCK_MAGIC : CIPHER_BLOCK_MAGIC_AUTH;
+
+                    if (memcmp(this->header, magicOther, CIPHER_BLOCK_MAGIC_SIZE) == 0)
+                    {
+                        THROW_FMT(
+                            CryptoError,
+                            "cipher header is for %s but %s was requested\n"
+                            "HINT: has repo-cipher-type changed since the stanza was created?",
+                            this->authenticate ? "aes-256-cbc" : "aes-256-gcm", this->authenticate ? "aes-256-gcm" : "aes-256-cbc");
+                    }
+
+                    if (memcmp(this->header, magic, CIPHER_BLOCK_MAGIC_SIZE) != 0)
+                        THROW(CryptoError, "cipher header invalid");
+                }
             }
             // Else copy what was provided into the header buffer and return 0
             else
@@ -180,12 +255,15 @@ cipherBlockProcessBlock(CipherBlock *const this, const uint8_t *source, size_t s
         // If salt generation/read is done
         if (salt)
         {
-            // Generate key and initialization vector
+            // Generate key and initialization vector. For GCM the nonce from the header is used as the initialization vector.
             uint8_t key[EVP_MAX_KEY_LENGTH];
             uint8_t initVector[EVP_MAX_IV_LENGTH];
 
             EVP_BytesToKey(this->cipher, this->digest, salt, bufPtrConst(this->pass), (int)bufSize(this->pass), 1, key, initVector);
 
+            if (nonce != NULL)
+                memcpy(initVector, nonce, CIPHER_BLOCK_NONCE_SIZE);
+
             // Create context to track cipher
             cryptoError(!(this->cipherContext = EVP_CIPHER_CTX_new()), "unable to create context");
 
@@ -204,14 +282,34 @@ cipherBlockProcessBlock(CipherBlock *const this, const uint8_t *source, size_t s
     // Recheck that source size > 0 as the bytes may have been consumed reading the header
     if (sourceSize > 0)
     {
-        // Process the data
-        int destinationUpdateSize = 0;
-
-        cryptoError(
-            !EVP_CipherUpdate(this->cipherContext, destination, &destinationUpdateSize, source, (int)sourceSize),
-            "unable to process cipher");
+        // On authenticated decrypt the last bytes are the tag so they must be held back until the end of the data is reached. The
+        // tag buffer always contains the last bytes read so only the bytes that will be pushed out of it are decrypted.
+        if (this->authenticate && this->mode == cipherModeDecrypt)
+        {
+            if (this->tagSize + sourceSize > CIPHER_BLOCK_TAG_SIZE)
+            {
+                // Decrypt bytes pushed out of the tag buffer
+                const size_t processSize = this->tagSize + sourceSize - CIPHER_BLOCK_TAG_SIZE;
+                const size_t tagProcessSize = processSize < this->tagSize ? processSize : this->tagSize;
+
+                destinationSize += cipherBlockUpdate(this, this->tag, tagProcessSize, destination);
+                memmove(this->tag, this->tag + tagProcessSize, this->tagSize - tagProcessSize);
+                this->tagSize -= tagProcessSize;
+
+                // Decrypt source bytes that will not fit in the tag buffer
+                destinationSize += cipherBlockUpdate(
+                    this, source, processSize - tagProcessSize, destination + destinationSize);
+                source += processSize - tagProcessSize;
+                sourceSize -= processSize - tagProcessSize;
+            }
 
-        destinationSize += (size_t)destinationUpdateSize;
+            // Copy remaining bytes into the tag buffer
+            memcpy(this->tag + this->tagSize, source, sourceSize);
+            this->tagSize += sourceSize;
+        }
+        // Else process the data
+        else
+            destinationSize += cipherBlockUpdate(this, source, sourceSize, destination);
 
         // Note that data has been processed so flush is valid
         this->processDone = true;
@@ -242,9 +340,36 @@ cipherBlockFlush(CipherBlock *const this, Buffer *const destination)
     if (!this->saltDone)
         THROW(CryptoError, "cipher header missing");
 
+    // On authenticated decrypt set the tag read from the end of the data so it will be checked by the flush
+    if (this->authenticate && this->mode == cipherModeDecrypt)
+    {
+        if (this->tagSize != CIPHER_BLOCK_TAG_SIZE)
+            THROW(CryptoError, "cipher tag missing");
+
+        cryptoError(
+            !EVP_CIPHER_CTX_ctrl(this->cipherContext, EVP_CTRL_GCM_SET_TAG, CIPHER_BLOCK_TAG_SIZE, this->tag), "unable to set tag");
+    }
+
     // Only flush remaining data if some data was processed
     if (!EVP_CipherFinal(this->cipherContext, bufRemainsPtr(destination), &destinationSize))
+    {
+        // A failed flush on authenticated decrypt means the data or tag was modified
+        if (this->authenticate)
+            THROW(CryptoError, "cipher authentication failed");
+
         THROW(CryptoError, "unable to flush");
+    }
+
+    // On authenticated encrypt write the tag after the data
+    if (this->authenticate && this->mode == cipherModeEncrypt)
+    {
+        cryptoError(
+            !EVP_CIPHER_CTX_ctrl(
+                this->cipherContext, EVP_CTRL_GCM_GET_TAG, CIPHER_BLOCK_TAG_SIZE, bufRemainsPtr(destination) + destinationSize),
+            "unable to get tag");
+
+        destinationSize += CIPHER_BLOCK_TAG_SIZE;
+    }
 
     // Return actual destination size
     FUNCTION_LOG_RETURN(SIZE, (size_t)destinationSize);
@@ -429,6 +554,7 @@ cipherBlockNew(const CipherMode mode, const CipherType cipherType, const Buffer
             .raw = param.raw,
             .cipher = cipher,
             .digest = digest,
+            .authenticate = EVP_CIPHER_mode(cipher) == EVP_CIPH_GCM_MODE,
             .pass = bufDup(pass),
         };
     }
@@ -22,6 +22,7 @@ typedef enum
 {
     cipherTypeNone = STRID5("none", 0x2b9ee0),
     cipherTypeAes256Cbc = STRID5("aes-256-cbc", 0xc43dfbbcdcca10),
+    cipherTypeAes256Gcm = STRID5("aes-256-gcm", 0x3467dfbbcdcca10),
 } CipherType;
 
 /***********************************************************************************************************************************
@@ -32,6 +33,7 @@ typedef enum
     hashTypeMd5 = STRID5("md5", 0x748d0),
     hashTypeSha1 = STRID6("sha1", 0x7412131),
     hashTypeSha256 = STRID5("sha256", 0x3dde05130),
+    hashTypeXxHash = STRID5("xxhash", 0x1130a3180),
 } HashType;
 
 /***********************************************************************************************************************************
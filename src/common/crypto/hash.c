@@ -11,9 +11,11 @@ Cryptographic Hash
 
 #include "common/crypto/common.h"
 #include "common/crypto/hash.h"
+#include "common/crypto/xxhash.h"
 #include "common/debug.h"
 #include "common/io/filter/filter.h"
 #include "common/log.h"
+#include "common/type/list.h"
 #include "common/type/object.h"
 #include "common/type/pack.h"
 
@@ -26,12 +28,32 @@ BUFFER_EXTERN(
 BUFFER_EXTERN(
     HASH_TYPE_SHA256_ZERO_BUF, 0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24, 0x27,
     0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55);
+BUFFER_EXTERN(
+    HASH_TYPE_XXHASH_ZERO_BUF, 0x99, 0xaa, 0x06, 0xd3, 0x01, 0x47, 0x98, 0xd8, 0x60, 0x01, 0xc3, 0x24, 0x46, 0x8d, 0x49, 0x7f);
 
 /***********************************************************************************************************************************
 Include local MD5 code
 ***********************************************************************************************************************************/
 #include "common/crypto/md5.vendor.c.inc"
 
+/***********************************************************************************************************************************
+Initialized hash contexts by hash type. Looking up the digest and initializing a context is expensive compared to hashing a small file
+(the digest must be fetched from the provider on every initialization in OpenSSL 3), so an initialized context is kept for each hash
+type and copied into each new hash.
+***********************************************************************************************************************************/
+typedef struct CryptoHashInit
+{
+    HashType type;                                                  // Hash type
+    const EVP_MD *hashType;                                         // Hash type (sha1, md5, etc.)
+    EVP_MD_CTX *hashContext;                                        // Initialized message hash context
+} CryptoHashInit;
+
+static struct
+{
+    MemContext *memContext;                                         // Mem context to store data in this struct
+    List *initList;                                                 // Initialized contexts by hash type
+} cryptoHashLocal;
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -40,6 +62,7 @@ typedef struct CryptoHash
     const EVP_MD *hashType;                                         // Hash type (sha1, md5, etc.)
     EVP_MD_CTX *hashContext;                                        // Message hash context
     MD5_CTX md5Context;                                             // MD5 context (used to bypass FIPS restrictions)
+    IoFilter *xxHash;                                               // xxHash filter
     Buffer *hash;                                                   // Hash in binary form
 } CryptoHash;
 
@@ -70,6 +93,67 @@ cryptoHashFreeResource(THIS_VOID)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Get the initialized context for a hash type, creating it on first use
+***********************************************************************************************************************************/
+static const CryptoHashInit *
+cryptoHashInit(const HashType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_ID, type);
+    FUNCTION_TEST_END();
+
+    // Create the list on first use
+    if (cryptoHashLocal.initList == NULL)
+    {
+        MEM_CONTEXT_BEGIN(memContextTop())
+        {
+            MEM_CONTEXT_NEW_BEGIN(CryptoHashLocal, .childQty = MEM_CONTEXT_QTY_MAX)
+            {
+                cryptoHashLocal.memContext = MEM_CONTEXT_NEW();
+                cryptoHashLocal.initList = lstNewP(sizeof(CryptoHashInit));
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+        MEM_CONTEXT_END();
+    }
+
+    // Find the hash type. There are only a few hash types so a linear search is fine.
+    CryptoHashInit *result = NULL;
+
+    for (unsigned int initIdx = 0; initIdx < lstSize(cryptoHashLocal.initList); initIdx++)
+    {
+        CryptoHashInit *const init = lstGet(cryptoHashLocal.initList, initIdx);
+
+        if (init->type == type)
+        {
+            result = init;
+            break;
+        }
+    }
+
+    // Lookup digest and initialize a context if the hash type was not found
+    if (result == NULL)
+    {
+        char typeZ[STRID_MAX + 1];
+        strIdToZ(type, typeZ);
+
+        const EVP_MD *const hashType = EVP_get_digestbyname(typeZ);
+
+        if (hashType == NULL)
+            THROW_FMT(AssertError, "unable to load hash '%s'", typeZ);
+
+        // The context is never freed since it is needed for the life of the process
+        EVP_MD_CTX *const hashContext = EVP_MD_CTX_create();
+        cryptoError(hashContext == NULL, "unable to create hash context");
+        cryptoError(!EVP_DigestInit_ex(hashContext, hashType, NULL), "unable to initialize hash context");
+
+        result = lstAdd(cryptoHashLocal.initList, &(CryptoHashInit){.type = type, .hashType = hashType, .hashContext = hashContext});
+    }
+
+    FUNCTION_TEST_RETURN_TYPE_CONST_P(CryptoHashInit, result);
+}
+
 /***********************************************************************************************************************************
 Add message data to the hash from a Buffer
 ***********************************************************************************************************************************/
@@ -92,6 +176,9 @@ cryptoHashProcess(THIS_VOID, const Buffer *const message)
     {
         cryptoError(!EVP_DigestUpdate(this->hashContext, bufPtrConst(message), bufUsed(message)), "unable to process message hash");
     }
+    // Else xxHash implementation
+    else if (this->xxHash != NULL)
+        ioFilterProcessIn(this->xxHash, message);
     // Else local MD5 implementation
     else
         MD5_Update(&this->md5Context, bufPtrConst(message), bufUsed(message));
@@ -121,6 +208,9 @@ cryptoHash(CryptoHash *const this)
                 this->hash = bufNew((size_t)EVP_MD_size(this->hashType));
                 cryptoError(!EVP_DigestFinal_ex(this->hashContext, bufPtr(this->hash), NULL), "unable to finalize message hash");
             }
+            // Else xxHash implementation
+            else if (this->xxHash != NULL)
+                this->hash = pckReadBinP(pckReadNew(ioFilterResult(this->xxHash)));
             // Else local MD5 implementation
             else
             {
@@ -190,15 +280,17 @@ cryptoHashNew(const HashType type)
         {
             MD5_Init(&this->md5Context);
         }
+        // Else use xxHash with the largest hash size
+        else if (type == hashTypeXxHash)
+        {
+            this->xxHash = xxHashNew(HASH_TYPE_XXHASH_SIZE);
+        }
         // Else use the standard OpenSSL implementation
         else
         {
-            // Lookup digest
-            char typeZ[STRID_MAX + 1];
-            strIdToZ(type, typeZ);
-
-            if ((this->hashType = EVP_get_digestbyname(typeZ)) == NULL)
-                THROW_FMT(AssertError, "unable to load hash '%s'", typeZ);
+            // Get initialized context for the hash type
+            const CryptoHashInit *const init = cryptoHashInit(type);
+            this->hashType = init->hashType;
 
             // Create context
             cryptoError((this->hashContext = EVP_MD_CTX_create()) == NULL, "unable to create hash context");
@@ -206,8 +298,8 @@ cryptoHashNew(const HashType type)
             // Set free callback to ensure hash context is freed
             memContextCallbackSet(objMemContext(this), cryptoHashFreeResource, this);
 
-            // Initialize context
-            cryptoError(!EVP_DigestInit_ex(this->hashContext, this->hashType, NULL), "unable to initialize hash context");
+            // Initialize context by copying the initialized context
+            cryptoError(!EVP_MD_CTX_copy_ex(this->hashContext, init->hashContext), "unable to initialize hash context");
         }
     }
     OBJ_NEW_END();
@@ -315,3 +407,67 @@ cryptoHmacOne(const HashType type, const Buffer *const key, const Buffer *const
 
     FUNCTION_LOG_RETURN(BUFFER, result);
 }
+
+/**********************************************************************************************************************************/
+FN_EXTERN size_t
+cryptoHashSize(const HashType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_ID, type);
+    FUNCTION_TEST_END();
+
+    size_t result;
+
+    switch (type)
+    {
+        case hashTypeMd5:
+            result = HASH_TYPE_M5_SIZE;
+            break;
+
+        case hashTypeSha1:
+            result = HASH_TYPE_SHA1_SIZE;
+            break;
+
+        case hashTypeSha256:
+            result = HASH_TYPE_SHA256_SIZE;
+            break;
+
+        default:
+            ASSERT(type == hashTypeXxHash);
+
+            result = HASH_TYPE_XXHASH_SIZE;
+            break;
+    }
+
+    FUNCTION_TEST_RETURN(SIZE, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN const Buffer *
+cryptoHashZero(const HashType type)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_ID, type);
+    FUNCTION_TEST_END();
+
+    const Buffer *result;
+
+    switch (type)
+    {
+        case hashTypeSha1:
+            result = HASH_TYPE_SHA1_ZERO_BUF;
+            break;
+
+        case hashTypeSha256:
+            result = HASH_TYPE_SHA256_ZERO_BUF;
+            break;
+
+        default:
+            ASSERT(type == hashTypeXxHash);
+
+            result = HASH_TYPE_XXHASH_ZERO_BUF;
+            break;
+    }
+
+    FUNCTION_TEST_RETURN_CONST(BUFFER, result);
+}
@@ -2,6 +2,9 @@
 Cryptographic Hash
 
 Generate a hash (sha1, md5, etc.) from a string, Buffer, or using an IoFilter.
+
+The xxhash type is a 128-bit non-cryptographic hash (see xxhash.h) that is much faster than sha1. It is suitable for detecting
+changes and corruption but not for security purposes.
 ***********************************************************************************************************************************/
 #ifndef COMMON_CRYPTO_HASH_H
 #define COMMON_CRYPTO_HASH_H
@@ -24,6 +27,8 @@ BUFFER_DECLARE(HASH_TYPE_SHA1_ZERO_BUF);
 #define HASH_TYPE_SHA256_ZERO                                                                                                      \
     "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"
 BUFFER_DECLARE(HASH_TYPE_SHA256_ZERO_BUF);
+#define HASH_TYPE_XXHASH_ZERO                                       "99aa06d3014798d86001c324468d497f"
+BUFFER_DECLARE(HASH_TYPE_XXHASH_ZERO_BUF);
 
 /***********************************************************************************************************************************
 Hash type sizes
@@ -37,6 +42,9 @@ Hash type sizes
 #define HASH_TYPE_SHA256_SIZE                                       32
 #define HASH_TYPE_SHA256_SIZE_HEX                                   (HASH_TYPE_SHA256_SIZE * 2)
 
+#define HASH_TYPE_XXHASH_SIZE                                       16
+#define HASH_TYPE_XXHASH_SIZE_HEX                                   (HASH_TYPE_XXHASH_SIZE * 2)
+
 /***********************************************************************************************************************************
 Constructors
 ***********************************************************************************************************************************/
@@ -52,4 +60,10 @@ FN_EXTERN Buffer *cryptoHashOne(HashType type, const Buffer *message);
 // Get hmac for one message/key
 FN_EXTERN Buffer *cryptoHmacOne(HashType type, const Buffer *key, const Buffer *message);
 
+// Size of the hash in bytes
+FN_EXTERN size_t cryptoHashSize(HashType type);
+
+// Hash of zero-length input (md5 is not supported)
+FN_EXTERN const Buffer *cryptoHashZero(HashType type);
+
 #endif
@@ -60,14 +60,18 @@ typedef struct Error
 } Error;
 
 static struct
+{
+    // Handler list
+    const ErrorHandlerFunction *list;
+    unsigned int total;
+} errorHandler;
+
+// Error context is local to each thread so errors can be thrown and caught independently by each thread
+static VR_THREAD_LOCAL struct
 {
     // Array of jump buffers
     jmp_buf jumpList[ERROR_TRY_MAX];
 
-    // Handler list
-    const ErrorHandlerFunction *handlerList;
-    unsigned int handlerTotal;
-
     // State of each try
     int tryTotal;
 
@@ -94,9 +98,9 @@ The temp buffer is required because the error message being passed might be the
 #define ERROR_MESSAGE_BUFFER_SIZE                                   8192
 #endif
 
-static char messageBuffer[ERROR_MESSAGE_BUFFER_SIZE];
-static char messageBufferTemp[ERROR_MESSAGE_BUFFER_SIZE];
-static char stackTraceBuffer[ERROR_MESSAGE_BUFFER_SIZE];
+static VR_THREAD_LOCAL char messageBuffer[ERROR_MESSAGE_BUFFER_SIZE];
+static VR_THREAD_LOCAL char messageBufferTemp[ERROR_MESSAGE_BUFFER_SIZE];
+static VR_THREAD_LOCAL char stackTraceBuffer[ERROR_MESSAGE_BUFFER_SIZE];
 
 /**********************************************************************************************************************************/
 FN_EXTERN void
@@ -104,8 +108,8 @@ errorHandlerSet(const ErrorHandlerFunction *const list, const unsigned int total
 {
     assert(total == 0 || list != NULL);
 
-    errorContext.handlerList = list;
-    errorContext.handlerTotal = total;
+    errorHandler.list = list;
+    errorHandler.total = total;
 }
 
 /**********************************************************************************************************************************/
@@ -309,8 +313,8 @@ errorInternalCatch(const ErrorType *const errorTypeCatch, const bool fatalCatch)
     // If just entering error state clean up the stack
     if (errorInternalState() == errorStateTry)
     {
-        for (unsigned int handlerIdx = 0; handlerIdx < errorContext.handlerTotal; handlerIdx++)
-            errorContext.handlerList[handlerIdx](errorTryDepth(), fatalCatch);
+        for (unsigned int handlerIdx = 0; handlerIdx < errorHandler.total; handlerIdx++)
+            errorHandler.list[handlerIdx](errorTryDepth(), fatalCatch);
 
         errorContext.tryList[errorContext.tryTotal].state++;
     }
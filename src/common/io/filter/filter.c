@@ -74,8 +74,19 @@ ioFilterProcessIn(IoFilter *const this, const Buffer *const input)
     if (input == NULL)
         this->flushing = true;
     else
+    {
+        const bool stat = ioFilterStatEnabled();
+        IoFilterStatTimer timer = {0};
+
+        if (stat)
+            ioFilterStatBegin(&timer);
+
         this->pub.interface.in(this->pub.driver, input);
 
+        if (stat)
+            ioFilterStatEnd(&this->pub.stat, &timer, bufUsed(input), 0);
+    }
+
     FUNCTION_TEST_RETURN_VOID();
 }
 
@@ -99,8 +110,25 @@ ioFilterProcessInOut(IoFilter *const this, const Buffer *const input, Buffer *co
         this->flushing = true;
 
     if (!ioFilterDone(this))
+    {
+        const bool stat = ioFilterStatEnabled();
+        const size_t outputUsed = bufUsed(output);
+        IoFilterStatTimer timer = {0};
+
+        if (stat)
+            ioFilterStatBegin(&timer);
+
         this->pub.interface.inOut(this->pub.driver, input, output);
 
+        // Input is counted once it has been consumed so it is not counted again when the filter needs the same input
+        if (stat)
+        {
+            ioFilterStatEnd(
+                &this->pub.stat, &timer, input != NULL && !ioFilterInputSame(this) ? bufUsed(input) : 0,
+                bufUsed(output) - outputUsed);
+        }
+    }
+
     // If input same is requested then there must be some output otherwise there is no point in requesting the same input
     CHECK(AssertError, !ioFilterInputSame(this) || !bufEmpty(output), "expected input to be consumed or some output");
 
@@ -18,6 +18,7 @@ Each filter has a type that allows it to be identified in the filter list.
 #ifndef COMMON_IO_FILTER_FILTER_INTERN_H
 #define COMMON_IO_FILTER_FILTER_INTERN_H
 
+#include "common/io/filter/stat.h"
 #include "common/type/buffer.h"
 #include "common/type/pack.h"
 #include "common/type/stringId.h"
@@ -65,6 +66,7 @@ typedef struct IoFilterPub
     IoFilterInterface interface;                                    // Filter interface
     void *driver;                                                   // Filter driver
     const Pack *paramList;                                          // Filter parameters
+    IoFilterStat stat;                                              // Processing stats (when collection is enabled)
 } IoFilterPub;
 
 // Is the filter done?
@@ -102,6 +104,13 @@ ioFilterParamList(const IoFilter *const this)
     return THIS_PUB(IoFilter)->paramList;
 }
 
+// Processing stats
+FN_INLINE_ALWAYS const IoFilterStat *
+ioFilterProcessStat(const IoFilter *const this)
+{
+    return &THIS_PUB(IoFilter)->stat;
+}
+
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
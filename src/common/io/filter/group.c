@@ -3,6 +3,7 @@ IO Filter Group
 ***********************************************************************************************************************************/
 #include "build.auto.h"
 
+#include <pthread.h>
 #include <stdio.h>
 
 #include "common/debug.h"
@@ -41,6 +42,51 @@ typedef struct IoFilterResult
     Pack *result;                                                   // Filter result
 } IoFilterResult;
 
+/***********************************************************************************************************************************
+Pipeline
+
+When pipelined, each filter except the last runs on its own thread. Filters are connected by queues of buffers so a filter can
+process the next buffer while the filters after it are still processing prior buffers. The last filter runs on the calling thread
+and writes directly to the output buffer passed to ioFilterGroupProcess().
+
+Each queue has exactly one writer and one reader. The mutex protects the queue indexes but the buffers themselves are only accessed
+by the thread that currently owns them, so filters are processed without holding the mutex.
+***********************************************************************************************************************************/
+#define IO_FILTER_GROUP_QUEUE_SIZE                                  3
+
+typedef struct IoFilterGroupQueue
+{
+    Buffer *bufferList[IO_FILTER_GROUP_QUEUE_SIZE];                 // Buffers owned by the queue
+    unsigned int bufferIdx;                                         // Index of the first buffer with data
+    unsigned int bufferTotal;                                       // Total buffers with data (including the buffer being read)
+    bool flush;                                                     // No more data will be written
+} IoFilterGroupQueue;
+
+typedef struct IoFilterGroupPipeline IoFilterGroupPipeline;
+
+typedef struct IoFilterGroupStage
+{
+    IoFilterGroupPipeline *pipeline;                                // Pipeline that contains the stage
+    IoFilter *filter;                                               // Filter run by the stage
+    IoFilterGroupQueue *input;                                      // Queue to read input from
+    IoFilterGroupQueue *output;                                     // Queue to write output to
+    pthread_t thread;                                               // Thread running the stage
+    const ErrorType *errorType;                                     // Error type if the stage failed
+    String *errorMessage;                                           // Error message if the stage failed
+} IoFilterGroupStage;
+
+struct IoFilterGroupPipeline
+{
+    pthread_mutex_t mutex;                                          // Protects queues and abort
+    pthread_cond_t cond;                                            // Broadcast when a queue or abort changes
+    IoFilterGroupQueue *queueList;                                  // Input queue for each filter
+    IoFilterGroupStage *stageList;                                  // Stages for all filters except the last
+    unsigned int stageTotal;                                        // Total stages
+    unsigned int threadTotal;                                       // Total threads running
+    bool abort;                                                     // Stop all stages (set on error or free)
+    size_t inputOffset;                                             // Input already queued when the same input is passed again
+};
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -49,6 +95,8 @@ struct IoFilterGroup
     IoFilterGroupPub pub;                                           // Publicly accessible variables
     const Buffer *input;                                            // Input buffer passed in for processing
     List *filterResult;                                             // Filter results (if any)
+    bool pipelined;                                                 // Run filters on separate threads?
+    IoFilterGroupPipeline *pipeline;                                // Pipeline state when running filters on separate threads
 
 #ifdef DEBUG
     bool flushing;                                                  // Is output being flushed?
@@ -61,7 +109,7 @@ ioFilterGroupNew(void)
 {
     FUNCTION_LOG_VOID(logLevelTrace);
 
-    OBJ_NEW_BEGIN(IoFilterGroup, .childQty = MEM_CONTEXT_QTY_MAX)
+    OBJ_NEW_BEGIN(IoFilterGroup, .childQty = MEM_CONTEXT_QTY_MAX, .allocQty = MEM_CONTEXT_QTY_MAX, .callbackQty = 1)
     {
         *this = (IoFilterGroup)
         {
@@ -160,6 +208,507 @@ ioFilterGroupClear(IoFilterGroup *const this)
     FUNCTION_LOG_RETURN(IO_FILTER_GROUP, this);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN IoFilterGroup *
+ioFilterGroupPipelineSet(IoFilterGroup *const this, const bool pipelined)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
+        FUNCTION_LOG_PARAM(BOOL, pipelined);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(!this->pub.opened);
+
+    this->pipelined = pipelined;
+
+    FUNCTION_LOG_RETURN(IO_FILTER_GROUP, this);
+}
+
+/***********************************************************************************************************************************
+Wait for a buffer to read from a queue. Returns false if the pipeline was aborted. On success *buffer points to the queue slot
+containing data, or is NULL when the queue has been flushed and all data has been read.
+***********************************************************************************************************************************/
+static bool
+ioFilterGroupQueueReadBegin(IoFilterGroupPipeline *const pipeline, IoFilterGroupQueue *const queue, Buffer ***const buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, pipeline);
+        FUNCTION_TEST_PARAM_P(VOID, queue);
+        FUNCTION_TEST_PARAM_P(VOID, buffer);
+    FUNCTION_TEST_END();
+
+    pthread_mutex_lock(&pipeline->mutex);
+
+    while (!pipeline->abort && queue->bufferTotal == 0 && !queue->flush)
+        pthread_cond_wait(&pipeline->cond, &pipeline->mutex);
+
+    const bool result = !pipeline->abort;
+    *buffer = queue->bufferTotal > 0 ? &queue->bufferList[queue->bufferIdx] : NULL;
+
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+Release the buffer returned by ioFilterGroupQueueReadBegin() so it can be written again
+***********************************************************************************************************************************/
+static void
+ioFilterGroupQueueReadEnd(IoFilterGroupPipeline *const pipeline, IoFilterGroupQueue *const queue)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, pipeline);
+        FUNCTION_TEST_PARAM_P(VOID, queue);
+    FUNCTION_TEST_END();
+
+    pthread_mutex_lock(&pipeline->mutex);
+
+    ASSERT(queue->bufferTotal > 0);
+
+    queue->bufferIdx = (queue->bufferIdx + 1) % IO_FILTER_GROUP_QUEUE_SIZE;
+    queue->bufferTotal--;
+
+    pthread_cond_broadcast(&pipeline->cond);
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Wait for a free buffer to write to a queue. Returns false if the pipeline was aborted. On success *buffer points to the queue slot
+containing an empty buffer.
+***********************************************************************************************************************************/
+static bool
+ioFilterGroupQueueWriteBegin(IoFilterGroupPipeline *const pipeline, IoFilterGroupQueue *const queue, Buffer ***const buffer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, pipeline);
+        FUNCTION_TEST_PARAM_P(VOID, queue);
+        FUNCTION_TEST_PARAM_P(VOID, buffer);
+    FUNCTION_TEST_END();
+
+    pthread_mutex_lock(&pipeline->mutex);
+
+    while (!pipeline->abort && queue->bufferTotal == IO_FILTER_GROUP_QUEUE_SIZE)
+        pthread_cond_wait(&pipeline->cond, &pipeline->mutex);
+
+    const bool result = !pipeline->abort;
+    *buffer = &queue->bufferList[(queue->bufferIdx + queue->bufferTotal) % IO_FILTER_GROUP_QUEUE_SIZE];
+
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    bufUsedZero(**buffer);
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/***********************************************************************************************************************************
+Add the buffer returned by ioFilterGroupQueueWriteBegin() to the queue (if it contains data) and/or flush the queue
+***********************************************************************************************************************************/
+static void
+ioFilterGroupQueueWriteEnd(
+    IoFilterGroupPipeline *const pipeline, IoFilterGroupQueue *const queue, const Buffer *const buffer, const bool flush)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, pipeline);
+        FUNCTION_TEST_PARAM_P(VOID, queue);
+        FUNCTION_TEST_PARAM(BUFFER, buffer);
+        FUNCTION_TEST_PARAM(BOOL, flush);
+    FUNCTION_TEST_END();
+
+    pthread_mutex_lock(&pipeline->mutex);
+
+    if (buffer != NULL && !bufEmpty(buffer))
+        queue->bufferTotal++;
+
+    if (flush)
+        queue->flush = true;
+
+    pthread_cond_broadcast(&pipeline->cond);
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Run a filter that produces output. Output is only passed to the next stage when the output buffer is full or the filter is done so
+downstream filters get full buffers, the same as when processing serially.
+***********************************************************************************************************************************/
+static void
+ioFilterGroupStageInOut(IoFilterGroupStage *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    Buffer **input = NULL;
+    Buffer **output = NULL;
+    bool abort = false;
+
+    do
+    {
+        abort = !ioFilterGroupQueueReadBegin(this->pipeline, this->input, &input);
+
+        while (!abort)
+        {
+            // Get an empty output buffer if there is not one already
+            if (output == NULL && !ioFilterGroupQueueWriteBegin(this->pipeline, this->output, &output))
+            {
+                abort = true;
+                break;
+            }
+
+            ioFilterProcessInOut(this->filter, input == NULL ? NULL : *input, *output);
+
+            // Pass output to the next stage when the buffer is full or the filter is done
+            const bool done = ioFilterDone(this->filter);
+
+            if (bufFull(*output) || done)
+            {
+                ioFilterGroupQueueWriteEnd(this->pipeline, this->output, *output, done);
+                output = NULL;
+            }
+
+            // Stop when the input has been consumed or the filter is done flushing
+            if (input != NULL ? !ioFilterInputSame(this->filter) : done)
+                break;
+        }
+
+        if (!abort && input != NULL)
+            ioFilterGroupQueueReadEnd(this->pipeline, this->input);
+    }
+    while (!abort && input != NULL);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Run a filter that does not produce output. The input buffer is passed to the next stage by swapping it with an empty buffer from
+the output queue so no data is copied.
+***********************************************************************************************************************************/
+static void
+ioFilterGroupStageIn(IoFilterGroupStage *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    Buffer **input = NULL;
+
+    do
+    {
+        if (!ioFilterGroupQueueReadBegin(this->pipeline, this->input, &input))
+            break;
+
+        ioFilterProcessIn(this->filter, input == NULL ? NULL : *input);
+
+        // Flush the output queue when there is no more input
+        if (input == NULL)
+        {
+            ioFilterGroupQueueWriteEnd(this->pipeline, this->output, NULL, true);
+        }
+        // Else pass the input on to the next stage
+        else
+        {
+            Buffer **output = NULL;
+
+            if (!ioFilterGroupQueueWriteBegin(this->pipeline, this->output, &output))
+                break;
+
+            Buffer *const swap = *output;
+            *output = *input;
+            *input = swap;
+
+            ioFilterGroupQueueWriteEnd(this->pipeline, this->output, *output, false);
+            ioFilterGroupQueueReadEnd(this->pipeline, this->input);
+        }
+    }
+    while (input != NULL);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Stage thread. Errors are stored in the stage and the pipeline is aborted so the calling thread can rethrow the error.
+***********************************************************************************************************************************/
+static void *
+ioFilterGroupStageThread(void *const param)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, param);
+    FUNCTION_TEST_END();
+
+    IoFilterGroupStage *const this = param;
+
+    // Allocate in the filter mem context since it is not used by any other thread while the stage is running
+    MEM_CONTEXT_OBJ_BEGIN(this->filter)
+    {
+        TRY_BEGIN()
+        {
+            if (ioFilterOutput(this->filter))
+                ioFilterGroupStageInOut(this);
+            else
+                ioFilterGroupStageIn(this);
+        }
+        CATCH_FATAL()
+        {
+            this->errorType = errorType();
+            this->errorMessage = strNewZ(errorMessage());
+
+            pthread_mutex_lock(&this->pipeline->mutex);
+            this->pipeline->abort = true;
+            pthread_cond_broadcast(&this->pipeline->cond);
+            pthread_mutex_unlock(&this->pipeline->mutex);
+        }
+        TRY_END();
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    FUNCTION_TEST_RETURN_P(VOID, NULL);
+}
+
+/***********************************************************************************************************************************
+Stop all stage threads
+***********************************************************************************************************************************/
+static void
+ioFilterGroupPipelineStop(IoFilterGroupPipeline *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, this);
+    FUNCTION_TEST_END();
+
+    pthread_mutex_lock(&this->mutex);
+    this->abort = true;
+    pthread_cond_broadcast(&this->cond);
+    pthread_mutex_unlock(&this->mutex);
+
+    for (; this->threadTotal > 0; this->threadTotal--)
+        pthread_join(this->stageList[this->threadTotal - 1].thread, NULL);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Free pipeline threads
+***********************************************************************************************************************************/
+static void
+ioFilterGroupFreeResource(THIS_VOID)
+{
+    THIS(IoFilterGroup);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    ioFilterGroupPipelineStop(this->pipeline);
+
+    pthread_cond_destroy(&this->pipeline->cond);
+    pthread_mutex_destroy(&this->pipeline->mutex);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Create queues and start a thread for each filter except the last
+***********************************************************************************************************************************/
+static void
+ioFilterGroupPipelineOpen(IoFilterGroup *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(ioFilterGroupSize(this) > 1);
+
+    MEM_CONTEXT_OBJ_BEGIN(this)
+    {
+        IoFilterGroupPipeline *const pipeline = memNew(sizeof(IoFilterGroupPipeline));
+        const unsigned int stageTotal = ioFilterGroupSize(this) - 1;
+
+        *pipeline = (IoFilterGroupPipeline)
+        {
+            .queueList = memNew(sizeof(IoFilterGroupQueue) * (stageTotal + 1)),
+            .stageList = memNew(sizeof(IoFilterGroupStage) * stageTotal),
+            .stageTotal = stageTotal,
+        };
+
+        for (unsigned int queueIdx = 0; queueIdx <= stageTotal; queueIdx++)
+        {
+            pipeline->queueList[queueIdx] = (IoFilterGroupQueue){0};
+
+            for (unsigned int bufferIdx = 0; bufferIdx < IO_FILTER_GROUP_QUEUE_SIZE; bufferIdx++)
+                pipeline->queueList[queueIdx].bufferList[bufferIdx] = bufNew(ioBufferSize());
+        }
+
+        for (unsigned int stageIdx = 0; stageIdx < stageTotal; stageIdx++)
+        {
+            pipeline->stageList[stageIdx] = (IoFilterGroupStage)
+            {
+                .pipeline = pipeline,
+                .filter = ioFilterGroupGet(this, stageIdx)->filter,
+                .input = &pipeline->queueList[stageIdx],
+                .output = &pipeline->queueList[stageIdx + 1],
+            };
+        }
+
+        this->pipeline = pipeline;
+    }
+    MEM_CONTEXT_OBJ_END();
+
+    // Initialize the mutex and condition. The static initializers are not used since they are only valid for statically allocated
+    // objects.
+    errno = pthread_mutex_init(&this->pipeline->mutex, NULL);
+    THROW_ON_SYS_ERROR(errno != 0, KernelError, "unable to initialize filter mutex");
+
+    errno = pthread_cond_init(&this->pipeline->cond, NULL);
+    THROW_ON_SYS_ERROR(errno != 0, KernelError, "unable to initialize filter condition");
+
+    // Stop threads and destroy the mutex and condition when the filter group is freed
+    memContextCallbackSet(objMemContext(this), ioFilterGroupFreeResource, this);
+
+    // Start threads
+    for (unsigned int stageIdx = 0; stageIdx < this->pipeline->stageTotal; stageIdx++)
+    {
+        IoFilterGroupStage *const stage = &this->pipeline->stageList[stageIdx];
+
+        errno = pthread_create(&stage->thread, NULL, ioFilterGroupStageThread, stage);
+        THROW_ON_SYS_ERROR(errno != 0, KernelError, "unable to create filter thread");
+
+        this->pipeline->threadTotal++;
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Check if input can be queued or output is available. The pipeline mutex must be held by the caller.
+***********************************************************************************************************************************/
+static bool
+ioFilterGroupPipelineReady(
+    const IoFilterGroupPipeline *const pipeline, const Buffer *const input, bool *const inputReady, bool *const outputReady)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, pipeline);
+        FUNCTION_TEST_PARAM(BUFFER, input);
+        FUNCTION_TEST_PARAM_P(VOID, inputReady);
+        FUNCTION_TEST_PARAM_P(VOID, outputReady);
+    FUNCTION_TEST_END();
+
+    const IoFilterGroupQueue *const queueIn = &pipeline->queueList[0];
+    const IoFilterGroupQueue *const queueOut = &pipeline->queueList[pipeline->stageTotal];
+
+    *inputReady = input != NULL ? queueIn->bufferTotal < IO_FILTER_GROUP_QUEUE_SIZE : !queueIn->flush;
+    *outputReady = queueOut->bufferTotal > 0 || queueOut->flush;
+
+    FUNCTION_TEST_RETURN(BOOL, pipeline->abort || *inputReady || *outputReady);
+}
+
+/***********************************************************************************************************************************
+Process filters in a pipeline. The calling thread adds input to the first queue and runs the last filter on output from the last
+queue. Input is copied so the caller is free to reuse the input buffer once inputSame is false, the same as serial processing.
+***********************************************************************************************************************************/
+static void
+ioFilterGroupPipelineProcess(IoFilterGroup *const this, const Buffer *const input, Buffer *const output)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(output != NULL);
+
+    IoFilterGroupPipeline *const pipeline = this->pipeline;
+    IoFilterGroupQueue *const queueIn = &pipeline->queueList[0];
+    IoFilterGroupQueue *const queueOut = &pipeline->queueList[pipeline->stageTotal];
+    IoFilter *const filterLast = ioFilterGroupGet(this, pipeline->stageTotal)->filter;
+    bool inputDone = false;
+
+    do
+    {
+        // Wait until input can be queued or output is available
+        pthread_mutex_lock(&pipeline->mutex);
+
+        bool inputReady;
+        bool outputReady;
+
+        while (!ioFilterGroupPipelineReady(pipeline, input, &inputReady, &outputReady))
+            pthread_cond_wait(&pipeline->cond, &pipeline->mutex);
+
+        const bool abort = pipeline->abort;
+        Buffer *const bufferOut = queueOut->bufferTotal > 0 ? queueOut->bufferList[queueOut->bufferIdx] : NULL;
+
+        pthread_mutex_unlock(&pipeline->mutex);
+
+        // If a stage failed then stop the pipeline and rethrow the error
+        if (abort)
+        {
+            ioFilterGroupPipelineStop(pipeline);
+
+            // Abort is only set by a stage that failed so an error will always be found
+            unsigned int stageIdx = 0;
+
+            while (pipeline->stageList[stageIdx].errorType == NULL)
+                stageIdx++;
+
+            THROWP(pipeline->stageList[stageIdx].errorType, strZ(pipeline->stageList[stageIdx].errorMessage));
+        }
+
+        // Queue as much input as will fit in a buffer
+        if (inputReady)
+        {
+            if (input != NULL)
+            {
+                Buffer **buffer = NULL;
+                ioFilterGroupQueueWriteBegin(pipeline, queueIn, &buffer);
+
+                size_t size = bufUsed(input) - pipeline->inputOffset;
+
+                if (size > bufSize(*buffer))
+                    size = bufSize(*buffer);
+
+                bufCatSub(*buffer, input, pipeline->inputOffset, size);
+                pipeline->inputOffset += size;
+
+                ioFilterGroupQueueWriteEnd(pipeline, queueIn, *buffer, false);
+
+                // When all input has been queued the caller can provide new input
+                if (pipeline->inputOffset == bufUsed(input))
+                {
+                    pipeline->inputOffset = 0;
+                    inputDone = true;
+                }
+            }
+            else
+                ioFilterGroupQueueWriteEnd(pipeline, queueIn, NULL, true);
+        }
+
+        // Process output with the last filter
+        if (outputReady)
+        {
+            ioFilterProcessInOut(filterLast, bufferOut, output);
+
+            if (bufferOut != NULL && !ioFilterInputSame(filterLast))
+                ioFilterGroupQueueReadEnd(pipeline, queueOut);
+        }
+    }
+    while (!inputDone && !bufFull(output) && !ioFilterDone(filterLast));
+
+    this->pub.inputSame = input != NULL && !inputDone;
+    this->pub.done = ioFilterDone(filterLast);
+
+    // Stages are complete once the last filter is done
+    if (this->pub.done)
+        ioFilterGroupPipelineStop(pipeline);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Setup the filter group and allocate any required buffers
 ***********************************************************************************************************************************/
@@ -181,41 +730,53 @@ ioFilterGroupOpen(IoFilterGroup *const this)
         {
             ioFilterGroupAdd(this, ioBufferNew());
         }
+    }
+    MEM_CONTEXT_OBJ_END();
 
-        // Create filter input/output buffers. Input filters do not get an output buffer since they don't produce output.
-        Buffer **lastOutputBuffer = NULL;
-
-        for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
+    // Start a pipeline when requested and there is more than one filter
+    if (this->pipelined && ioFilterGroupSize(this) > 1)
+    {
+        ioFilterGroupPipelineOpen(this);
+    }
+    // Else create filter input/output buffers. Input filters do not get an output buffer since they don't produce output.
+    else
+    {
+        MEM_CONTEXT_OBJ_BEGIN(this)
         {
-            IoFilterData *const filterData = ioFilterGroupGet(this, filterIdx);
+            Buffer **lastOutputBuffer = NULL;
 
-            // If there is no last output buffer yet, then use the input buffer that will be provided by the caller
-            if (lastOutputBuffer == NULL)
-            {
-                filterData->input = &this->input;
-            }
-            // Else assign the last output buffer to the input
-            else
+            for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
             {
-                // This cast is required because the compiler can't guarantee the const-ness of this object, i.e. it could be
-                // modified in other parts of the code. This is actually expected and the only reason we need this const is to match
-                // the const-ness of the input buffer provided by the caller.
-                filterData->input = (const Buffer *const *)lastOutputBuffer;
-                filterData->inputLocal = *lastOutputBuffer;
-            }
+                IoFilterData *const filterData = ioFilterGroupGet(this, filterIdx);
+
+                // If there is no last output buffer yet, then use the input buffer that will be provided by the caller
+                if (lastOutputBuffer == NULL)
+                {
+                    filterData->input = &this->input;
+                }
+                // Else assign the last output buffer to the input
+                else
+                {
+                    // This cast is required because the compiler can't guarantee the const-ness of this object, i.e. it could
+                    // be modified in other parts of the code. This is actually expected and the only reason we need this const is
+                    // to match the const-ness of the input buffer provided by the caller.
+                    filterData->input = (const Buffer *const *)lastOutputBuffer;
+                    filterData->inputLocal = *lastOutputBuffer;
+                }
 
-            // If this is not the last output filter then create a new output buffer for it. The output buffer for the last filter
-            // will be provided to the process function.
-            ASSERT(ioFilterGroupSize(this) != 0);
+                // If this is not the last output filter then create a new output buffer for it. The output buffer for the last
+                // filter will be provided to the process function.
+                ASSERT(ioFilterGroupSize(this) != 0);
 
-            if (ioFilterOutput(filterData->filter) && filterIdx < ioFilterGroupSize(this) - 1)
-            {
-                filterData->output = bufNew(ioBufferSize());
-                lastOutputBuffer = &filterData->output;
+                if (ioFilterOutput(filterData->filter) && filterIdx < ioFilterGroupSize(this) - 1)
+                {
+                    filterData->output = bufNew(ioBufferSize());
+                    lastOutputBuffer = &filterData->output;
+                }
             }
         }
+        MEM_CONTEXT_OBJ_END();
     }
-    MEM_CONTEXT_OBJ_END();
 
     // Filter group is open
 #ifdef DEBUG
@@ -225,9 +786,11 @@ ioFilterGroupOpen(IoFilterGroup *const this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
-/**********************************************************************************************************************************/
-FN_EXTERN void
-ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffer *const output)
+/***********************************************************************************************************************************
+Process filters serially on the calling thread
+***********************************************************************************************************************************/
+static void
+ioFilterGroupSerialProcess(IoFilterGroup *const this, const Buffer *const input, Buffer *const output)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
@@ -236,17 +799,7 @@ ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffe
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
-    ASSERT(this->pub.opened && !this->pub.closed);
-    ASSERT(input == NULL || !bufEmpty(input));
-    ASSERT(!this->flushing || input == NULL);
     ASSERT(output != NULL);
-    ASSERT(bufRemains(output) > 0);
-
-    // Once input goes to NULL then flushing has started
-#ifdef DEBUG
-    if (input == NULL)
-        this->flushing = true;
-#endif
 
     // Assign input and output buffers
     this->input = input;
@@ -351,6 +904,39 @@ ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffe
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioFilterGroupProcess(IoFilterGroup *const this, const Buffer *const input, Buffer *const output)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(IO_FILTER_GROUP, this);
+        FUNCTION_LOG_PARAM(BUFFER, input);
+        FUNCTION_LOG_PARAM(BUFFER, output);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->pub.opened && !this->pub.closed);
+    ASSERT(input == NULL || !bufEmpty(input));
+    ASSERT(!this->flushing || input == NULL);
+    ASSERT(output != NULL);
+    ASSERT(bufRemains(output) > 0);
+
+    // Once input goes to NULL then flushing has started
+#ifdef DEBUG
+    if (input == NULL)
+        this->flushing = true;
+#endif
+
+    // Process in a pipeline when threads were started
+    if (this->pipeline != NULL)
+        ioFilterGroupPipelineProcess(this, input, output);
+    // Else process serially
+    else
+        ioFilterGroupSerialProcess(this, input, output);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 ioFilterGroupClose(IoFilterGroup *this)
@@ -362,7 +948,7 @@ ioFilterGroupClose(IoFilterGroup *this)
     ASSERT(this != NULL);
     ASSERT(this->pub.opened && !this->pub.closed);
 
-    // Gather results from the filters
+    // Gather results and stats from the filters
     for (unsigned int filterIdx = 0; filterIdx < ioFilterGroupSize(this); filterIdx++)
     {
         const IoFilter *const filter = ioFilterGroupGet(this, filterIdx)->filter;
@@ -372,6 +958,9 @@ ioFilterGroupClose(IoFilterGroup *this)
             lstAdd(this->filterResult, &(IoFilterResult){.type = ioFilterType(filter), .result = ioFilterResult(filter)});
         }
         MEM_CONTEXT_END();
+
+        if (ioFilterStatEnabled())
+            ioFilterStatAdd(ioFilterType(filter), ioFilterProcessStat(filter));
     }
 
     // Filter group is open
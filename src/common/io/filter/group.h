@@ -101,6 +101,11 @@ FN_EXTERN IoFilterGroup *ioFilterGroupInsert(IoFilterGroup *this, unsigned int l
 // Clear filters
 FN_EXTERN IoFilterGroup *ioFilterGroupClear(IoFilterGroup *this);
 
+// Run each filter except the last on its own thread, connected to the next filter by a queue of buffers. This allows CPU-intensive
+// filters (e.g. hash, compress, encrypt) to run in parallel on a single file. Results are the same as processing serially. Must be
+// set before the filter group is opened.
+FN_EXTERN IoFilterGroup *ioFilterGroupPipelineSet(IoFilterGroup *this, bool pipelined);
+
 // Open filter group
 FN_EXTERN void ioFilterGroupOpen(IoFilterGroup *this);
 
@@ -0,0 +1,258 @@
+/***********************************************************************************************************************************
+IO Filter Statistics
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <pthread.h>
+#include <time.h>
+
+#include "common/debug.h"
+#include "common/io/filter/stat.h"
+#include "common/memContext.h"
+
+/***********************************************************************************************************************************
+Local data
+
+Stats may be added by pipeline stage threads, e.g. when a filter running on a stage thread closes a nested filter group, so the
+totals are protected by a mutex. The total list is created when stats are enabled so it is never created on a stage thread.
+***********************************************************************************************************************************/
+static struct
+{
+    bool enabled;                                                   // Are stats being collected?
+    MemContext *memContext;                                         // Mem context to store data in this struct
+    List *totalList;                                                // Totals by filter type
+} ioFilterStatLocal;
+
+static pthread_mutex_t ioFilterStatMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/***********************************************************************************************************************************
+Create the total list. This must be called from the main thread.
+***********************************************************************************************************************************/
+static void
+ioFilterStatInit(void)
+{
+    FUNCTION_TEST_VOID();
+
+    if (ioFilterStatLocal.totalList == NULL)
+    {
+        MEM_CONTEXT_BEGIN(memContextTop())
+        {
+            MEM_CONTEXT_NEW_BEGIN(IoFilterStatLocal, .childQty = MEM_CONTEXT_QTY_MAX)
+            {
+                ioFilterStatLocal.memContext = MEM_CONTEXT_NEW();
+                ioFilterStatLocal.totalList = lstNewP(sizeof(IoFilterStatTotal));
+            }
+            MEM_CONTEXT_NEW_END();
+        }
+        MEM_CONTEXT_END();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+ioFilterStatEnabled(void)
+{
+    FUNCTION_TEST_VOID();
+    FUNCTION_TEST_RETURN(BOOL, ioFilterStatLocal.enabled);
+}
+
+FN_EXTERN void
+ioFilterStatEnabledSet(const bool enabled)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(BOOL, enabled);
+    FUNCTION_TEST_END();
+
+    if (enabled)
+        ioFilterStatInit();
+
+    ioFilterStatLocal.enabled = enabled;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Get time in nanoseconds from the specified clock
+***********************************************************************************************************************************/
+static uint64_t
+ioFilterStatTime(const clockid_t clock)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, clock);
+    FUNCTION_TEST_END();
+
+    struct timespec time;
+    clock_gettime(clock, &time);
+
+    FUNCTION_TEST_RETURN(UINT64, (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioFilterStatBegin(IoFilterStatTimer *const timer)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, timer);
+    FUNCTION_TEST_END();
+
+    ASSERT(timer != NULL);
+
+    // CPU time is measured for the calling thread so filters running on separate threads are timed correctly
+    timer->timeCpu = ioFilterStatTime(CLOCK_THREAD_CPUTIME_ID);
+    timer->timeWall = ioFilterStatTime(CLOCK_MONOTONIC);
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioFilterStatEnd(IoFilterStat *const stat, const IoFilterStatTimer *const timer, const uint64_t bytesIn, const uint64_t bytesOut)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, stat);
+        FUNCTION_TEST_PARAM_P(VOID, timer);
+        FUNCTION_TEST_PARAM(UINT64, bytesIn);
+        FUNCTION_TEST_PARAM(UINT64, bytesOut);
+    FUNCTION_TEST_END();
+
+    ASSERT(stat != NULL);
+    ASSERT(timer != NULL);
+
+    stat->bytesIn += bytesIn;
+    stat->bytesOut += bytesOut;
+    stat->timeCpu += ioFilterStatTime(CLOCK_THREAD_CPUTIME_ID) - timer->timeCpu;
+    stat->timeWall += ioFilterStatTime(CLOCK_MONOTONIC) - timer->timeWall;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioFilterStatAdd(const StringId type, const IoFilterStat *const stat)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING_ID, type);
+        FUNCTION_TEST_PARAM_P(VOID, stat);
+    FUNCTION_TEST_END();
+
+    ASSERT(type != 0);
+    ASSERT(stat != NULL);
+    ASSERT(ioFilterStatLocal.totalList != NULL);
+
+    // Filters that were not called have nothing to add, e.g. filters that were run on a remote
+    if (stat->timeWall != 0)
+    {
+        pthread_mutex_lock(&ioFilterStatMutex);
+
+        // Find the total for the filter type. There are only a few filter types so a linear search is fine.
+        IoFilterStatTotal *total = NULL;
+
+        for (unsigned int totalIdx = 0; totalIdx < lstSize(ioFilterStatLocal.totalList); totalIdx++)
+        {
+            IoFilterStatTotal *const totalFind = lstGet(ioFilterStatLocal.totalList, totalIdx);
+
+            if (totalFind->type == type)
+            {
+                total = totalFind;
+                break;
+            }
+        }
+
+        if (total == NULL)
+            total = lstAdd(ioFilterStatLocal.totalList, &(IoFilterStatTotal){.type = type});
+
+        // Add stats to the total
+        total->stat.bytesIn += stat->bytesIn;
+        total->stat.bytesOut += stat->bytesOut;
+        total->stat.timeCpu += stat->timeCpu;
+        total->stat.timeWall += stat->timeWall;
+
+        pthread_mutex_unlock(&ioFilterStatMutex);
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN Pack *
+ioFilterStatPack(void)
+{
+    FUNCTION_TEST_VOID();
+
+    Pack *result = NULL;
+
+    pthread_mutex_lock(&ioFilterStatMutex);
+
+    if (ioFilterStatLocal.totalList != NULL && !lstEmpty(ioFilterStatLocal.totalList))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            PackWrite *const packWrite = pckWriteNewP();
+
+            for (unsigned int totalIdx = 0; totalIdx < lstSize(ioFilterStatLocal.totalList); totalIdx++)
+            {
+                const IoFilterStatTotal *const total = lstGet(ioFilterStatLocal.totalList, totalIdx);
+
+                pckWriteStrIdP(packWrite, total->type);
+                pckWriteU64P(packWrite, total->stat.bytesIn);
+                pckWriteU64P(packWrite, total->stat.bytesOut);
+                pckWriteU64P(packWrite, total->stat.timeCpu);
+                pckWriteU64P(packWrite, total->stat.timeWall);
+            }
+
+            pckWriteEndP(packWrite);
+
+            result = pckMove(pckWriteResult(packWrite), memContextPrior());
+        }
+        MEM_CONTEXT_TEMP_END();
+
+        lstClear(ioFilterStatLocal.totalList);
+    }
+
+    pthread_mutex_unlock(&ioFilterStatMutex);
+
+    FUNCTION_TEST_RETURN(PACK, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN void
+ioFilterStatMerge(const Pack *const statPack)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(PACK, statPack);
+    FUNCTION_TEST_END();
+
+    if (statPack != NULL)
+    {
+        ioFilterStatInit();
+
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            PackRead *const packRead = pckReadNew(statPack);
+
+            while (!pckReadNullP(packRead))
+            {
+                const StringId type = pckReadStrIdP(packRead);
+                IoFilterStat stat = {.bytesIn = pckReadU64P(packRead)};
+                stat.bytesOut = pckReadU64P(packRead);
+                stat.timeCpu = pckReadU64P(packRead);
+                stat.timeWall = pckReadU64P(packRead);
+
+                ioFilterStatAdd(type, &stat);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN const List *
+ioFilterStatTotalList(void)
+{
+    FUNCTION_TEST_VOID();
+    FUNCTION_TEST_RETURN(LIST, ioFilterStatLocal.totalList);
+}
@@ -0,0 +1,75 @@
+/***********************************************************************************************************************************
+IO Filter Statistics
+
+Collect bytes in, bytes out, CPU time, and wall time for each filter type. Collection is disabled by default since timing each call
+to a filter adds some overhead. When enabled, each filter keeps stats for the calls it processes and the filter group adds them to
+the totals for the process when it is closed.
+
+Totals are moved between processes with ioFilterStatPack() and ioFilterStatMerge() so the stats collected by locals and remotes end
+up in the process that started them. Stats are only reported per command, so they are aggregated for each process rather than for
+each job. A server packs and resets its totals with every response, so the stats sent with a job's response are the stats collected
+while processing that job, but the client merges them into its own totals rather than attaching them to the job result. This keeps
+the job result formats unchanged and works for any protocol handler.
+***********************************************************************************************************************************/
+#ifndef COMMON_IO_FILTER_STAT_H
+#define COMMON_IO_FILTER_STAT_H
+
+#include "common/type/stringId.h"
+
+/***********************************************************************************************************************************
+Filter stats
+***********************************************************************************************************************************/
+typedef struct IoFilterStat
+{
+    uint64_t bytesIn;                                               // Bytes consumed by the filter
+    uint64_t bytesOut;                                              // Bytes produced by the filter
+    uint64_t timeCpu;                                               // CPU time used by the filter in nanoseconds
+    uint64_t timeWall;                                              // Wall time used by the filter in nanoseconds
+} IoFilterStat;
+
+// Start time of a filter call
+typedef struct IoFilterStatTimer
+{
+    uint64_t timeCpu;                                               // Thread CPU time when the call started
+    uint64_t timeWall;                                              // Wall time when the call started
+} IoFilterStatTimer;
+
+// Totals for a filter type
+typedef struct IoFilterStatTotal
+{
+    StringId type;                                                  // Filter type
+    IoFilterStat stat;                                              // Stats for all filters of this type
+} IoFilterStatTotal;
+
+#include "common/type/list.h"
+#include "common/type/pack.h"
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Start timing a filter call
+FN_EXTERN void ioFilterStatBegin(IoFilterStatTimer *timer);
+
+// Stop timing a filter call and add the time and bytes to the filter stats
+FN_EXTERN void ioFilterStatEnd(IoFilterStat *stat, const IoFilterStatTimer *timer, uint64_t bytesIn, uint64_t bytesOut);
+
+// Add stats for a filter to the totals for the process
+FN_EXTERN void ioFilterStatAdd(StringId type, const IoFilterStat *stat);
+
+// Pack the totals for the process and reset them. NULL is returned when there are no totals.
+FN_EXTERN Pack *ioFilterStatPack(void);
+
+// Merge totals packed by another process
+FN_EXTERN void ioFilterStatMerge(const Pack *statPack);
+
+/***********************************************************************************************************************************
+Getters/Setters
+***********************************************************************************************************************************/
+// Are filter stats being collected?
+FN_EXTERN bool ioFilterStatEnabled(void);
+FN_EXTERN void ioFilterStatEnabledSet(bool enabled);
+
+// Totals for the process by filter type. NULL is returned when no stats have been added.
+FN_EXTERN const List *ioFilterStatTotalList(void);
+
+#endif
@@ -15,10 +15,20 @@ Statistics constants
 ***********************************************************************************************************************************/
 STRING_EXTERN(HTTP_STAT_CLIENT_STR,                                 HTTP_STAT_CLIENT);
 STRING_EXTERN(HTTP_STAT_CLOSE_STR,                                  HTTP_STAT_CLOSE);
+STRING_EXTERN(HTTP_STAT_HEDGE_STR,                                  HTTP_STAT_HEDGE);
 STRING_EXTERN(HTTP_STAT_REQUEST_STR,                                HTTP_STAT_REQUEST);
 STRING_EXTERN(HTTP_STAT_RETRY_STR,                                  HTTP_STAT_RETRY);
 STRING_EXTERN(HTTP_STAT_SESSION_STR,                                HTTP_STAT_SESSION);
 
+/***********************************************************************************************************************************
+Latency histogram constants. Bucket n counts latencies less than 2^n ms (the last bucket counts everything else) so percentiles can
+be estimated cheaply with bounded memory. Hedging is not enabled until enough samples have been collected to make the estimate
+meaningful.
+***********************************************************************************************************************************/
+#define HTTP_CLIENT_LATENCY_BUCKET_TOTAL                            24
+#define HTTP_CLIENT_HEDGE_PERCENTILE                                95
+#define HTTP_CLIENT_HEDGE_SAMPLE_MIN                                32
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -28,6 +38,10 @@ struct HttpClient
     IoClient *ioClient;                                             // Io client (e.g. TLS or socket client)
 
     List *sessionReuseList;                                         // List of HTTP sessions that can be reused
+
+    unsigned int hedgePercentile;                                   // Latency percentile used for hedging (0 disables)
+    uint64_t latencyTotal;                                          // Total samples in latency histogram
+    uint64_t latencyBucket[HTTP_CLIENT_LATENCY_BUCKET_TOTAL];       // Latency histogram
 };
 
 /**********************************************************************************************************************************/
@@ -51,6 +65,7 @@ httpClientNew(IoClient *const ioClient, const TimeMSec timeout)
             },
             .ioClient = ioClient,
             .sessionReuseList = lstNewP(sizeof(HttpSession *)),
+            .hedgePercentile = HTTP_CLIENT_HEDGE_PERCENTILE,
         };
 
         statInc(HTTP_STAT_CLIENT_STR);
@@ -110,6 +125,61 @@ httpClientReuse(HttpClient *const this, HttpSession *const session)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+httpClientLatencyAdd(HttpClient *const this, const TimeMSec latency)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_CLIENT, this);
+        FUNCTION_TEST_PARAM(TIME_MSEC, latency);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    unsigned int bucketIdx = 0;
+
+    while (bucketIdx < HTTP_CLIENT_LATENCY_BUCKET_TOTAL - 1 && latency >= ((TimeMSec)1 << bucketIdx))
+        bucketIdx++;
+
+    this->latencyBucket[bucketIdx]++;
+    this->latencyTotal++;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN TimeMSec
+httpClientHedgeThreshold(const HttpClient *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_CLIENT, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    TimeMSec result = 0;
+
+    if (this->hedgePercentile != 0 && this->latencyTotal >= HTTP_CLIENT_HEDGE_SAMPLE_MIN)
+    {
+        // Find the bucket that contains the percentile and use its upper bound as the threshold
+        const uint64_t sampleTarget = (this->latencyTotal * this->hedgePercentile + 99) / 100;
+        uint64_t sampleTotal = 0;
+        unsigned int bucketIdx = 0;
+
+        for (; bucketIdx < HTTP_CLIENT_LATENCY_BUCKET_TOTAL - 1; bucketIdx++)
+        {
+            sampleTotal += this->latencyBucket[bucketIdx];
+
+            if (sampleTotal >= sampleTarget)
+                break;
+        }
+
+        result = (TimeMSec)1 << bucketIdx;
+    }
+
+    FUNCTION_TEST_RETURN(TIME_MSEC, result);
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 httpClientToLog(const HttpClient *const this, StringStatic *const debugLog)
@@ -32,6 +32,8 @@ Statistics constants
 STRING_DECLARE(HTTP_STAT_CLIENT_STR);
 #define HTTP_STAT_CLOSE                                             "http.close"        // Closes forced by server
 STRING_DECLARE(HTTP_STAT_CLOSE_STR);
+#define HTTP_STAT_HEDGE                                             "http.hedge"        // Hedged requests sent
+STRING_DECLARE(HTTP_STAT_HEDGE_STR);
 #define HTTP_STAT_REQUEST                                           "http.request"      // Requests (i.e. calls to httpRequestNew())
 STRING_DECLARE(HTTP_STAT_REQUEST_STR);
 #define HTTP_STAT_RETRY                                             "http.retry"        // Request retries
@@ -67,6 +69,13 @@ FN_EXTERN HttpSession *httpClientOpen(HttpClient *this);
 // Request/response finished cleanly so session can be reused
 FN_EXTERN void httpClientReuse(HttpClient *this, HttpSession *session);
 
+// Add the time taken for a hedgeable request to start returning a response to the latency histogram
+FN_EXTERN void httpClientLatencyAdd(HttpClient *this, TimeMSec latency);
+
+// Time after which a request that has not started returning a response should be hedged. Zero when hedging is disabled or there
+// are not yet enough samples in the latency histogram.
+FN_EXTERN TimeMSec httpClientHedgeThreshold(const HttpClient *this);
+
 /***********************************************************************************************************************************
 Macros for function logging
 ***********************************************************************************************************************************/
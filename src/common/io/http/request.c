@@ -41,6 +41,11 @@ STRING_EXTERN(HTTP_HEADER_LAST_MODIFIED_STR,                        HTTP_HEADER_
 STRING_EXTERN(HTTP_HEADER_RANGE_STR,                                HTTP_HEADER_RANGE);
 #define HTTP_HEADER_USER_AGENT                                      "user-agent"
 
+/***********************************************************************************************************************************
+Interval in ms used to check the hedge session for a response while both sessions are outstanding
+***********************************************************************************************************************************/
+#define HTTP_REQUEST_HEDGE_POLL                                     10
+
 /***********************************************************************************************************************************
 Object type
 ***********************************************************************************************************************************/
@@ -51,6 +56,8 @@ struct HttpRequest
     const Buffer *content;                                          // HTTP content
 
     HttpSession *session;                                           // Session for async requests
+    TimeMSec timeSent;                                              // Time the request was last sent
+    bool hedge;                                                     // Can the request be hedged?
 };
 
 struct HttpRequestMulti
@@ -111,6 +118,40 @@ httpRequestFmt(
     FUNCTION_TEST_RETURN(STRING, result);
 }
 
+/***********************************************************************************************************************************
+Send the request on a session
+***********************************************************************************************************************************/
+static void
+httpRequestSend(HttpRequest *const this, HttpSession *const session)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(HTTP_REQUEST, this);
+        FUNCTION_LOG_PARAM(HTTP_SESSION, session);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(session != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Write the request as a buffer so secrets do not show up in logs
+        ioWrite(
+            httpSessionIoWrite(session),
+            BUFSTR(
+                httpRequestFmt(httpRequestVerb(this), httpRequestPath(this), httpRequestQuery(this), httpRequestHeader(this), true)));
+
+        // Write out content if any
+        if (this->content != NULL)
+            ioWrite(httpSessionIoWrite(session), this->content);
+
+        // Flush all writes
+        ioWriteFlush(httpSessionIoWrite(session));
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Process the request
 ***********************************************************************************************************************************/
@@ -155,21 +196,8 @@ httpRequestProcess(HttpRequest *const this, const bool waitForResponse, const bo
                     else
                     {
                         session = httpClientOpen(this->client);
-
-                        // Write the request as a buffer so secrets do not show up in logs
-                        ioWrite(
-                            httpSessionIoWrite(session),
-                            BUFSTR(
-                                httpRequestFmt(
-                                    httpRequestVerb(this), httpRequestPath(this), httpRequestQuery(this), httpRequestHeader(this),
-                                    true)));
-
-                        // Write out content if any
-                        if (this->content != NULL)
-                            ioWrite(httpSessionIoWrite(session), this->content);
-
-                        // Flush all writes
-                        ioWriteFlush(httpSessionIoWrite(session));
+                        httpRequestSend(this, session);
+                        this->timeSent = timeMSec();
 
                         // If not waiting for the response then move the session to the object context
                         if (!waitForResponse)
@@ -181,6 +209,10 @@ httpRequestProcess(HttpRequest *const this, const bool waitForResponse, const bo
                     {
                         result = httpResponseNew(session, httpRequestVerb(this), contentCache);
 
+                        // Add latency of hedgeable requests to the histogram used to determine when to hedge
+                        if (this->hedge)
+                            httpClientLatencyAdd(this->client, timeMSec() - this->timeSent);
+
                         // Retry when response code is 5xx. These errors generally represent a server error for a request that looks
                         // valid. There are a few errors that might be permanently fatal but they are rare and it seems best not to
                         // try and pick and choose errors in this class to retry.
@@ -261,6 +293,78 @@ httpRequestNew(HttpClient *const client, const String *const verb, const String
     FUNCTION_LOG_RETURN(HTTP_REQUEST, this);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+httpRequestHedge(HttpRequest *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(HTTP_REQUEST, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->session != NULL);
+
+    this->hedge = true;
+
+    // Hedge when the response has not started arriving before the threshold
+    const TimeMSec threshold = httpClientHedgeThreshold(this->client);
+
+    if (threshold != 0 && !httpSessionReadyRead(this->session, threshold))
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            // Send a duplicate request on another session. The original request is still healthy, so if the hedge cannot be sent
+            // then discard the hedge session and continue with the original request.
+            HttpSession *hedge = NULL;
+
+            TRY_BEGIN()
+            {
+                MEM_CONTEXT_TEMP_BEGIN()
+                {
+                    HttpSession *const session = httpClientOpen(this->client);
+                    httpRequestSend(this, session);
+
+                    hedge = httpSessionMove(session, memContextPrior());
+                }
+                MEM_CONTEXT_TEMP_END();
+            }
+            CATCH_ANY()
+            {
+                LOG_DEBUG_FMT("unable to hedge %s: %s", errorTypeName(errorType()), errorMessage());
+            }
+            TRY_END();
+
+            if (hedge != NULL)
+            {
+                statInc(HTTP_STAT_HEDGE_STR);
+
+                // Use the session that starts returning a response first. If neither responds before the timeout then continue with
+                // the original request and let it error normally.
+                Wait *const wait = waitNew(httpClientTimeout(this->client));
+
+                do
+                {
+                    if (httpSessionReadyRead(this->session, 0))
+                        break;
+
+                    if (httpSessionReadyRead(hedge, HTTP_REQUEST_HEDGE_POLL))
+                    {
+                        // Free the original session since it cannot be reused until the response has been read
+                        httpSessionFree(this->session);
+                        this->session = httpSessionMove(hedge, objMemContext(this));
+
+                        break;
+                    }
+                }
+                while (waitRemains(wait) > 0);
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN HttpResponse *
 httpRequestResponse(HttpRequest *const this, const bool contentCache)
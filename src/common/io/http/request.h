@@ -139,6 +139,11 @@ httpRequestVerb(const HttpRequest *const this)
 /***********************************************************************************************************************************
 Request Functions
 ***********************************************************************************************************************************/
+// Hedge the request. The latency of hedged requests is tracked by the client and if a response has not started arriving before the
+// threshold determined by the client then the request is sent again on another session. Whichever session starts returning a
+// response first is used and the other is closed. Only idempotent requests (e.g. GET) should be hedged.
+FN_EXTERN void httpRequestHedge(HttpRequest *this);
+
 // Wait for a response from the request
 FN_EXTERN HttpResponse *httpRequestResponse(HttpRequest *this, bool contentCache);
 
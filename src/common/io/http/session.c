@@ -4,6 +4,7 @@ HTTP Session
 #include "build.auto.h"
 
 #include "common/debug.h"
+#include "common/io/fd.h"
 #include "common/io/http/session.h"
 #include "common/io/io.h"
 #include "common/log.h"
@@ -57,6 +58,20 @@ httpSessionDone(HttpSession *const this)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+httpSessionReadyRead(HttpSession *const this, const TimeMSec timeout)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(HTTP_SESSION, this);
+        FUNCTION_TEST_PARAM(TIME_MSEC, timeout);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, ioSessionPending(this->ioSession) || fdReadyRead(ioSessionFd(this->ioSession), timeout));
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN IoRead *
 httpSessionIoRead(HttpSession *const this, const HttpSessionIoReadParam param)
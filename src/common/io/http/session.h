@@ -15,6 +15,7 @@ typedef struct HttpSession HttpSession;
 #include "common/io/read.h"
 #include "common/io/session.h"
 #include "common/io/write.h"
+#include "common/time.h"
 #include "common/type/object.h"
 
 /***********************************************************************************************************************************
@@ -38,6 +39,11 @@ FN_EXTERN void httpSessionDone(HttpSession *this);
 /***********************************************************************************************************************************
 Getters/Setters
 ***********************************************************************************************************************************/
+// Is there data ready to read before the timeout? Data buffered by the session, e.g. decrypted TLS data, is ready immediately.
+// Otherwise the file descriptor is polled, so a TLS record that does not contain response data, e.g. a session ticket, will also
+// report the session as ready.
+FN_EXTERN bool httpSessionReadyRead(HttpSession *this, TimeMSec timeout);
+
 // Read interface
 typedef struct HttpSessionIoReadParam
 {
@@ -76,6 +76,19 @@ ioSessionFd(IoSession *this)
     FUNCTION_TEST_RETURN(INT, this->pub.interface->fd == NULL ? -1 : this->pub.interface->fd(this->pub.driver));
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+ioSessionPending(IoSession *const this)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(IO_SESSION, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, this->pub.interface->pending == NULL ? false : this->pub.interface->pending(this->pub.driver));
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 ioSessionPeerNameSet(IoSession *const this, const String *const peerName)                                           // {vm_covered}
@@ -49,6 +49,9 @@ ioSessionAuthenticated(const IoSession *const this)
 // Session file descriptor, -1 if none
 FN_EXTERN int ioSessionFd(IoSession *this);
 
+// Is data already buffered by the session? Readiness of the file descriptor does not account for this data.
+FN_EXTERN bool ioSessionPending(IoSession *this);
+
 // Read interface
 typedef struct IoSessionIoReadParam
 {
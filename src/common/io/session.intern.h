@@ -27,6 +27,9 @@ typedef struct IoSessionInterface
     // IoWrite interface for the session
     IoWrite *(*ioWrite)(void *driver);
 
+    // Is data already buffered by the session so it can be read without waiting on the file descriptor?
+    bool (*pending)(void *driver);
+
     // Session role
     IoSessionRole (*role)(const void *driver);
 
@@ -324,6 +324,40 @@ tlsSessionIoWrite(THIS_VOID)
     FUNCTION_TEST_RETURN(IO_WRITE, this->write);
 }
 
+/**********************************************************************************************************************************/
+static int
+tlsSessionFd(THIS_VOID)
+{
+    THIS(TlsSession);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(TLS_SESSION, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+
+    FUNCTION_TEST_RETURN(INT, ioSessionFd(this->ioSession));
+}
+
+/***********************************************************************************************************************************
+Decrypted data that has already been read from the socket is buffered by OpenSSL, so the socket will not be ready even though data
+can be read
+***********************************************************************************************************************************/
+static bool
+tlsSessionPending(THIS_VOID)
+{
+    THIS(TlsSession);
+
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(TLS_SESSION, this);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->session != NULL);
+
+    FUNCTION_TEST_RETURN(BOOL, SSL_pending(this->session) > 0);
+}
+
 /**********************************************************************************************************************************/
 static IoSessionRole
 tlsSessionRole(const THIS_VOID)
@@ -344,8 +378,10 @@ static const IoSessionInterface tlsSessionInterface =
 {
     .type = IO_CLIENT_TLS_TYPE,
     .close = tlsSessionClose,
+    .fd = tlsSessionFd,
     .ioRead = tlsSessionIoRead,
     .ioWrite = tlsSessionIoWrite,
+    .pending = tlsSessionPending,
     .role = tlsSessionRole,
     .toLog = tlsSessionToLog,
 };
@@ -58,9 +58,9 @@ Test Asserts
     ASSERT(logLevel >= LOG_LEVEL_MIN && logLevel <= LOG_LEVEL_MAX)
 
 /***********************************************************************************************************************************
-Log buffer -- used to format log header and message
+Log buffer -- used to format log header and message (one per thread so threads do not overwrite each other)
 ***********************************************************************************************************************************/
-static char logBuffer[LOG_BUFFER_SIZE];
+static VR_THREAD_LOCAL char logBuffer[LOG_BUFFER_SIZE];
 
 /**********************************************************************************************************************************/
 #define LOG_LEVEL_TOTAL                                             (LOG_LEVEL_MAX + 1)
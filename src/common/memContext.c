@@ -217,25 +217,26 @@ typedef enum
 } MemContextStackType;
 
 /***********************************************************************************************************************************
-Mem context stack used to pop mem contexts and cleanup after an error
+Mem context stack used to pop mem contexts and cleanup after an error. The stack is local to each thread so a thread can allocate
+from contexts that no other thread is using at the same time.
 ***********************************************************************************************************************************/
 #define MEM_CONTEXT_STACK_MAX                                       128
 
-static struct MemContextStack
+static VR_THREAD_LOCAL struct MemContextStack
 {
     MemContext *memContext;
     MemContextStackType type;
     unsigned int tryDepth;
 } memContextStack[MEM_CONTEXT_STACK_MAX] = {{.memContext = (MemContext *)&contextTop}};
 
-static unsigned int memContextCurrentStackIdx = 0;
-static unsigned int memContextMaxStackIdx = 0;
+static VR_THREAD_LOCAL unsigned int memContextCurrentStackIdx = 0;
+static VR_THREAD_LOCAL unsigned int memContextMaxStackIdx = 0;
 
 /***********************************************************************************************************************************
 ***********************************************************************************************************************************/
 #ifdef DEBUG
 
-static uint64_t memContextSequence = 0;
+static VR_THREAD_LOCAL uint64_t memContextSequence = 0;
 
 FN_EXTERN void
 memContextAuditBegin(MemContextAuditState *const state)
@@ -39,7 +39,8 @@ typedef struct StackTraceData
     size_t paramSize;
 } StackTraceData;
 
-static struct StackTraceLocal
+// Stack trace data is local to each thread
+static VR_THREAD_LOCAL struct StackTraceLocal
 {
     int stackSize;                                                  // Stack size
     StackTraceData stack[STACK_TRACE_MAX];                          // Stack data
@@ -53,7 +54,7 @@ static struct StackTraceLocal
 /**********************************************************************************************************************************/
 #ifdef DEBUG
 
-static struct StackTraceTestLocal
+static VR_THREAD_LOCAL struct StackTraceTestLocal
 {
     bool testFlag;                                        // Don't log in parameter logging functions to avoid recursion
 } stackTraceTestLocal = {.testFlag = true};
@@ -101,6 +101,23 @@ statInc(const String *const key)
     FUNCTION_TEST_RETURN_VOID();
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+statAdd(const String *const key, const uint64_t total)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, key);
+        FUNCTION_TEST_PARAM(UINT64, total);
+    FUNCTION_TEST_END();
+
+    ASSERT(statLocalData.memContext != NULL);
+    ASSERT(key != NULL);
+
+    statGetOrCreate(key)->total += total;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN String *
 statToJson(void)
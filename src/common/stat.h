@@ -23,6 +23,9 @@ FN_EXTERN void statInit(void);
 // Increment stat by one
 FN_EXTERN void statInc(const String *key);
 
+// Add to stat
+FN_EXTERN void statAdd(const String *key, uint64_t total);
+
 // Output stats to JSON
 FN_EXTERN String *statToJson(void);
 
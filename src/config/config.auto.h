@@ -56,14 +56,22 @@ Option constants
 #define CFGOPT_ARCHIVE_TIMEOUT                                      "archive-timeout"
 #define CFGOPT_BACKUP_STANDBY                                       "backup-standby"
 #define CFGOPT_BETA                                                 "beta"
+#define CFGOPT_BLOCK_INCR_VERIFY                                    "block-incr-verify"
 #define CFGOPT_BUFFER_SIZE                                          "buffer-size"
+#define CFGOPT_BUNDLE_GAP                                           "bundle-gap"
 #define CFGOPT_CHECKSUM_PAGE                                        "checksum-page"
+#define CFGOPT_CHECKSUM_TYPE                                        "checksum-type"
 #define CFGOPT_CIPHER_PASS                                          "cipher-pass"
 #define CFGOPT_CMD                                                  "cmd"
 #define CFGOPT_CMD_SSH                                              "cmd-ssh"
 #define CFGOPT_COMPRESS                                             "compress"
+#define CFGOPT_COMPRESS_ADAPT                                       "compress-adapt"
 #define CFGOPT_COMPRESS_LEVEL                                       "compress-level"
 #define CFGOPT_COMPRESS_LEVEL_NETWORK                               "compress-level-network"
+#define CFGOPT_COMPRESS_LONG                                        "compress-long"
+#define CFGOPT_COMPRESS_SEEK                                        "compress-seek"
+#define CFGOPT_COMPRESS_THREAD                                      "compress-thread"
+#define CFGOPT_COMPRESS_THREAD_SIZE                                 "compress-thread-size"
 #define CFGOPT_COMPRESS_TYPE                                        "compress-type"
 #define CFGOPT_CONFIG                                               "config"
 #define CFGOPT_CONFIG_INCLUDE_PATH                                  "config-include-path"
@@ -78,12 +86,14 @@ Option constants
 #define CFGOPT_EXEC_ID                                              "exec-id"
 #define CFGOPT_EXPIRE_AUTO                                          "expire-auto"
 #define CFGOPT_FILTER                                               "filter"
+#define CFGOPT_FILTER_STAT                                          "filter-stat"
 #define CFGOPT_FORCE                                                "force"
 #define CFGOPT_HELP                                                 "help"
 #define CFGOPT_IGNORE_MISSING                                       "ignore-missing"
 #define CFGOPT_IO_TIMEOUT                                           "io-timeout"
 #define CFGOPT_JOB_RETRY                                            "job-retry"
 #define CFGOPT_JOB_RETRY_INTERVAL                                   "job-retry-interval"
+#define CFGOPT_LIMIT                                                "limit"
 #define CFGOPT_LINK_ALL                                             "link-all"
 #define CFGOPT_LINK_MAP                                             "link-map"
 #define CFGOPT_LOCK                                                 "lock"
@@ -96,11 +106,15 @@ Option constants
 #define CFGOPT_LOG_TIMESTAMP                                        "log-timestamp"
 #define CFGOPT_MANIFEST_SAVE_THRESHOLD                              "manifest-save-threshold"
 #define CFGOPT_NEUTRAL_UMASK                                        "neutral-umask"
+#define CFGOPT_OFFSET                                               "offset"
 #define CFGOPT_ONLINE                                               "online"
 #define CFGOPT_OUTPUT                                               "output"
 #define CFGOPT_PAGE_HEADER_CHECK                                    "page-header-check"
 #define CFGOPT_PG                                                   "pg"
 #define CFGOPT_PG_VERSION_FORCE                                     "pg-version-force"
+#define CFGOPT_PIPELINE                                             "pipeline"
+#define CFGOPT_PIPELINE_SIZE                                        "pipeline-size"
+#define CFGOPT_PREALLOCATE                                          "preallocate"
 #define CFGOPT_PROCESS                                              "process"
 #define CFGOPT_PROCESS_MAX                                          "process-max"
 #define CFGOPT_PROTOCOL_TIMEOUT                                     "protocol-timeout"
@@ -117,10 +131,12 @@ Option constants
 #define CFGOPT_SCK_KEEP_ALIVE                                       "sck-keep-alive"
 #define CFGOPT_SET                                                  "set"
 #define CFGOPT_SORT                                                 "sort"
+#define CFGOPT_SPARSE                                               "sparse"
 #define CFGOPT_SPOOL_PATH                                           "spool-path"
 #define CFGOPT_STANZA                                               "stanza"
 #define CFGOPT_START_FAST                                           "start-fast"
 #define CFGOPT_STOP_AUTO                                            "stop-auto"
+#define CFGOPT_STRIPE                                               "stripe"
 #define CFGOPT_TABLESPACE_MAP                                       "tablespace-map"
 #define CFGOPT_TABLESPACE_MAP_ALL                                   "tablespace-map-all"
 #define CFGOPT_TARGET                                               "target"
@@ -140,7 +156,7 @@ Option constants
 #define CFGOPT_VERBOSE                                              "verbose"
 #define CFGOPT_VERSION                                              "version"
 
-#define CFG_OPTION_TOTAL                                            187
+#define CFG_OPTION_TOTAL                                            204
 
 /***********************************************************************************************************************************
 Option value constants
@@ -157,6 +173,11 @@ Option value constants
 #define CFGOPTVAL_BACKUP_STANDBY_Y                                  STRID5("y", 0x190)
 #define CFGOPTVAL_BACKUP_STANDBY_Y_Z                                "y"
 
+#define CFGOPTVAL_CHECKSUM_TYPE_SHA1                                STRID6("sha1", 0x7412131)
+#define CFGOPTVAL_CHECKSUM_TYPE_SHA1_Z                              "sha1"
+#define CFGOPTVAL_CHECKSUM_TYPE_XXHASH                              STRID5("xxhash", 0x1130a3180)
+#define CFGOPTVAL_CHECKSUM_TYPE_XXHASH_Z                            "xxhash"
+
 #define CFGOPTVAL_COMPRESS_TYPE_BZ2                                 STRID5("bz2", 0x73420)
 #define CFGOPTVAL_COMPRESS_TYPE_BZ2_Z                               "bz2"
 #define CFGOPTVAL_COMPRESS_TYPE_GZ                                  STRID5("gz", 0x3470)
@@ -249,6 +270,8 @@ Option value constants
 
 #define CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC                      STRID5("aes-256-cbc", 0xc43dfbbcdcca10)
 #define CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_CBC_Z                    "aes-256-cbc"
+#define CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM                      STRID5("aes-256-gcm", 0x3467dfbbcdcca10)
+#define CFGOPTVAL_REPO_CIPHER_TYPE_AES_256_GCM_Z                    "aes-256-gcm"
 #define CFGOPTVAL_REPO_CIPHER_TYPE_NONE                             STRID5("none", 0x2b9ee0)
 #define CFGOPTVAL_REPO_CIPHER_TYPE_NONE_Z                           "none"
 
@@ -413,14 +436,22 @@ typedef enum
     cfgOptArchiveTimeout,
     cfgOptBackupStandby,
     cfgOptBeta,
+    cfgOptBlockIncrVerify,
     cfgOptBufferSize,
+    cfgOptBundleGap,
     cfgOptChecksumPage,
+    cfgOptChecksumType,
     cfgOptCipherPass,
     cfgOptCmd,
     cfgOptCmdSsh,
     cfgOptCompress,
+    cfgOptCompressAdapt,
     cfgOptCompressLevel,
     cfgOptCompressLevelNetwork,
+    cfgOptCompressLong,
+    cfgOptCompressSeek,
+    cfgOptCompressThread,
+    cfgOptCompressThreadSize,
     cfgOptCompressType,
     cfgOptConfig,
     cfgOptConfigIncludePath,
@@ -435,12 +466,14 @@ typedef enum
     cfgOptExecId,
     cfgOptExpireAuto,
     cfgOptFilter,
+    cfgOptFilterStat,
     cfgOptForce,
     cfgOptHelp,
     cfgOptIgnoreMissing,
     cfgOptIoTimeout,
     cfgOptJobRetry,
     cfgOptJobRetryInterval,
+    cfgOptLimit,
     cfgOptLinkAll,
     cfgOptLinkMap,
     cfgOptLock,
@@ -453,6 +486,7 @@ typedef enum
     cfgOptLogTimestamp,
     cfgOptManifestSaveThreshold,
     cfgOptNeutralUmask,
+    cfgOptOffset,
     cfgOptOnline,
     cfgOptOutput,
     cfgOptPageHeaderCheck,
@@ -476,6 +510,9 @@ typedef enum
     cfgOptPgSocketPath,
     cfgOptPgUser,
     cfgOptPgVersionForce,
+    cfgOptPipeline,
+    cfgOptPipelineSize,
+    cfgOptPreallocate,
     cfgOptProcess,
     cfgOptProcessMax,
     cfgOptProtocolTimeout,
@@ -550,6 +587,7 @@ typedef enum
     cfgOptRepoSftpPrivateKeyFile,
     cfgOptRepoSftpPrivateKeyPassphrase,
     cfgOptRepoSftpPublicKeyFile,
+    cfgOptRepoSftpWindowSize,
     cfgOptRepoStorageCaFile,
     cfgOptRepoStorageCaPath,
     cfgOptRepoStorageHost,
@@ -565,10 +603,12 @@ typedef enum
     cfgOptSckKeepAlive,
     cfgOptSet,
     cfgOptSort,
+    cfgOptSparse,
     cfgOptSpoolPath,
     cfgOptStanza,
     cfgOptStartFast,
     cfgOptStopAuto,
+    cfgOptStripe,
     cfgOptTablespaceMap,
     cfgOptTablespaceMapAll,
     cfgOptTarget,
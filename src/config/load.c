@@ -9,8 +9,10 @@ Configuration Load
 
 #include "command/command.h"
 #include "command/lock.h"
+#include "common/compress/zst/compress.h"
 #include "common/crypto/common.h"
 #include "common/debug.h"
+#include "common/io/filter/stat.h"
 #include "common/io/io.h"
 #include "common/io/socket/common.h"
 #include "common/log.h"
@@ -314,6 +316,12 @@ cfgLoadUpdateOption(void)
         cfgOptionSet(cfgOptCompress, cfgSourceDefault, NULL);
     }
 
+#ifdef HAVE_LIBZST
+    // Error on zst options that require a newer libzstd rather than silently ignoring them
+    if (cfgOptionValid(cfgOptCompressThread) && cfgOptionStrId(cfgOptCompressType) == CFGOPTVAL_COMPRESS_TYPE_ZST)
+        zstCompressParamCheck(cfgOptionUInt(cfgOptCompressThread), cfgOptionBool(cfgOptCompressLong));
+#endif
+
     // Error if repo-sftp--host-key-check-type is explicitly set to anything other than fingerprint and repo-sftp-host-fingerprint
     // is also specified. For backward compatibility we need to allow repo-sftp-host-fingerprint when
     // repo-sftp-host-key-check-type defaults to yes, but emit a warning to let the user know to change the configuration. Also
@@ -476,6 +484,10 @@ cfgLoad(const unsigned int argListSize, const char *argList[])
         if (cfgOptionValid(cfgOptIoTimeout))
             ioTimeoutMsSet(cfgOptionUInt64(cfgOptIoTimeout));
 
+        // Enable filter stats
+        if (cfgOptionValid(cfgOptFilterStat))
+            ioFilterStatEnabledSet(cfgOptionBool(cfgOptFilterStat));
+
         // Open the log file if this command logs to a file
         cfgLoadLogFile();
 
@@ -200,18 +200,20 @@ manifestFilePack(const Manifest *const manifest, const ManifestFile *const file)
     // Timestamp
     cvtUInt64ToVarInt128(cvtInt64ToZigZag(manifestPackBaseTime - file->timestamp), buffer, &bufferPos, sizeof(buffer));
 
-    // SHA1 checksum
+    // Checksum
+    const size_t checksumSize = manifestChecksumSize(manifest);
+
     if (file->checksumSha1 != NULL)
     {
-        memcpy((uint8_t *)buffer + bufferPos, file->checksumSha1, HASH_TYPE_SHA1_SIZE);
-        bufferPos += HASH_TYPE_SHA1_SIZE;
+        memcpy((uint8_t *)buffer + bufferPos, file->checksumSha1, checksumSize);
+        bufferPos += checksumSize;
     }
 
-    // SHA1 repo checksum
+    // Repo checksum
     if (file->checksumRepoSha1 != NULL)
     {
-        memcpy((uint8_t *)buffer + bufferPos, file->checksumRepoSha1, HASH_TYPE_SHA1_SIZE);
-        bufferPos += HASH_TYPE_SHA1_SIZE;
+        memcpy((uint8_t *)buffer + bufferPos, file->checksumRepoSha1, checksumSize);
+        bufferPos += checksumSize;
     }
 
     // Reference
@@ -329,18 +331,20 @@ manifestFileUnpack(const Manifest *const manifest, const ManifestFilePack *const
     // Checksum page
     result.checksumPage = (flag >> manifestFilePackFlagChecksumPage) & 1;
 
-    // SHA1 checksum
+    // Checksum
+    const size_t checksumSize = manifestChecksumSize(manifest);
+
     if (flag & (1 << manifestFilePackFlagChecksum))
     {
         result.checksumSha1 = (const uint8_t *)filePack + bufferPos;
-        bufferPos += HASH_TYPE_SHA1_SIZE;
+        bufferPos += checksumSize;
     }
 
-    // SHA1 repo checksum
+    // Repo checksum
     if (flag & (1 << manifestFilePackFlagChecksumRepo))
     {
         result.checksumRepoSha1 = (const uint8_t *)filePack + bufferPos;
-        bufferPos += HASH_TYPE_SHA1_SIZE;
+        bufferPos += checksumSize;
     }
 
     // Reference
@@ -558,6 +562,7 @@ manifestNewInternal(void)
             .pathList = lstNewP(sizeof(ManifestPath), .comparator = lstComparatorStr),
             .targetList = lstNewP(sizeof(ManifestTarget), .comparator = lstComparatorStr),
             .referenceList = strLstNew(),
+            .data.backupOptionChecksumType = hashTypeSha1,
         },
         .ownerList = strLstNew(),
     };
@@ -1081,7 +1086,7 @@ manifestBuildInfo(
             if (info->size == 0 && buildData->manifest->pub.data.bundle)
             {
                 file.copy = false;
-                file.checksumSha1 = bufPtrConst(HASH_TYPE_SHA1_ZERO_BUF);
+                file.checksumSha1 = bufPtrConst(manifestChecksumZero(buildData->manifest));
             }
 
             // Get block incremental size
@@ -1287,8 +1292,8 @@ manifestBuildInfo(
 FN_EXTERN Manifest *
 manifestNewBuild(
     const Storage *const storagePg, const unsigned int pgVersion, const unsigned int pgCatalogVersion, const time_t timestampStart,
-    const bool online, const bool checksumPage, const bool bundle, const bool blockIncr, const ManifestBlockIncrMap *blockIncrMap,
-    const StringList *const excludeList, const Pack *const tablespaceList)
+    const bool online, const bool checksumPage, const bool bundle, const bool blockIncr, const HashType checksumType,
+    const ManifestBlockIncrMap *blockIncrMap, const StringList *const excludeList, const Pack *const tablespaceList)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE, storagePg);
@@ -1299,6 +1304,7 @@ manifestNewBuild(
         FUNCTION_LOG_PARAM(BOOL, checksumPage);
         FUNCTION_LOG_PARAM(BOOL, bundle);
         FUNCTION_LOG_PARAM(BOOL, blockIncr);
+        FUNCTION_LOG_PARAM(STRING_ID, checksumType);
         FUNCTION_LOG_PARAM(VOID, blockIncrMap);
         FUNCTION_LOG_PARAM(STRING_LIST, excludeList);
         FUNCTION_LOG_PARAM(PACK, tablespaceList);
@@ -1323,6 +1329,7 @@ manifestNewBuild(
         this->pub.data.bundle = bundle;
         this->pub.data.bundleRaw = blockIncr;
         this->pub.data.blockIncr = blockIncr;
+        this->pub.data.backupOptionChecksumType = checksumType;
 
         MEM_CONTEXT_TEMP_BEGIN()
         {
@@ -1940,6 +1947,7 @@ manifestBuildComplete(
 #define MANIFEST_KEY_OPTION_BACKUP_STANDBY                          "option-backup-standby"
 #define MANIFEST_KEY_OPTION_BUFFER_SIZE                             "option-buffer-size"
 #define MANIFEST_KEY_OPTION_CHECKSUM_PAGE                           "option-checksum-page"
+#define MANIFEST_KEY_OPTION_CHECKSUM_TYPE                           "option-checksum-type"
 #define MANIFEST_KEY_OPTION_COMPRESS                                "option-compress"
 #define MANIFEST_KEY_OPTION_COMPRESS_TYPE                           "option-compress-type"
 #define MANIFEST_KEY_OPTION_COMPRESS_LEVEL                          "option-compress-level"
@@ -2129,7 +2137,7 @@ manifestLoadCallback(void *const callbackData, const String *const section, cons
 
         // If file size is zero then assign the static zero hash
         if (file.size == 0)
-            file.checksumSha1 = bufPtrConst(HASH_TYPE_SHA1_ZERO_BUF);
+            file.checksumSha1 = bufPtrConst(manifestChecksumZero(manifest));
 
         // If original is not present in the manifest file then it is the same as size (i.e. the file did not change size during
         // copy) -- to save space the original size is only stored in the manifest file if it is different than size.
@@ -2392,6 +2400,8 @@ manifestLoadCallback(void *const callbackData, const String *const section, cons
                 manifest->pub.data.backupOptionBufferSize = varNewUInt(varUIntForce(jsonToVar(value)));
             else if (strEqZ(key, MANIFEST_KEY_OPTION_CHECKSUM_PAGE))
                 manifest->pub.data.backupOptionChecksumPage = varDup(jsonToVar(value));
+            else if (strEqZ(key, MANIFEST_KEY_OPTION_CHECKSUM_TYPE))
+                manifest->pub.data.backupOptionChecksumType = (HashType)strIdFromStr(varStr(jsonToVar(value)));
             else if (strEqZ(key, MANIFEST_KEY_OPTION_COMPRESS_LEVEL))
                 manifest->pub.data.backupOptionCompressLevel = varNewUInt(varUIntForce(jsonToVar(value)));
             else if (strEqZ(key, MANIFEST_KEY_OPTION_COMPRESS_LEVEL_NETWORK))
@@ -2668,6 +2678,14 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                 jsonFromVar(manifest->pub.data.backupOptionChecksumPage));
         }
 
+        // Only save the checksum type when it is not sha1 so older versions can read manifests that use the default
+        if (manifest->pub.data.backupOptionChecksumType != hashTypeSha1)
+        {
+            infoSaveValue(
+                infoSaveData, MANIFEST_SECTION_BACKUP_OPTION, MANIFEST_KEY_OPTION_CHECKSUM_TYPE,
+                jsonFromVar(VARSTR(strIdToStr(manifest->pub.data.backupOptionChecksumType))));
+        }
+
         // Set the option when compression is turned on. In older versions this also implied gz compression but in newer versions
         // the type option must also be set if compression is not gz.
         infoSaveValue(
@@ -2818,7 +2836,7 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                 {
                     jsonWriteStr(
                         jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM),
-                        strNewEncode(encodingHex, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE)));
+                        strNewEncode(encodingHex, BUF(file.checksumSha1, manifestChecksumSize(manifest))));
                 }
 
                 if (file.checksumPage)
@@ -2841,7 +2859,7 @@ manifestSaveCallback(void *const callbackData, const String *const sectionNext,
                 {
                     jsonWriteStr(
                         jsonWriteKeyStrId(json, MANIFEST_KEY_CHECKSUM_REPO),
-                        strNewEncode(encodingHex, BUF(file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE)));
+                        strNewEncode(encodingHex, BUF(file.checksumRepoSha1, manifestChecksumSize(manifest))));
                 }
 
                 if (file.reference != NULL)
@@ -3023,11 +3041,11 @@ manifestValidate(Manifest *const this, const bool strict)
             if (strict)
             {
                 // Zero-length files must have a specific checksum
-                if (file.size == 0 && !bufEq(HASH_TYPE_SHA1_ZERO_BUF, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE)))
+                if (file.size == 0 && !bufEq(manifestChecksumZero(this), BUF(file.checksumSha1, manifestChecksumSize(this))))
                 {
                     strCatFmt(
                         error, "\ninvalid checksum '%s' for zero size file '%s'",
-                        strZ(strNewEncode(encodingHex, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE))), strZ(file.name));
+                        strZ(strNewEncode(encodingHex, BUF(file.checksumSha1, manifestChecksumSize(this)))), strZ(file.name));
                 }
 
                 // Non-zero size files must have non-zero repo size
@@ -81,6 +81,7 @@ typedef struct ManifestData
     const Variant *backupOptionStandby;                             // Will the backup be performed from a standby?
     const Variant *backupOptionBufferSize;                          // Buffer size used for file/protocol operations
     const Variant *backupOptionChecksumPage;                        // Will page checksums be verified?
+    HashType backupOptionChecksumType;                              // Hash type used for file checksums
     CompressType backupOptionCompressType;                          // Compression type used for the backup
     const Variant *backupOptionCompressLevel;                       // Level used for compression (if type not none)
     const Variant *backupOptionCompressLevelNetwork;                // Level used for network compression
@@ -143,8 +144,8 @@ typedef struct ManifestFile
     bool checksumPage : 1;                                          // Does this file have page checksums?
     bool checksumPageError : 1;                                     // Is there an error in the page checksum?
     mode_t mode;                                                    // File mode
-    const uint8_t *checksumSha1;                                    // SHA1 checksum
-    const uint8_t *checksumRepoSha1;                                // SHA1 checksum as stored in repo (including compression, etc.)
+    const uint8_t *checksumSha1;                                    // Checksum (type is backupOptionChecksumType)
+    const uint8_t *checksumRepoSha1;                                // Checksum as stored in repo (including compression, etc.)
     const String *checksumPageErrorList;                            // List of page checksum errors if there are any
     const String *user;                                             // User name
     const String *group;                                            // Group name
@@ -214,8 +215,8 @@ Constructors
 // Build a new manifest for a PostgreSQL data directory
 FN_EXTERN Manifest *manifestNewBuild(
     const Storage *storagePg, unsigned int pgVersion, unsigned int pgCatalogVersion, time_t timestampStart, bool online,
-    bool checksumPage, bool bundle, bool blockIncr, const ManifestBlockIncrMap *blockIncrMap, const StringList *excludeList,
-    const Pack *tablespaceList);
+    bool checksumPage, bool bundle, bool blockIncr, HashType checksumType, const ManifestBlockIncrMap *blockIncrMap,
+    const StringList *excludeList, const Pack *tablespaceList);
 
 // Load a manifest from IO
 FN_EXTERN Manifest *manifestNewLoad(IoRead *read);
@@ -256,6 +257,20 @@ manifestData(const Manifest *const this)
     return &(THIS_PUB(Manifest)->data);
 }
 
+// Size of file checksums in the manifest
+FN_INLINE_ALWAYS size_t
+manifestChecksumSize(const Manifest *const this)
+{
+    return cryptoHashSize(manifestData(this)->backupOptionChecksumType);
+}
+
+// Checksum of a zero-length file
+FN_INLINE_ALWAYS const Buffer *
+manifestChecksumZero(const Manifest *const this)
+{
+    return cryptoHashZero(manifestData(this)->backupOptionChecksumType);
+}
+
 // Get reference list
 FN_INLINE_ALWAYS const StringList *
 manifestReferenceList(const Manifest *const this)
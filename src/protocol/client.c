@@ -4,6 +4,7 @@ Protocol Client
 #include "build.auto.h"
 
 #include "common/debug.h"
+#include "common/io/filter/stat.h"
 #include "common/log.h"
 #include "common/time.h"
 #include "common/type/json.h"
@@ -232,6 +233,9 @@ protocolClientResponseInternal(ProtocolClientSession *const this)
             type = (ProtocolMessageType)pckReadU32P(response);
             close = pckReadBoolP(response);
             packRead = pckReadPackReadP(response);
+
+            // Merge filter stats into the totals for this process since stats are reported per command rather than per job
+            ioFilterStatMerge(pckReadPackP(response));
             pckReadEndP(response);
 
             // If this response is for another session then store it with that session. Session id 0 indicates a fatal error on the
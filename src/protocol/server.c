@@ -7,6 +7,7 @@ Protocol Server
 
 #include "common/debug.h"
 #include "common/error/retry.h"
+#include "common/io/filter/stat.h"
 #include "common/log.h"
 #include "common/time.h"
 #include "common/type/json.h"
@@ -113,6 +114,10 @@ protocolServerResponse(ProtocolServer *const this, const ProtocolServerResponseP
         pckWriteU32P(resultMessage, param.type, .defaultWrite = true);
         pckWriteBoolP(resultMessage, param.close);
         pckWritePackP(resultMessage, pckWriteResult(param.data));
+
+        // Return filter stats collected since the last response, i.e. while processing this request, so they are aggregated by the
+        // client. The totals are reset so stats are never sent twice.
+        pckWritePackP(resultMessage, ioFilterStatPack());
         pckWriteEndP(resultMessage);
         ioWriteFlush(this->write);
     }
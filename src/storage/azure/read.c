@@ -63,7 +63,7 @@ storageReadAzureOpen(THIS_VOID)
                     this->interface.version ?
                         httpQueryPut(httpQueryNewP(), AZURE_QUERY_VERSION_ID_STR, this->interface.versionId) : NULL,
                 .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
-                .allowMissing = true, .contentIo = true);
+                .allowMissing = true, .contentIo = true, .hedge = true);
         }
         MEM_CONTEXT_OBJ_END();
 
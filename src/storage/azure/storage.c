@@ -299,11 +299,16 @@ storageAzureRequest(StorageAzure *const this, const String *const verb, const St
         FUNCTION_LOG_PARAM(BUFFER, param.content);
         FUNCTION_LOG_PARAM(BOOL, param.allowMissing);
         FUNCTION_LOG_PARAM(BOOL, param.contentIo);
+        FUNCTION_LOG_PARAM(BOOL, param.hedge);
         FUNCTION_LOG_PARAM(BOOL, param.tag);
     FUNCTION_LOG_END();
 
     HttpRequest *const request = storageAzureRequestAsyncP(
         this, verb, .path = param.path, .header = param.header, .query = param.query, .content = param.content, .tag = param.tag);
+
+    if (param.hedge)
+        httpRequestHedge(request);
+
     HttpResponse *const result = storageAzureResponseP(request, .allowMissing = param.allowMissing, .contentIo = param.contentIo);
 
     httpRequestFree(request);
@@ -63,6 +63,7 @@ typedef struct StorageAzureRequestParam
     const Buffer *content;                                          // Request content
     bool allowMissing;                                              // Allow missing files (caller can check response code)
     bool contentIo;                                                 // Is IoRead interface required to read content?
+    bool hedge;                                                     // Hedge the request when the response is slow?
     bool tag;                                                       // Add tags when available?
 } StorageAzureRequestParam;
 
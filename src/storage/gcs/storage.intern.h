@@ -105,6 +105,7 @@ typedef struct StorageGcsRequestParam
     bool allowMissing;                                              // Allow missing files (caller can check response code)
     bool allowIncomplete;                                           // Allow incomplete resume (used for resumable upload)
     bool contentIo;                                                 // Is IoRead interface required to read content?
+    bool hedge;                                                     // Hedge the request when the response is slow?
 } StorageGcsRequestParam;
 
 #define storageGcsRequestP(this, verb, ...)                                                                                        \
@@ -0,0 +1,124 @@
+/***********************************************************************************************************************************
+Posix Storage Extensions
+***********************************************************************************************************************************/
+// The C library only declares these extensions when _GNU_SOURCE is defined. It must be defined before any system header is included
+// and it changes the declarations of some POSIX functions (e.g. strerror_r()), so it is limited to this module.
+#define _GNU_SOURCE
+
+#include "build.auto.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include "common/debug.h"
+#include "storage/posix/extension.h"
+
+/***********************************************************************************************************************************
+Can file syncs be deferred? The kernel release cannot change while running so this is only checked once.
+***********************************************************************************************************************************/
+#ifdef HAVE_SYNCFS
+static int storagePosixSyncDeferResult = -1;
+#endif
+
+/***********************************************************************************************************************************
+Does the kernel release report writeback errors from syncfs()? Only Linux is checked since syncfs() is Linux-specific.
+***********************************************************************************************************************************/
+static bool
+storagePosixSyncDeferRelease(const char *const sysName, const char *const release)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRINGZ, sysName);
+        FUNCTION_TEST_PARAM(STRINGZ, release);
+    FUNCTION_TEST_END();
+
+    ASSERT(sysName != NULL);
+    ASSERT(release != NULL);
+
+    bool result = false;
+
+    if (strcmp(sysName, "Linux") == 0)
+    {
+        char *minor;
+        const unsigned long major = strtoul(release, &minor, 10);
+
+        result = major > 5 || (major == 5 && *minor == '.' && strtoul(minor + 1, NULL, 10) >= 8);
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, result);
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN int
+storagePosixAllocate(const int fd, const uint64_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, fd);
+        FUNCTION_TEST_PARAM(UINT64, size);
+    FUNCTION_TEST_END();
+
+#ifdef HAVE_FALLOCATE
+    FUNCTION_TEST_RETURN(INT, fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, (off_t)size));
+#else
+    (void)fd;
+    (void)size;
+    errno = EOPNOTSUPP;
+
+    FUNCTION_TEST_RETURN(INT, -1);
+#endif
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN bool
+storagePosixSyncDefer(void)
+{
+    FUNCTION_TEST_VOID();
+
+#ifdef HAVE_SYNCFS
+    if (storagePosixSyncDeferResult == -1)
+    {
+        // If uname() fails the names will be empty and syncs will not be deferred
+        struct utsname name = {.sysname = {0}, .release = {0}};
+        uname(&name);
+
+        storagePosixSyncDeferResult = storagePosixSyncDeferRelease(name.sysname, name.release);
+    }
+
+    FUNCTION_TEST_RETURN(BOOL, storagePosixSyncDeferResult);
+#else
+    FUNCTION_TEST_RETURN(BOOL, false);
+#endif
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN int
+storagePosixSyncStart(const int fd)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, fd);
+    FUNCTION_TEST_END();
+
+#ifdef HAVE_SYNCFS
+    FUNCTION_TEST_RETURN(INT, sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WRITE));
+#else
+    FUNCTION_TEST_RETURN(INT, fsync(fd));
+#endif
+}
+
+/**********************************************************************************************************************************/
+FN_EXTERN int
+storagePosixSyncFs(const int fd)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(INT, fd);
+    FUNCTION_TEST_END();
+
+#ifdef HAVE_SYNCFS
+    FUNCTION_TEST_RETURN(INT, syncfs(fd));
+#else
+    FUNCTION_TEST_RETURN(INT, fsync(fd));
+#endif
+}
@@ -0,0 +1,33 @@
+/***********************************************************************************************************************************
+Posix Storage Extensions
+
+Functions that are not part of POSIX but improve performance where they are available. Each falls back to the POSIX equivalent, or
+does nothing when there is no equivalent, when the extension is not available.
+***********************************************************************************************************************************/
+#ifndef STORAGE_POSIX_EXTENSION_H
+#define STORAGE_POSIX_EXTENSION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Allocate space for a file without changing the file size so the file is less fragmented when it is written. posix_fallocate() is
+// not used as a fallback since it writes every block when the filesystem does not support preallocation. Returns -1 and sets errno
+// to EOPNOTSUPP when preallocation is not supported, otherwise returns -1 and sets errno on error.
+FN_EXTERN int storagePosixAllocate(int fd, uint64_t size);
+
+// Can file syncs be deferred until the filesystem is synced? This requires syncfs() to report writeback errors for files that were
+// closed before it was called, which Linux does starting with 5.8. On earlier kernels an error writing back a deferred file could
+// be lost, so files must be synced with fsync() instead.
+FN_EXTERN bool storagePosixSyncDefer(void);
+
+// Start writeback of a file without waiting for it to complete. The file is not durable until the filesystem is synced. Falls back
+// to fsync(). Returns -1 and sets errno on error.
+FN_EXTERN int storagePosixSyncStart(int fd);
+
+// Sync the filesystem containing the file or path. Falls back to fsync(). Returns -1 and sets errno on error.
+FN_EXTERN int storagePosixSyncFs(int fd);
+
+#endif
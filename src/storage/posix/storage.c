@@ -16,6 +16,7 @@ Posix Storage
 #include "common/log.h"
 #include "common/regExp.h"
 #include "common/user.h"
+#include "storage/posix/extension.h"
 #include "storage/posix/read.h"
 #include "storage/posix/storage.intern.h"
 #include "storage/posix/write.h"
@@ -379,9 +380,12 @@ storagePosixNewWrite(THIS_VOID, const String *const file, const StorageInterface
         FUNCTION_LOG_PARAM(TIME, param.timeModified);
         FUNCTION_LOG_PARAM(BOOL, param.createPath);
         FUNCTION_LOG_PARAM(BOOL, param.syncFile);
+        FUNCTION_LOG_PARAM(BOOL, param.syncDefer);
         FUNCTION_LOG_PARAM(BOOL, param.syncPath);
         FUNCTION_LOG_PARAM(BOOL, param.atomic);
         FUNCTION_LOG_PARAM(BOOL, param.truncate);
+        FUNCTION_LOG_PARAM(BOOL, param.sparse);
+        FUNCTION_LOG_PARAM(UINT64, param.preallocate);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -391,7 +395,8 @@ storagePosixNewWrite(THIS_VOID, const String *const file, const StorageInterface
         STORAGE_WRITE,
         storageWritePosixNew(
             this, file, param.modeFile, param.modePath, param.user, param.group, param.timeModified, param.createPath,
-            param.syncFile, this->interface.pathSync != NULL ? param.syncPath : false, param.atomic, param.truncate));
+            param.syncFile, param.syncDefer, this->interface.pathSync != NULL ? param.syncPath : false, param.atomic,
+            param.truncate, param.sparse, param.preallocate));
 }
 
 /**********************************************************************************************************************************/
@@ -513,7 +518,7 @@ storagePosixPathSync(THIS_VOID, const String *const path, const StorageInterface
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_POSIX, this);
         FUNCTION_LOG_PARAM(STRING, path);
-        (void)param;                                                // No parameters are used
+        FUNCTION_LOG_PARAM(BOOL, param.fs);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -532,8 +537,8 @@ storagePosixPathSync(THIS_VOID, const String *const path, const StorageInterface
     }
     else
     {
-        // Attempt to sync the directory
-        if (fsync(fd) == -1)
+        // Attempt to sync the filesystem or the directory
+        if ((param.fs ? storagePosixSyncFs(fd) : fsync(fd)) == -1)
         {
             const int errNo = errno;
 
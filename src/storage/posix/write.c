@@ -5,6 +5,7 @@ Posix Storage File write
 
 #include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <utime.h>
 
@@ -13,6 +14,7 @@ Posix Storage File write
 #include "common/log.h"
 #include "common/type/object.h"
 #include "common/user.h"
+#include "storage/posix/extension.h"
 #include "storage/posix/write.h"
 #include "storage/write.h"
 
@@ -27,6 +29,7 @@ typedef struct StorageWritePosix
     const String *nameTmp;
     const String *path;
     int fd;                                                         // File descriptor
+    uint64_t offset;                                                // Offset of the next write for sparse files
 } StorageWritePosix;
 
 /***********************************************************************************************************************************
@@ -44,6 +47,12 @@ Since open is called more than once use constants to make sure these parameters
 ***********************************************************************************************************************************/
 #define FILE_OPEN_PURPOSE                                           "write"
 
+/***********************************************************************************************************************************
+Size of the blocks checked for zeroes when writing sparse files. This matches the block size of most filesystems so every block that
+is skipped becomes a hole.
+***********************************************************************************************************************************/
+#define STORAGE_POSIX_SPARSE_SIZE                                   4096
+
 /***********************************************************************************************************************************
 Close file descriptor
 ***********************************************************************************************************************************/
@@ -117,6 +126,13 @@ storageWritePosixOpen(THIS_VOID)
     // Set free callback to ensure the file descriptor is freed
     memContextCallbackSet(objMemContext(this), storageWritePosixFreeResource, this);
 
+    // Preallocate space for the file. Errors that indicate the filesystem does not support preallocation are ignored.
+    if (this->interface.preallocate != 0 && storagePosixAllocate(this->fd, this->interface.preallocate) == -1)
+    {
+        if (errno != EINVAL && errno != EOPNOTSUPP)                           // {uncovered_branch - preallocation always supported}
+            THROW_SYS_ERROR_FMT(FileWriteError, "unable to preallocate '%s'", strZ(this->nameTmp));
+    }
+
     // Update user/group owner
     if (this->interface.user != NULL || this->interface.group != NULL)
     {
@@ -154,6 +170,49 @@ storageWritePosixOpen(THIS_VOID)
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Is the block all zeroes? Comparing the block to itself offset by one byte is faster than checking each byte.
+***********************************************************************************************************************************/
+static bool
+storageWritePosixZero(const unsigned char *const block, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM_P(VOID, block);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(block != NULL);
+    ASSERT(size > 0);
+
+    FUNCTION_TEST_RETURN(BOOL, block[0] == 0 && memcmp(block, block + 1, size - 1) == 0);
+}
+
+/***********************************************************************************************************************************
+Write data at an offset in a sparse file
+***********************************************************************************************************************************/
+static void
+storageWritePosixData(StorageWritePosix *const this, const unsigned char *const data, const size_t size, const uint64_t offset)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_POSIX, this);
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(SIZE, size);
+        FUNCTION_TEST_PARAM(UINT64, offset);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(data != NULL);
+
+    if (size > 0)
+    {
+        THROW_ON_SYS_ERROR_FMT(
+            pwrite(this->fd, data, size, (off_t)offset) != (ssize_t)size, FileWriteError, "unable to write '%s'",
+            strZ(this->nameTmp));
+    }
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Write to the file
 ***********************************************************************************************************************************/
@@ -171,8 +230,35 @@ storageWritePosix(THIS_VOID, const Buffer *const buffer)
     ASSERT(buffer != NULL);
     ASSERT(this->fd != -1);
 
-    // Write the data
-    if (write(this->fd, bufPtrConst(buffer), bufUsed(buffer)) != (ssize_t)bufUsed(buffer))
+    // Write sparse data
+    if (this->interface.sparse)
+    {
+        const unsigned char *const data = bufPtrConst(buffer);
+        size_t dataIdx = 0;
+        size_t blockIdx = 0;
+
+        while (blockIdx < bufUsed(buffer))
+        {
+            // Only blocks aligned with the file can become holes so the first and last blocks may be partial
+            const size_t blockAligned = STORAGE_POSIX_SPARSE_SIZE - (size_t)((this->offset + blockIdx) % STORAGE_POSIX_SPARSE_SIZE);
+            const size_t blockSize = blockAligned < bufUsed(buffer) - blockIdx ? blockAligned : bufUsed(buffer) - blockIdx;
+
+            // Skip blocks that are all zeroes after writing any data that precedes them
+            if (blockSize == STORAGE_POSIX_SPARSE_SIZE && storageWritePosixZero(data + blockIdx, blockSize))
+            {
+                storageWritePosixData(this, data + dataIdx, blockIdx - dataIdx, this->offset + dataIdx);
+                dataIdx = blockIdx + blockSize;
+            }
+
+            blockIdx += blockSize;
+        }
+
+        // Write remaining data
+        storageWritePosixData(this, data + dataIdx, bufUsed(buffer) - dataIdx, this->offset + dataIdx);
+        this->offset += bufUsed(buffer);
+    }
+    // Else write the data
+    else if (write(this->fd, bufPtrConst(buffer), bufUsed(buffer)) != (ssize_t)bufUsed(buffer))
         THROW_SYS_ERROR_FMT(FileWriteError, "unable to write '%s'", strZ(this->nameTmp));
 
     FUNCTION_LOG_RETURN_VOID();
@@ -195,9 +281,25 @@ storageWritePosixClose(THIS_VOID)
     // Close if the file has not already been closed
     if (this->fd != -1)
     {
+        // Set the size of a sparse file since trailing holes are not written
+        if (this->interface.sparse)
+        {
+            THROW_ON_SYS_ERROR_FMT(
+                ftruncate(this->fd, (off_t)this->offset) == -1, FileWriteError, "unable to truncate '%s'", strZ(this->nameTmp));
+        }
+
         // Sync the file
         if (this->interface.syncFile)
-            THROW_ON_SYS_ERROR_FMT(fsync(this->fd) == -1, FileSyncError, STORAGE_ERROR_WRITE_SYNC, strZ(this->nameTmp));
+        {
+            // When the sync is deferred only start writeback so the file is mostly written by the time the filesystem is synced
+            if (this->interface.syncDefer && storagePosixSyncDefer())
+            {
+                THROW_ON_SYS_ERROR_FMT(
+                    storagePosixSyncStart(this->fd) == -1, FileSyncError, STORAGE_ERROR_WRITE_SYNC, strZ(this->nameTmp));
+            }
+            else
+                THROW_ON_SYS_ERROR_FMT(fsync(this->fd) == -1, FileSyncError, STORAGE_ERROR_WRITE_SYNC, strZ(this->nameTmp));
+        }
 
         // Close the file
         memContextCallbackClear(objMemContext(this));
@@ -250,8 +352,8 @@ storageWritePosixFd(const THIS_VOID)
 FN_EXTERN StorageWrite *
 storageWritePosixNew(
     StoragePosix *const storage, const String *const name, const mode_t modeFile, const mode_t modePath, const String *const user,
-    const String *const group, const time_t timeModified, const bool createPath, const bool syncFile, const bool syncPath,
-    const bool atomic, const bool truncate)
+    const String *const group, const time_t timeModified, const bool createPath, const bool syncFile, const bool syncDefer,
+    const bool syncPath, const bool atomic, const bool truncate, const bool sparse, const uint64_t preallocate)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_POSIX, storage);
@@ -263,15 +365,20 @@ storageWritePosixNew(
         FUNCTION_LOG_PARAM(TIME, timeModified);
         FUNCTION_LOG_PARAM(BOOL, createPath);
         FUNCTION_LOG_PARAM(BOOL, syncFile);
+        FUNCTION_LOG_PARAM(BOOL, syncDefer);
         FUNCTION_LOG_PARAM(BOOL, syncPath);
         FUNCTION_LOG_PARAM(BOOL, atomic);
         FUNCTION_LOG_PARAM(BOOL, truncate);
+        FUNCTION_LOG_PARAM(BOOL, sparse);
+        FUNCTION_LOG_PARAM(UINT64, preallocate);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
     ASSERT(name != NULL);
     ASSERT(modeFile != 0);
     ASSERT(modePath != 0);
+    ASSERT(!sparse || truncate);
+    ASSERT(!sparse || preallocate == 0);
 
     OBJ_NEW_BEGIN(StorageWritePosix, .childQty = MEM_CONTEXT_QTY_MAX, .callbackQty = 1)
     {
@@ -291,8 +398,11 @@ storageWritePosixNew(
                 .modeFile = modeFile,
                 .modePath = modePath,
                 .syncFile = syncFile,
+                .syncDefer = syncDefer,
                 .syncPath = syncPath,
                 .truncate = truncate,
+                .sparse = sparse,
+                .preallocate = preallocate,
                 .user = strDup(user),
                 .timeModified = timeModified,
 
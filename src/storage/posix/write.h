@@ -12,6 +12,7 @@ Constructors
 ***********************************************************************************************************************************/
 FN_EXTERN StorageWrite *storageWritePosixNew(
     StoragePosix *storage, const String *name, mode_t modeFile, mode_t modePath, const String *user, const String *group,
-    time_t timeModified, bool createPath, bool syncFile, bool syncPath, bool atomic, bool truncate);
+    time_t timeModified, bool createPath, bool syncFile, bool syncDefer, bool syncPath, bool atomic, bool truncate, bool sparse,
+    uint64_t preallocate);
 
 #endif
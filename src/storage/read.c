@@ -235,6 +235,22 @@ storageReadNew(void *const driver, StorageReadInterface *const interface)
     FUNCTION_LOG_RETURN(STORAGE_READ, this);
 }
 
+/**********************************************************************************************************************************/
+FN_EXTERN void
+storageReadPrefetch(StorageRead *const this)
+{
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+
+    if (this->pub.interface->prefetch != NULL)
+        this->pub.interface->prefetch(this->driver);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /**********************************************************************************************************************************/
 FN_EXTERN void
 storageReadToLog(const StorageRead *const this, StringStatic *const debugLog)
@@ -17,6 +17,10 @@ typedef struct StorageRead StorageRead;
 /***********************************************************************************************************************************
 Functions
 ***********************************************************************************************************************************/
+// Start the read so the latency of open can overlap with other work. The file must still be opened with ioReadOpen(). This is a
+// noop for drivers that do not support prefetch.
+FN_EXTERN void storageReadPrefetch(StorageRead *this);
+
 FN_INLINE_ALWAYS StorageRead *
 storageReadMove(StorageRead *const this, MemContext *const parentNew)
 {
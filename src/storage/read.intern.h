@@ -22,6 +22,9 @@ typedef struct StorageReadInterface
     bool version;                                                   // Read version
     const String *versionId;                                        // File version to read
     IoReadInterface ioInterface;
+
+    // Start the read before the file is opened (optional)
+    void (*prefetch)(void *driver);
 } StorageReadInterface;
 
 FN_EXTERN StorageRead *storageReadNew(void *driver, StorageReadInterface *interface);
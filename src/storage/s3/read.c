@@ -23,6 +23,7 @@ typedef struct StorageReadS3
     StorageReadInterface interface;                                 // Interface
     StorageS3 *storage;                                             // Storage that created this object
 
+    HttpRequest *httpRequest;                                       // HTTP request sent by prefetch
     HttpResponse *httpResponse;                                     // HTTP response
 } StorageReadS3;
 
@@ -34,6 +35,40 @@ Macros for function logging
 #define FUNCTION_LOG_STORAGE_READ_S3_FORMAT(value, buffer, bufferSize)                                                             \
     objNameToLog(value, "StorageReadS3", buffer, bufferSize)
 
+/***********************************************************************************************************************************
+Send the request for the file without waiting for a response
+***********************************************************************************************************************************/
+static void
+storageReadS3Prefetch(THIS_VOID)
+{
+    THIS(StorageReadS3);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM(STORAGE_READ_S3, this);
+    FUNCTION_LOG_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->httpResponse == NULL);
+
+    // Request if not already requested and not versioned or if versionId is not null
+    if (this->httpRequest == NULL && (!this->interface.version || this->interface.versionId != NULL))
+    {
+        MEM_CONTEXT_OBJ_BEGIN(this)
+        {
+            this->httpRequest = storageS3RequestAsyncP(
+                this->storage, HTTP_VERB_GET_STR, this->interface.name,
+                .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
+                .query =
+                    this->interface.versionId == NULL
+                        ? NULL : httpQueryPut(httpQueryNewP(), STRDEF("versionId"), this->interface.versionId),
+                .sseC = true);
+        }
+        MEM_CONTEXT_OBJ_END();
+    }
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Open the file
 ***********************************************************************************************************************************/
@@ -54,19 +89,23 @@ storageReadS3Open(THIS_VOID)
     // Read if not versioned or if versionId is not null
     if (!this->interface.version || this->interface.versionId != NULL)
     {
-        // Request the file
+        // Request the file unless the request was already sent by prefetch. Prefetched requests are not hedged since the time
+        // before the response is read includes time spent waiting for the caller.
+        if (this->httpRequest == NULL)
+        {
+            storageReadS3Prefetch(this);
+            httpRequestHedge(this->httpRequest);
+        }
+
         MEM_CONTEXT_OBJ_BEGIN(this)
         {
-            this->httpResponse = storageS3RequestP(
-                this->storage, HTTP_VERB_GET_STR, this->interface.name,
-                .header = httpHeaderPutRange(httpHeaderNew(NULL), this->interface.offset, this->interface.limit),
-                .query =
-                    this->interface.versionId == NULL
-                        ? NULL : httpQueryPut(httpQueryNewP(), STRDEF("versionId"), this->interface.versionId),
-                .allowMissing = true, .contentIo = true, .sseC = true);
+            this->httpResponse = storageS3ResponseP(this->httpRequest, .allowMissing = true, .contentIo = true);
         }
         MEM_CONTEXT_OBJ_END();
 
+        httpRequestFree(this->httpRequest);
+        this->httpRequest = NULL;
+
         if (httpResponseCodeOk(this->httpResponse))
         {
             result = true;
@@ -183,6 +222,8 @@ storageReadS3New(
                     .read = storageReadS3,
                     .close = storageReadS3Close,
                 },
+
+                .prefetch = storageReadS3Prefetch,
             },
         };
     }
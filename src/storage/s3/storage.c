@@ -24,6 +24,7 @@ S3 Storage
 Defaults
 ***********************************************************************************************************************************/
 #define STORAGE_S3_DELETE_MAX                                       1000
+#define STORAGE_S3_PARTITION_MAX                                    8
 
 /***********************************************************************************************************************************
 S3 HTTP headers
@@ -110,6 +111,7 @@ struct StorageS3
     size_t partSize;                                                // Part size for multi-part upload
     const String *tag;                                              // Tags to be applied to objects
     unsigned int deleteMax;                                         // Maximum objects that can be deleted in one request
+    unsigned int partitionMax;                                      // Maximum concurrent partition list requests
     StorageS3UriStyle uriStyle;                                     // Path or host style URIs
     const String *bucketEndpoint;                                   // Set to {bucket}.{endpoint}
     bool requesterPays;                                             // Requester pays?
@@ -617,6 +619,7 @@ storageS3Request(StorageS3 *const this, const String *const verb, const String *
     HttpRequest *const request = storageS3RequestAsyncP(
         this, verb, path, .header = param.header, .query = param.query, .content = param.content, .sseKms = param.sseKms,
         .sseC = param.sseC, .tag = param.tag);
+
     HttpResponse *const result = storageS3ResponseP(
         request, .allowMissing = param.allowMissing, .contentIo = param.contentIo);
 
@@ -626,29 +629,22 @@ storageS3Request(StorageS3 *const this, const String *const verb, const String *
 }
 
 /***********************************************************************************************************************************
-General function for listing files to be used by other list routines
+Build the query for the first list request of a path
 ***********************************************************************************************************************************/
-static void
-storageS3ListInternal(
-    StorageS3 *const this, const String *const path, const StorageInfoLevel level, const String *const expression,
-    const bool recurse, const time_t targetTime, StorageListCallback callback, void *const callbackData)
+static HttpQuery *
+storageS3ListQuery(const String *const path, const String *const expression, const bool recurse, const time_t targetTime)
 {
-    FUNCTION_LOG_BEGIN(logLevelDebug);
-        FUNCTION_LOG_PARAM(STORAGE_S3, this);
-        FUNCTION_LOG_PARAM(STRING, path);
-        FUNCTION_LOG_PARAM(ENUM, level);
-        FUNCTION_LOG_PARAM(STRING, expression);
-        FUNCTION_LOG_PARAM(BOOL, recurse);
-        FUNCTION_LOG_PARAM(TIME, targetTime);
-        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
-        FUNCTION_LOG_PARAM_P(VOID, callbackData);
-    FUNCTION_LOG_END();
-
-    FUNCTION_AUDIT_CALLBACK();
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STRING, path);
+        FUNCTION_TEST_PARAM(STRING, expression);
+        FUNCTION_TEST_PARAM(BOOL, recurse);
+        FUNCTION_TEST_PARAM(TIME, targetTime);
+    FUNCTION_TEST_END();
 
-    ASSERT(this != NULL);
     ASSERT(path != NULL);
 
+    HttpQuery *const result = httpQueryNewP();
+
     MEM_CONTEXT_TEMP_BEGIN()
     {
         // Build the base prefix by stripping off the initial /
@@ -670,22 +666,60 @@ storageS3ListInternal(
                 queryPrefix = strNewFmt("%s%s", strZ(basePrefix), strZ(expressionPrefix));
         }
 
-        // Create query
-        HttpQuery *const query = httpQueryNewP();
-
         // Add the delimiter to not recurse
         if (!recurse)
-            httpQueryAdd(query, S3_QUERY_DELIMITER_STR, FSLASH_STR);
+            httpQueryAdd(result, S3_QUERY_DELIMITER_STR, FSLASH_STR);
 
         // Use list type 2 or versions as specified
         if (targetTime != 0)
-            httpQueryAdd(query, S3_QUERY_VERSIONS_STR, EMPTY_STR);
+            httpQueryAdd(result, S3_QUERY_VERSIONS_STR, EMPTY_STR);
         else
-            httpQueryAdd(query, S3_QUERY_LIST_TYPE_STR, S3_QUERY_VALUE_LIST_TYPE_2_STR);
+            httpQueryAdd(result, S3_QUERY_LIST_TYPE_STR, S3_QUERY_VALUE_LIST_TYPE_2_STR);
 
         // Don't specify empty prefix because it is the default
         if (!strEmpty(queryPrefix))
-            httpQueryAdd(query, S3_QUERY_PREFIX_STR, queryPrefix);
+            httpQueryAdd(result, S3_QUERY_PREFIX_STR, queryPrefix);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    FUNCTION_TEST_RETURN(HTTP_QUERY, result);
+}
+
+/***********************************************************************************************************************************
+General function for listing files to be used by other list routines
+
+If request is not NULL then it must have been sent with the query returned by storageS3ListQuery() for the same parameters and it
+will be used to get the first page of results.
+***********************************************************************************************************************************/
+static void
+storageS3ListInternal(
+    StorageS3 *const this, const String *const path, const StorageInfoLevel level, const String *const expression,
+    const bool recurse, const time_t targetTime, HttpRequest *request, StorageListCallback callback, void *const callbackData)
+{
+    FUNCTION_LOG_BEGIN(logLevelDebug);
+        FUNCTION_LOG_PARAM(STORAGE_S3, this);
+        FUNCTION_LOG_PARAM(STRING, path);
+        FUNCTION_LOG_PARAM(ENUM, level);
+        FUNCTION_LOG_PARAM(STRING, expression);
+        FUNCTION_LOG_PARAM(BOOL, recurse);
+        FUNCTION_LOG_PARAM(TIME, targetTime);
+        FUNCTION_LOG_PARAM(HTTP_REQUEST, request);
+        FUNCTION_LOG_PARAM(FUNCTIONP, callback);
+        FUNCTION_LOG_PARAM_P(VOID, callbackData);
+    FUNCTION_LOG_END();
+
+    FUNCTION_AUDIT_CALLBACK();
+
+    ASSERT(this != NULL);
+    ASSERT(path != NULL);
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        // Build the base prefix by stripping off the initial /
+        const String *const basePrefix = strSize(path) == 1 ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1)));
+
+        // Create query
+        HttpQuery *const query = storageS3ListQuery(path, expression, recurse, targetTime);
 
         // Store last info so it can be updated across requests for versioning
         String *const nameLast = strNew();
@@ -696,8 +730,6 @@ storageS3ListInternal(
             infoLast.versionId = versionIdLast;
 
         // Loop as long as a continuation token returned
-        HttpRequest *request = NULL;
-
         do
         {
             // Use an inner mem context here because we could potentially be retrieving millions of files so it is a good idea to
@@ -931,7 +963,7 @@ storageS3List(THIS_VOID, const String *const path, const StorageInfoLevel level,
     StorageList *const result = storageLstNew(level);
 
     storageS3ListInternal(
-        this, path, level, param.expression, false, param.targetTime, storageS3ListCallback, result);
+        this, path, level, param.expression, false, param.targetTime, NULL, storageS3ListCallback, result);
 
     FUNCTION_LOG_RETURN(STORAGE_LIST, result);
 }
@@ -990,7 +1022,8 @@ typedef struct StorageS3PathRemoveData
     unsigned int size;                                              // Size of delete request
     HttpRequest *request;                                           // Async delete request
     XmlDocument *xml;                                               // Delete xml
-    const String *path;                                             // Root path of remove
+    const String *path;                                             // Path prefix of keys being removed
+    StringList *pathList;                                           // Subpaths found in the first level of the path
 } StorageS3PathRemoveData;
 
 static HttpRequest *
@@ -1061,11 +1094,11 @@ storageS3PathRemoveCallback(void *const callbackData, const StorageInfo *const i
     ASSERT(callbackData != NULL);
     ASSERT(info != NULL);
 
+    StorageS3PathRemoveData *const data = (StorageS3PathRemoveData *)callbackData;
+
     // Only delete files since paths don't really exist
     if (info->type == storageTypeFile)
     {
-        StorageS3PathRemoveData *const data = (StorageS3PathRemoveData *)callbackData;
-
         // If there is something to delete then create the request
         if (data->xml == NULL)
         {
@@ -1102,6 +1135,13 @@ storageS3PathRemoveCallback(void *const callbackData, const StorageInfo *const i
             data->size = 0;
         }
     }
+    // Else store the subpath so it can be listed as a separate partition
+    else
+    {
+        ASSERT(info->type == storageTypePath);
+
+        strLstAdd(data->pathList, info->name);
+    }
 
     FUNCTION_TEST_RETURN_VOID();
 }
@@ -1123,14 +1163,43 @@ storageS3PathRemove(THIS_VOID, const String *const path, const bool recurse, con
 
     MEM_CONTEXT_TEMP_BEGIN()
     {
+        const String *const pathPrefix = strEq(path, FSLASH_STR) ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1)));
+
         StorageS3PathRemoveData data =
         {
             .this = this,
             .memContext = memContextCurrent(),
-            .path = strEq(path, FSLASH_STR) ? EMPTY_STR : strNewFmt("%s/", strZ(strSub(path, 1))),
+            .path = pathPrefix,
+            .pathList = strLstNew(),
         };
 
-        storageS3ListInternal(this, path, storageInfoLevelType, NULL, true, 0, storageS3PathRemoveCallback, &data);
+        // List the first level of the path to remove files and find subpaths. Listing each subpath separately splits a large
+        // recursive list into partitions that can be requested concurrently rather than paging through a single sequential list.
+        storageS3ListInternal(this, path, storageInfoLevelType, NULL, false, 0, NULL, storageS3PathRemoveCallback, &data);
+
+        // Remove subpaths recursively while keeping up to partitionMax list requests in flight
+        List *const requestList = lstNewP(sizeof(HttpRequest *));
+
+        for (unsigned int pathIdx = 0; pathIdx < strLstSize(data.pathList); pathIdx++)
+        {
+            while (lstSize(requestList) < strLstSize(data.pathList) && lstSize(requestList) < pathIdx + this->partitionMax)
+            {
+                HttpRequest *const request = storageS3RequestAsyncP(
+                    this, HTTP_VERB_GET_STR, FSLASH_STR,
+                    .query = storageS3ListQuery(
+                        strNewFmt("/%s%s", strZ(pathPrefix), strZ(strLstGet(data.pathList, lstSize(requestList)))), NULL, true,
+                        0));
+
+                lstAdd(requestList, &request);
+            }
+
+            const String *const pathSub = strLstGet(data.pathList, pathIdx);
+            data.path = strNewFmt("%s%s/", strZ(pathPrefix), strZ(pathSub));
+
+            storageS3ListInternal(
+                this, strNewFmt("/%s%s", strZ(pathPrefix), strZ(pathSub)), storageInfoLevelType, NULL, true, 0,
+                *(HttpRequest **)lstGet(requestList, pathIdx), storageS3PathRemoveCallback, &data);
+        }
 
         // Call if there is more to be removed
         if (data.xml != NULL)
@@ -1234,6 +1303,7 @@ storageS3New(
             .sseCustomerKey = strDup(sseCustomerKey),
             .partSize = partSize,
             .deleteMax = STORAGE_S3_DELETE_MAX,
+            .partitionMax = STORAGE_S3_PARTITION_MAX,
             .uriStyle = uriStyle,
             .bucketEndpoint =
                 uriStyle == storageS3UriStyleHost ? strNewFmt("%s.%s", strZ(bucket), strZ(endPoint)) : strDup(endPoint),
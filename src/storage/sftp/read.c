@@ -5,6 +5,8 @@ SFTP Storage Read
 
 #ifdef HAVE_LIBSSH2
 
+#include <string.h>
+
 #include "common/debug.h"
 #include "common/io/session.h"
 #include "common/log.h"
@@ -26,6 +28,10 @@ typedef struct StorageReadSftp
     uint64_t current;                                               // Current bytes read from file
     uint64_t limit;                                                 // Limit bytes to be read from file (UINT64_MAX for no limit)
     bool eof;                                                       // Did we reach end of file
+
+    size_t windowSize;                                              // Read window size (0 when the window is disabled)
+    Buffer *window;                                                 // Read window
+    size_t windowOffset;                                            // Offset of data in the window not yet returned
 } StorageReadSftp;
 
 /***********************************************************************************************************************************
@@ -83,11 +89,82 @@ storageReadSftpOpen(THIS_VOID)
         // Seek to offset, libssh2_sftp_seek64 returns void
         if (this->interface.offset != 0)
             libssh2_sftp_seek64(this->sftpHandle, this->interface.offset);
+
+        // Allocate the read window, sized to the data to be read so small files and ranges do not allocate the full window
+        if (this->windowSize != 0)
+        {
+            uint64_t size = this->limit;
+
+            // When there is no limit use the remaining file size. If the size cannot be determined then use the full window.
+            if (size == UINT64_MAX)
+            {
+                LIBSSH2_SFTP_ATTRIBUTES attr;
+                int rc;
+
+                do
+                {
+                    rc = libssh2_sftp_fstat_ex(this->sftpHandle, &attr, 0);
+                }
+                while (storageSftpWaitFd(this->storage, rc));
+
+                if (rc == 0 && (attr.flags & LIBSSH2_SFTP_ATTR_SIZE))
+                    size = attr.filesize > this->interface.offset ? attr.filesize - this->interface.offset : 0;
+            }
+
+            // No window is needed when there is nothing to read
+            if (size != 0)
+            {
+                MEM_CONTEXT_OBJ_BEGIN(this)
+                {
+                    this->window = bufNew(size < this->windowSize ? (size_t)size : this->windowSize);
+                }
+                MEM_CONTEXT_OBJ_END();
+            }
+        }
     }
 
     FUNCTION_LOG_RETURN(BOOL, this->sftpHandle != NULL);
 }
 
+/***********************************************************************************************************************************
+Read from the handle into the window and return the number of bytes read, 0 on EOF, or the libssh2 error code
+
+libssh2 splits each read into multiple SFTP requests and keeps a multiple of the requested size outstanding as read-ahead, so
+requesting the full window rather than the (possibly much smaller) remaining space in the caller's buffer keeps enough requests in
+flight to avoid stalling on the round trip to the server. The request is capped at the limit so read-ahead does not extend past the
+end of the range.
+***********************************************************************************************************************************/
+static ssize_t
+storageReadSftpWindow(StorageReadSftp *const this, const uint64_t remains)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_READ_SFTP, this);
+        FUNCTION_TEST_PARAM(UINT64, remains);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->window != NULL);
+    ASSERT(this->windowOffset == bufUsed(this->window));
+    ASSERT(remains > 0);
+
+    const size_t request = remains < bufSize(this->window) ? (size_t)remains : bufSize(this->window);
+    ssize_t result;
+
+    bufUsedZero(this->window);
+    this->windowOffset = 0;
+
+    do
+    {
+        result = libssh2_sftp_read(this->sftpHandle, (char *)bufPtr(this->window), request);
+    }
+    while (storageSftpWaitFd(this->storage, result));
+
+    if (result > 0)
+        bufUsedSet(this->window, (size_t)result);
+
+    FUNCTION_TEST_RETURN_TYPE(ssize_t, result);
+}
+
 /***********************************************************************************************************************************
 Read from a file
 ***********************************************************************************************************************************/
@@ -122,18 +199,41 @@ storageReadSftp(THIS_VOID, Buffer *const buffer, const bool block)
         // Read until EOF or buffer is full
         do
         {
-            do
+            // Read directly into the buffer when there is no window
+            if (this->window == NULL)
             {
-                rc = libssh2_sftp_read(this->sftpHandle, (char *)bufRemainsPtr(buffer), bufRemains(buffer));
+                do
+                {
+                    rc = libssh2_sftp_read(this->sftpHandle, (char *)bufRemainsPtr(buffer), bufRemains(buffer));
+                }
+                while (storageSftpWaitFd(this->storage, rc));
+
+                // Break on EOF or error
+                if (rc <= 0)
+                    break;
+
+                // Account/shift for bytes read
+                bufUsedInc(buffer, (size_t)rc);
             }
-            while (storageSftpWaitFd(this->storage, rc));
+            // Else copy from the window, refilling it when all data has been returned
+            else
+            {
+                if (this->windowOffset == bufUsed(this->window))
+                {
+                    rc = storageReadSftpWindow(this, this->limit - this->current - bufUsed(buffer));
+
+                    // Break on EOF or error
+                    if (rc <= 0)
+                        break;
+                }
 
-            // Break on EOF or error
-            if (rc <= 0)
-                break;
+                const size_t copySize = bufUsed(this->window) - this->windowOffset < bufRemains(buffer) ?
+                    bufUsed(this->window) - this->windowOffset : bufRemains(buffer);
 
-            // Account/shift for bytes read
-            bufUsedInc(buffer, (size_t)rc);
+                memcpy(bufRemainsPtr(buffer), bufPtr(this->window) + this->windowOffset, copySize);
+                bufUsedInc(buffer, copySize);
+                this->windowOffset += copySize;
+            }
         }
         while (!bufFull(buffer));
 
@@ -243,7 +343,8 @@ storageReadSftpEof(THIS_VOID)
 FN_EXTERN StorageRead *
 storageReadSftpNew(
     StorageSftp *const storage, const String *const name, const bool ignoreMissing, LIBSSH2_SESSION *const session,
-    LIBSSH2_SFTP *const sftpSession, LIBSSH2_SFTP_HANDLE *const sftpHandle, const uint64_t offset, const Variant *const limit)
+    LIBSSH2_SFTP *const sftpSession, LIBSSH2_SFTP_HANDLE *const sftpHandle, const uint64_t offset, const Variant *const limit,
+    const size_t window)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STRING, name);
@@ -253,6 +354,7 @@ storageReadSftpNew(
         FUNCTION_LOG_PARAM_P(VOID, sftpHandle);
         FUNCTION_LOG_PARAM(UINT64, offset);
         FUNCTION_LOG_PARAM(VARIANT, limit);
+        FUNCTION_LOG_PARAM(SIZE, window);
     FUNCTION_LOG_END();
 
     ASSERT(name != NULL);
@@ -271,6 +373,8 @@ storageReadSftpNew(
             // read so it seems worthwhile.
             .limit = limit == NULL ? UINT64_MAX : varUInt64(limit),
 
+            .windowSize = window,
+
             .interface = (StorageReadInterface)
             {
                 .type = STORAGE_SFTP_TYPE,
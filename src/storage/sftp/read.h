@@ -12,6 +12,6 @@ Constructors
 ***********************************************************************************************************************************/
 FN_EXTERN StorageRead *storageReadSftpNew(
     StorageSftp *storage, const String *name, bool ignoreMissing, LIBSSH2_SESSION *session, LIBSSH2_SFTP *sftpSession,
-    LIBSSH2_SFTP_HANDLE *sftpHandle, uint64_t offset, const Variant *limit);
+    LIBSSH2_SFTP_HANDLE *sftpHandle, uint64_t offset, const Variant *limit, size_t window);
 
 #endif
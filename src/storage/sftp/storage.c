@@ -36,6 +36,7 @@ struct StorageSftp
     LIBSSH2_SFTP *sftpSession;                                      // LibSsh2 session sftp session
     LIBSSH2_SFTP_HANDLE *sftpHandle;                                // LibSsh2 session sftp handle
     TimeMSec timeout;                                               // Session timeout
+    size_t window;                                                  // Request window size per file handle
 };
 
 /***********************************************************************************************************************************
@@ -934,7 +935,8 @@ storageSftpNewRead(THIS_VOID, const String *const file, const bool ignoreMissing
     FUNCTION_LOG_RETURN(
         STORAGE_READ,
         storageReadSftpNew(
-            this, file, ignoreMissing, this->session, this->sftpSession, this->sftpHandle, param.offset, param.limit));
+            this, file, ignoreMissing, this->session, this->sftpSession, this->sftpHandle, param.offset, param.limit,
+            this->window));
 }
 
 /**********************************************************************************************************************************/
@@ -971,7 +973,7 @@ storageSftpNewWrite(THIS_VOID, const String *const file, const StorageInterfaceN
         storageWriteSftpNew(
             this, file, this->session, this->sftpSession, this->sftpHandle, param.modeFile, param.modePath, param.user, param.group,
             param.timeModified, param.createPath, param.syncFile, this->interface.pathSync != NULL ? param.syncPath : false,
-            param.atomic, param.truncate));
+            param.atomic, param.truncate, this->window));
 }
 
 /**********************************************************************************************************************************/
@@ -1216,6 +1218,7 @@ storageSftpNew(
         FUNCTION_LOG_PARAM(MODE, param.modePath);
         FUNCTION_LOG_PARAM(BOOL, param.write);
         FUNCTION_LOG_PARAM(FUNCTIONP, param.pathExpressionFunction);
+        FUNCTION_LOG_PARAM(SIZE, param.window);
     FUNCTION_LOG_END();
 
     ASSERT(path != NULL);
@@ -1234,6 +1237,7 @@ storageSftpNew(
         {
             .interface = storageInterfaceSftp,
             .timeout = timeout,
+            .window = param.window,
         };
 
         // Init SFTP session
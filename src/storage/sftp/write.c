@@ -5,6 +5,8 @@ SFTP Storage File Write
 
 #ifdef HAVE_LIBSSH2
 
+#include <string.h>
+
 #include "common/debug.h"
 #include "common/log.h"
 #include "common/user.h"
@@ -24,6 +26,10 @@ typedef struct StorageWriteSftp
     LIBSSH2_SESSION *session;                                       // LibSsh2 session
     LIBSSH2_SFTP *sftpSession;                                      // LibSsh2 session sftp session
     LIBSSH2_SFTP_HANDLE *sftpHandle;                                // LibSsh2 session sftp handle
+
+    size_t windowSize;                                              // Write window size (0 when the window is disabled)
+    Buffer *window;                                                 // Write window
+    size_t windowOffset;                                            // Offset of data in the window not yet acknowledged
 } StorageWriteSftp;
 
 /***********************************************************************************************************************************
@@ -105,9 +111,93 @@ storageWriteSftpOpen(THIS_VOID)
         }
     }
 
+    // Allocate the write window
+    if (this->windowSize != 0)
+    {
+        MEM_CONTEXT_OBJ_BEGIN(this)
+        {
+            this->window = bufNew(this->windowSize);
+        }
+        MEM_CONTEXT_OBJ_END();
+    }
+
     FUNCTION_LOG_RETURN_VOID();
 }
 
+/***********************************************************************************************************************************
+Send data to the server and return the number of bytes acknowledged
+
+libssh2 splits the data into multiple SFTP requests, sends as many as possible, and returns as soon as the first request has been
+acknowledged. Requests that have been sent but not acknowledged remain outstanding and libssh2 skips over them on the next call, so
+the caller must pass the same data again starting from the first byte that was not acknowledged.
+***********************************************************************************************************************************/
+static size_t
+storageWriteSftpSend(StorageWriteSftp *const this, const uint8_t *const data, const size_t size)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_SFTP, this);
+        FUNCTION_TEST_PARAM_P(VOID, data);
+        FUNCTION_TEST_PARAM(SIZE, size);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(data != NULL);
+    ASSERT(size > 0);
+
+    ssize_t rc;
+
+    do
+    {
+        rc = libssh2_sftp_write(this->sftpHandle, (const char *)data, size);
+    }
+    while (storageSftpWaitFd(this->storage, rc));
+
+    if (rc == LIBSSH2_ERROR_EAGAIN)
+        THROW_FMT(FileWriteError, "timeout writing '%s'", strZ(this->nameTmp));
+
+    if (rc < 0)
+    {
+        storageSftpEvalLibSsh2Error(
+            (int)rc, libssh2_sftp_last_error(this->sftpSession), &FileWriteError,
+            strNewFmt("unable to write '%s'", strZ(this->nameTmp)), NULL);
+    }
+
+    FUNCTION_TEST_RETURN(SIZE, (size_t)rc);
+}
+
+/***********************************************************************************************************************************
+Send data in the window until at least half of it has been acknowledged (or all of it when flushing) and then move the data that has
+not been acknowledged to the start of the window. Stopping at half the window keeps requests in flight while still leaving space for
+new data, and limits the cost of moving data within the window.
+***********************************************************************************************************************************/
+static void
+storageWriteSftpWindowSend(StorageWriteSftp *const this, const bool flush)
+{
+    FUNCTION_TEST_BEGIN();
+        FUNCTION_TEST_PARAM(STORAGE_WRITE_SFTP, this);
+        FUNCTION_TEST_PARAM(BOOL, flush);
+    FUNCTION_TEST_END();
+
+    ASSERT(this != NULL);
+    ASSERT(this->window != NULL);
+
+    const size_t sendTarget = flush ? bufUsed(this->window) : bufSize(this->window) / 2;
+
+    while (this->windowOffset < sendTarget)
+    {
+        this->windowOffset += storageWriteSftpSend(
+            this, bufPtr(this->window) + this->windowOffset, bufUsed(this->window) - this->windowOffset);
+    }
+
+    const size_t remains = bufUsed(this->window) - this->windowOffset;
+
+    memmove(bufPtr(this->window), bufPtr(this->window) + this->windowOffset, remains);
+    bufUsedSet(this->window, remains);
+    this->windowOffset = 0;
+
+    FUNCTION_TEST_RETURN_VOID();
+}
+
 /***********************************************************************************************************************************
 Write to the file
 ***********************************************************************************************************************************/
@@ -125,39 +215,28 @@ storageWriteSftp(THIS_VOID, const Buffer *const buffer)
     ASSERT(buffer != NULL);
     ASSERT(this->sftpHandle != NULL);
 
-    ssize_t rc;
-    size_t remains = bufUsed(buffer);                               // Amount left to write
     size_t offset = 0;                                              // Offset into the buffer
 
-    // Loop until all the data is written
-    do
+    // Send the buffer and wait until all data is acknowledged when there is no window
+    if (this->window == NULL)
     {
-        do
-        {
-            rc = libssh2_sftp_write(this->sftpHandle, (const char *)bufPtrConst(buffer) + offset, remains);
-        }
-        while (storageSftpWaitFd(this->storage, rc));
-
-        // Break on error. Error will be thrown below the loop.
-        if (rc < 0)
-            break;
-
-        // Offset for next write start point
-        offset += (size_t)rc;
-
-        // Update amount left to write
-        remains -= (size_t)rc;
+        while (offset < bufUsed(buffer))
+            offset += storageWriteSftpSend(this, bufPtrConst(buffer) + offset, bufUsed(buffer) - offset);
     }
-    while (remains);
+    // Else copy the buffer into the window and only send when the window is full so requests remain in flight between writes
+    else
+    {
+        while (offset < bufUsed(buffer))
+        {
+            if (bufFull(this->window))
+                storageWriteSftpWindowSend(this, false);
 
-    if (rc == LIBSSH2_ERROR_EAGAIN)
-        THROW_FMT(FileWriteError, "timeout writing '%s'", strZ(this->nameTmp));
+            const size_t catSize = bufRemains(this->window) < bufUsed(buffer) - offset ?
+                bufRemains(this->window) : bufUsed(buffer) - offset;
 
-    if (rc < 0)
-    {
-        storageSftpEvalLibSsh2Error(
-            (int)rc, libssh2_sftp_last_error(this->sftpSession), &FileWriteError,
-            strNewFmt("unable to write '%s'", strZ(this->nameTmp)), NULL);
+            bufCatSub(this->window, buffer, offset, catSize);
+            offset += catSize;
+        }
     }
 
     FUNCTION_LOG_RETURN_VOID();
@@ -256,6 +335,10 @@ storageWriteSftpClose(THIS_VOID)
     {
         int rc;
 
+        // Send remaining data in the window and wait for it to be acknowledged
+        if (this->window != NULL)
+            storageWriteSftpWindowSend(this, true);
+
         if (this->interface.syncFile)
         {
             do
@@ -342,7 +425,7 @@ storageWriteSftpNew(
     StorageSftp *const storage, const String *const name, LIBSSH2_SESSION *const session, LIBSSH2_SFTP *const sftpSession,
     LIBSSH2_SFTP_HANDLE *const sftpHandle, const mode_t modeFile, const mode_t modePath, const String *const user,
     const String *const group, const time_t timeModified, const bool createPath, const bool syncFile, const bool syncPath,
-    const bool atomic, const bool truncate)
+    const bool atomic, const bool truncate, const size_t window)
 {
     FUNCTION_LOG_BEGIN(logLevelTrace);
         FUNCTION_LOG_PARAM(STORAGE_SFTP, storage);
@@ -360,6 +443,7 @@ storageWriteSftpNew(
         FUNCTION_LOG_PARAM(BOOL, syncPath);
         FUNCTION_LOG_PARAM(BOOL, atomic);
         FUNCTION_LOG_PARAM(BOOL, truncate);
+        FUNCTION_LOG_PARAM(SIZE, window);
     FUNCTION_LOG_END();
 
     ASSERT(storage != NULL);
@@ -377,6 +461,8 @@ storageWriteSftpNew(
             .sftpSession = sftpSession,
             .sftpHandle = sftpHandle,
 
+            .windowSize = window,
+
             .interface = (StorageWriteInterface)
             {
                 .type = STORAGE_SFTP_TYPE,
@@ -14,6 +14,6 @@ Constructors
 FN_EXTERN StorageWrite *storageWriteSftpNew(
     StorageSftp *storage, const String *name, LIBSSH2_SESSION *session, LIBSSH2_SFTP *sftpSession, LIBSSH2_SFTP_HANDLE *sftpHandle,
     mode_t modeFile, mode_t modePath, const String *user, const String *group, time_t timeModified, bool createPath, bool syncFile,
-    bool syncPath, bool atomic, bool truncate);
+    bool syncPath, bool atomic, bool truncate, size_t window);
 
 #endif
@@ -553,7 +553,10 @@ storageNewWrite(const Storage *const this, const String *const fileExp, const St
         FUNCTION_LOG_PARAM(BOOL, param.noSyncFile);
         FUNCTION_LOG_PARAM(BOOL, param.noSyncPath);
         FUNCTION_LOG_PARAM(BOOL, param.noAtomic);
+        FUNCTION_LOG_PARAM(BOOL, param.syncDefer);
         FUNCTION_LOG_PARAM(BOOL, param.noTruncate);
+        FUNCTION_LOG_PARAM(BOOL, param.sparse);
+        FUNCTION_LOG_PARAM(UINT64, param.preallocate);
         FUNCTION_LOG_PARAM(BOOL, param.compressible);
     FUNCTION_LOG_END();
 
@@ -561,6 +564,8 @@ storageNewWrite(const Storage *const this, const String *const fileExp, const St
     ASSERT(this->write);
     // noTruncate does not work with atomic writes because a new file is always created for atomic writes
     ASSERT(!param.noTruncate || param.noAtomic);
+    // Holes do not overwrite existing data so sparse writes require the file to be truncated
+    ASSERT(!param.sparse || !param.noTruncate);
 
     StorageWrite *result;
 
@@ -571,7 +576,8 @@ storageNewWrite(const Storage *const this, const String *const fileExp, const St
                 storageDriver(this), storagePathP(this, fileExp), .modeFile = param.modeFile != 0 ? param.modeFile : this->modeFile,
                 .modePath = param.modePath != 0 ? param.modePath : this->modePath, .user = param.user, .group = param.group,
                 .timeModified = param.timeModified, .createPath = !param.noCreatePath, .syncFile = !param.noSyncFile,
-                .syncPath = !param.noSyncPath, .atomic = !param.noAtomic, .truncate = !param.noTruncate,
+                .syncDefer = param.syncDefer, .syncPath = !param.noSyncPath, .atomic = !param.noAtomic,
+                .truncate = !param.noTruncate, .sparse = param.sparse, .preallocate = param.preallocate,
                 .compressible = param.compressible),
             memContextPrior());
     }
@@ -761,11 +767,12 @@ storagePathRemove(const Storage *const this, const String *const pathExp, const
 
 /**********************************************************************************************************************************/
 FN_EXTERN void
-storagePathSync(const Storage *const this, const String *const pathExp)
+storagePathSync(const Storage *const this, const String *const pathExp, const StoragePathSyncParam param)
 {
     FUNCTION_LOG_BEGIN(logLevelDebug);
         FUNCTION_LOG_PARAM(STORAGE, this);
         FUNCTION_LOG_PARAM(STRING, pathExp);
+        FUNCTION_LOG_PARAM(BOOL, param.fs);
     FUNCTION_LOG_END();
 
     ASSERT(this != NULL);
@@ -776,7 +783,7 @@ storagePathSync(const Storage *const this, const String *const pathExp)
     {
         MEM_CONTEXT_TEMP_BEGIN()
         {
-            storageInterfacePathSyncP(storageDriver(this), storagePathP(this, pathExp));
+            storageInterfacePathSyncP(storageDriver(this), storagePathP(this, pathExp), .fs = param.fs);
         }
         MEM_CONTEXT_TEMP_END();
     }
@@ -175,10 +175,22 @@ typedef struct StorageNewWriteParam
     bool noSyncPath;
     bool noAtomic;
 
+    // Defer the file sync when the storage supports it. Writeback is started when the file is closed but the file is not durable
+    // until storagePathSyncP() is called with fs = true for a path in the same filesystem. Ignored when noSyncFile is true.
+    bool syncDefer;
+
     // Do not truncate file if it exists. Use this only in cases where the file will be manipulated directly through the file
     // handle, which should always be the exception and indicates functionality that should be added to the storage interface.
     bool noTruncate;
 
+    // Write all-zero blocks as holes when the storage supports sparse files. The file must be truncated since existing data is not
+    // overwritten where holes are created.
+    bool sparse;
+
+    // Preallocate space for the file when the storage supports it, which reduces fragmentation when many files are written at once.
+    // The file size is not changed. Cannot be used with sparse since holes would be allocated anyway.
+    uint64_t preallocate;
+
     bool compressible;
     mode_t modeFile;
     mode_t modePath;
@@ -238,10 +250,18 @@ typedef struct StoragePathRemoveParam
 FN_EXTERN void storagePathRemove(const Storage *this, const String *pathExp, StoragePathRemoveParam param);
 
 // Sync a path
-#define storagePathSyncP(this, pathExp)                                                                                            \
-    storagePathSync(this, pathExp)
+typedef struct StoragePathSyncParam
+{
+    VAR_PARAM_HEADER;
+
+    // Sync the filesystem containing the path when the storage supports it. This makes files written with syncDefer durable.
+    bool fs;
+} StoragePathSyncParam;
+
+#define storagePathSyncP(this, pathExp, ...)                                                                                       \
+    storagePathSync(this, pathExp, (StoragePathSyncParam){VAR_PARAM_INIT, __VA_ARGS__})
 
-FN_EXTERN void storagePathSync(const Storage *this, const String *pathExp);
+FN_EXTERN void storagePathSync(const Storage *this, const String *pathExp, StoragePathSyncParam param);
 
 // Write a buffer to storage
 #define storagePutP(file, buffer)                                                                                                  \
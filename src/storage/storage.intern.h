@@ -158,6 +158,9 @@ typedef struct StorageInterfaceNewWriteParam
     bool syncFile;
     bool syncPath;
 
+    // Defer the file sync until the filesystem is synced. Storage that does not support this syncs the file as usual.
+    bool syncDefer;
+
     // Ensure the file is written atomically. If this is false it's OK to write atomically if that's all the storage supports
     // (e.g. S3). Non-atomic writes are used in some places where there is a performance advantage and atomicity is not needed.
     bool atomic;
@@ -166,6 +169,12 @@ typedef struct StorageInterfaceNewWriteParam
     // which should always be the exception and shows functionality that should be added to the storage interface.
     bool truncate;
 
+    // Write all-zero blocks as holes. Storage that does not support sparse files ignores this and writes the zeroes.
+    bool sparse;
+
+    // Preallocate space for the file. Storage that does not support preallocation ignores this.
+    uint64_t preallocate;
+
     // Is the file compressible? This is used when the file must be moved across a network and temporary compression is helpful.
     bool compressible;
 } StorageInterfaceNewWriteParam;
@@ -266,6 +275,9 @@ typedef void StorageInterfacePathCreate(
 typedef struct StorageInterfacePathSyncParam
 {
     VAR_PARAM_HEADER;
+
+    // Sync the filesystem containing the path. Storage that does not support this syncs the path as usual.
+    bool fs;
 } StorageInterfacePathSyncParam;
 
 typedef void StorageInterfacePathSync(void *thisVoid, const String *path, StorageInterfacePathSyncParam param);
@@ -86,6 +86,13 @@ storageWriteSyncPath(const StorageWrite *const this)
     return storageWriteInterface(this)->syncPath;
 }
 
+// Will all-zero blocks be written as holes?
+FN_INLINE_ALWAYS bool
+storageWriteSparse(const StorageWrite *const this)
+{
+    return storageWriteInterface(this)->sparse;
+}
+
 // Will the file be truncated if it exists?
 FN_INLINE_ALWAYS bool
 storageWriteTruncate(const StorageWrite *const this)
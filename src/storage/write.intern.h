@@ -22,6 +22,8 @@ typedef struct StorageWriteInterface
 
     bool atomic;
     bool truncate;                                                  // Truncate file if it exists
+    bool sparse;                                                    // Write all-zero blocks as holes
+    uint64_t preallocate;                                           // Space to preallocate for the file
     bool createPath;
     bool compressible;                                              // Is this file compressible?
     unsigned int compressLevel;                                     // Level to use for compression
@@ -29,6 +31,7 @@ typedef struct StorageWriteInterface
     mode_t modeFile;
     mode_t modePath;
     bool syncFile;
+    bool syncDefer;                                                 // Start writeback on close and sync with the filesystem later
     bool syncPath;
     time_t timeModified;                                            // Time file was last modified
     const String *user;                                             // User that owns the file
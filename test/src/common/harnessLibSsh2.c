@@ -539,6 +539,33 @@ libssh2_session_free(LIBSSH2_SESSION *session)
     return hrnLibSsh2ScriptRun(HRNLIBSSH2_SESSION_FREE, NULL, (HrnLibSsh2 *)session)->resultInt;
 }
 
+/***********************************************************************************************************************************
+Shim for libssh2_sftp_fstat_ex
+***********************************************************************************************************************************/
+int
+libssh2_sftp_fstat_ex(LIBSSH2_SFTP_HANDLE *handle, LIBSSH2_SFTP_ATTRIBUTES *attrs, int setstat)
+{
+    HrnLibSsh2 *hrnLibSsh2 = NULL;
+
+    MEM_CONTEXT_TEMP_BEGIN()
+    {
+        hrnLibSsh2 = hrnLibSsh2ScriptRun(
+            HRNLIBSSH2_SFTP_FSTAT_EX,
+            varLstAdd(
+                varLstNew(), varNewInt(setstat)),
+            (HrnLibSsh2 *)handle);
+    }
+    MEM_CONTEXT_TEMP_END();
+
+    if (attrs == NULL)
+        THROW(AssertError, "attrs is NULL");
+
+    attrs->flags = (unsigned long)hrnLibSsh2->flags;
+    attrs->filesize = hrnLibSsh2->filesize;
+
+    return hrnLibSsh2->resultInt;
+}
+
 /***********************************************************************************************************************************
 Shim for libssh2_sftp_stat_ex
 ***********************************************************************************************************************************/
@@ -0,0 +1,591 @@
+/***********************************************************************************************************************************
+Object Store Test Harness
+***********************************************************************************************************************************/
+#include "build.auto.h"
+
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/io/http/common.h"
+#include "common/io/http/query.h"
+#include "common/io/http/request.h"
+#include "common/io/io.h"
+#include "common/io/socket/client.h"
+#include "common/io/socket/server.h"
+#include "common/io/tls/server.h"
+#include "common/type/convert.h"
+#include "common/type/xml.h"
+#include "common/wait.h"
+#include "storage/posix/storage.h"
+
+#include "common/harnessDebug.h"
+#include "common/harnessObjStore.h"
+#include "common/harnessServer.h"
+#include "common/harnessTest.h"
+
+/***********************************************************************************************************************************
+Constants
+***********************************************************************************************************************************/
+#define HRN_OBJ_STORE_PATH_OBJECT                                   "object"
+#define HRN_OBJ_STORE_PATH_UPLOAD                                   "upload"
+
+#define HRN_OBJ_STORE_TIMEOUT                                       5000
+
+// Default maximum keys returned in a list page, which matches S3
+#define HRN_OBJ_STORE_LIST_MAX                                      1000
+
+/***********************************************************************************************************************************
+Local data
+***********************************************************************************************************************************/
+static struct HrnObjStoreLocal
+{
+    volatile sig_atomic_t stop;                                     // Has the server been asked to stop?
+} hrnObjStoreLocal;
+
+/***********************************************************************************************************************************
+Signal handler to stop the server. Only a flag is set here -- accept() will be interrupted and the server loop will exit.
+***********************************************************************************************************************************/
+static void
+hrnObjStoreSignal(const int signalType)
+{
+    (void)signalType;
+    hrnObjStoreLocal.stop = true;
+}
+
+/***********************************************************************************************************************************
+Sleep long enough to limit the transfer rate of the specified number of bytes
+***********************************************************************************************************************************/
+static void
+hrnObjStoreRate(const HrnObjStoreRunParam param, const uint64_t size, const TimeMSec timeBegin)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(UINT64, size);
+        FUNCTION_HARNESS_PARAM(TIME_MSEC, timeBegin);
+    FUNCTION_HARNESS_END();
+
+    if (param.bytesPerSec != 0)
+    {
+        const TimeMSec timeRate = size * MSEC_PER_SEC / param.bytesPerSec;
+        const TimeMSec timeElapsed = timeMSec() - timeBegin;
+
+        if (timeElapsed < timeRate)
+            sleepMSec(timeRate - timeElapsed);
+    }
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Send a reply to the client
+***********************************************************************************************************************************/
+typedef struct HrnObjStoreReplyParam
+{
+    VAR_PARAM_HEADER;
+    const String *header;                                           // Additional headers, each terminated by \r\n
+    const Buffer *content;                                          // Content to send
+    uint64_t contentSize;                                           // Content size when content is not sent (e.g. HEAD)
+} HrnObjStoreReplyParam;
+
+#define hrnObjStoreReplyP(write, runParam, code, reason, ...)                                                                      \
+    hrnObjStoreReply(write, runParam, code, reason, (HrnObjStoreReplyParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+static void
+hrnObjStoreReply(
+    IoWrite *const write, const HrnObjStoreRunParam runParam, const unsigned int code, const char *const reason,
+    const HrnObjStoreReplyParam param)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(IO_WRITE, write);
+        FUNCTION_HARNESS_PARAM(UINT, code);
+        FUNCTION_HARNESS_PARAM(STRINGZ, reason);
+        FUNCTION_HARNESS_PARAM(STRING, param.header);
+        FUNCTION_HARNESS_PARAM(BUFFER, param.content);
+        FUNCTION_HARNESS_PARAM(UINT64, param.contentSize);
+    FUNCTION_HARNESS_END();
+
+    ASSERT(write != NULL);
+    ASSERT(reason != NULL);
+
+    if (runParam.latency != 0)
+        sleepMSec(runParam.latency);
+
+    const TimeMSec timeBegin = timeMSec();
+
+    ioWrite(
+        write,
+        BUFSTR(
+            strNewFmt(
+                "HTTP/1.1 %u %s\r\n" HTTP_HEADER_CONTENT_LENGTH ":%" PRIu64 "\r\n%s\r\n", code, reason,
+                param.content != NULL ? bufUsed(param.content) : param.contentSize,
+                param.header != NULL ? strZ(param.header) : "")));
+
+    if (param.content != NULL)
+    {
+        ioWrite(write, param.content);
+        hrnObjStoreRate(runParam, bufUsed(param.content), timeBegin);
+    }
+
+    ioWriteFlush(write);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+/***********************************************************************************************************************************
+Convert time to the format used in S3 list results
+***********************************************************************************************************************************/
+static String *
+hrnObjStoreTime(const time_t time)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(TIME, time);
+    FUNCTION_HARNESS_END();
+
+    char buffer[32];
+    struct tm timePart;
+
+    strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S.000Z", gmtime_r(&time, &timePart));
+
+    FUNCTION_HARNESS_RETURN(STRING, strNewZ(buffer));
+}
+
+/***********************************************************************************************************************************
+List objects. Results are returned in pages of up to listMax keys and common prefixes. The continuation token is the last key or
+common prefix returned, which assumes that keys sort in the same order as the paths they are stored in.
+***********************************************************************************************************************************/
+static Buffer *
+hrnObjStoreList(const Storage *const storage, const HttpQuery *const query, const unsigned int listMax)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(STORAGE, storage);
+        FUNCTION_HARNESS_PARAM(HTTP_QUERY, query);
+        FUNCTION_HARNESS_PARAM(UINT, listMax);
+    FUNCTION_HARNESS_END();
+
+    const String *const prefix = httpQueryGet(query, STRDEF("prefix")) != NULL ? httpQueryGet(query, STRDEF("prefix")) : EMPTY_STR;
+    const bool delimiter = httpQueryGet(query, STRDEF("delimiter")) != NULL;
+    const String *const continuation = httpQueryGet(query, STRDEF("continuation-token"));
+
+    XmlDocument *const xml = xmlDocumentNew(STRDEF("ListBucketResult"));
+    const String *nameLast = NULL;
+    unsigned int nameTotal = 0;
+    bool truncated = false;
+
+    // Only the path containing the prefix needs to be scanned
+    const String *const prefixPath = strEmpty(strPath(prefix)) ? NULL : strPath(prefix);
+    StringList *const commonPrefixList = strLstNew();
+
+    StorageIterator *const storageItr = storageNewItrP(
+        storage,
+        prefixPath == NULL ? STRDEF(HRN_OBJ_STORE_PATH_OBJECT) : strNewFmt(HRN_OBJ_STORE_PATH_OBJECT "/%s", strZ(prefixPath)),
+        .recurse = true, .sortOrder = sortOrderAsc);
+
+    while (storageItrMore(storageItr))
+    {
+        const StorageInfo info = storageItrNext(storageItr);
+
+        if (info.type != storageTypeFile)
+            continue;
+
+        const String *const key = prefixPath == NULL ? info.name : strNewFmt("%s/%s", strZ(prefixPath), strZ(info.name));
+
+        if (!strBeginsWith(key, prefix))
+            continue;
+
+        // Roll up keys that contain the delimiter after the prefix into common prefixes
+        const String *commonPrefix = NULL;
+
+        if (delimiter)
+        {
+            const int delimiterIdx = strChr(strSub(key, strSize(prefix)), '/');
+
+            if (delimiterIdx != -1)
+            {
+                commonPrefix = strSubN(key, 0, strSize(prefix) + (size_t)delimiterIdx + 1);
+
+                if (strLstExists(commonPrefixList, commonPrefix))
+                    continue;
+
+                strLstAdd(commonPrefixList, commonPrefix);
+            }
+        }
+
+        // Skip names returned in prior pages
+        const String *const name = commonPrefix != NULL ? commonPrefix : key;
+
+        if (continuation != NULL && strCmp(name, continuation) <= 0)
+            continue;
+
+        // Stop when the page is full
+        if (nameTotal == listMax)
+        {
+            xmlNodeContentSet(xmlNodeAdd(xmlDocumentRoot(xml), STRDEF("NextContinuationToken")), nameLast);
+            truncated = true;
+            break;
+        }
+
+        if (commonPrefix != NULL)
+        {
+            xmlNodeContentSet(
+                xmlNodeAdd(xmlNodeAdd(xmlDocumentRoot(xml), STRDEF("CommonPrefixes")), STRDEF("Prefix")), commonPrefix);
+        }
+        else
+        {
+            XmlNode *const contents = xmlNodeAdd(xmlDocumentRoot(xml), STRDEF("Contents"));
+            xmlNodeContentSet(xmlNodeAdd(contents, STRDEF("Key")), key);
+            xmlNodeContentSet(xmlNodeAdd(contents, STRDEF("LastModified")), hrnObjStoreTime(info.timeModified));
+            xmlNodeContentSet(xmlNodeAdd(contents, STRDEF("Size")), strNewFmt("%" PRIu64, info.size));
+        }
+
+        nameLast = name;
+        nameTotal++;
+    }
+
+    xmlNodeContentSet(xmlNodeAdd(xmlDocumentRoot(xml), STRDEF("IsTruncated")), truncated ? TRUE_STR : FALSE_STR);
+
+    FUNCTION_HARNESS_RETURN(BUFFER, xmlDocumentBuf(xml));
+}
+
+/***********************************************************************************************************************************
+Process requests on a session until the client closes it
+***********************************************************************************************************************************/
+static void
+hrnObjStoreSession(IoSession *const session, const Storage *const storage, const HrnObjStoreRunParam param)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(IO_SESSION, session);
+        FUNCTION_HARNESS_PARAM(STORAGE, storage);
+    FUNCTION_HARNESS_END();
+
+    IoRead *const read = ioSessionIoReadP(session);
+    IoWrite *const write = ioSessionIoWrite(session);
+    unsigned int requestTotal = 0;
+    unsigned int uploadTotal = 0;
+    bool done = false;
+
+    do
+    {
+        MEM_CONTEXT_TEMP_BEGIN()
+        {
+            // Read request line. An empty line at eof means the client has closed the session.
+            const String *const requestLine = strTrim(ioReadLineParam(read, true));
+
+            if (strEmpty(requestLine))
+            {
+                done = true;
+            }
+            else
+            {
+                const StringList *const requestPart = strLstNewSplitZ(requestLine, " ");
+                CHECK(FormatError, strLstSize(requestPart) == 3, "invalid request line");
+
+                const String *const verb = strLstGet(requestPart, 0);
+                const StringList *const uriPart = strLstNewSplitZ(strLstGet(requestPart, 1), "?");
+                const HttpQuery *const query = strLstSize(uriPart) > 1 ?
+                    httpQueryNewStr(strLstGet(uriPart, 1)) : httpQueryNewP();
+                const String *const key = httpUriDecode(strSub(strLstGet(uriPart, 0), 1));
+                const String *const file = strNewFmt(HRN_OBJ_STORE_PATH_OBJECT "/%s", strZ(key));
+
+                // Read headers
+                uint64_t contentSize = 0;
+                const String *range = NULL;
+
+                do
+                {
+                    const String *const header = strTrim(ioReadLine(read));
+
+                    if (strEmpty(header))
+                        break;
+
+                    const int colonIdx = strChr(header, ':');
+                    CHECK(FormatError, colonIdx != -1, "invalid header");
+
+                    const String *const headerKey = strLower(strNewZN(strZ(header), (size_t)colonIdx));
+                    const String *const headerValue = strTrim(strSub(header, (size_t)colonIdx + 1));
+
+                    if (strEq(headerKey, HTTP_HEADER_CONTENT_LENGTH_STR))
+                        contentSize = cvtZToUInt64(strZ(headerValue));
+                    else if (strEq(headerKey, HTTP_HEADER_RANGE_STR))
+                        range = headerValue;
+                }
+                while (true);
+
+                // Read content
+                const TimeMSec timeBegin = timeMSec();
+                Buffer *const content = bufNew((size_t)contentSize);
+
+                if (contentSize > 0)
+                {
+                    ioRead(read, content);
+                    CHECK(FormatError, bufUsed(content) == contentSize, "short content read");
+                    hrnObjStoreRate(param, contentSize, timeBegin);
+                }
+
+                requestTotal++;
+
+                // Throttle requests when requested
+                if (param.errorInterval != 0 && requestTotal % param.errorInterval == 0)
+                {
+                    hrnObjStoreReplyP(
+                        write, param, 503, "Slow Down",
+                        .content = BUFSTRDEF(
+                            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                            "<Error><Code>SlowDown</Code><Message>Please reduce your request rate.</Message></Error>"));
+                }
+                // List objects
+                else if (strEq(verb, HTTP_VERB_GET_STR) && httpQueryGet(query, STRDEF("list-type")) != NULL)
+                {
+                    hrnObjStoreReplyP(
+                        write, param, 200, "OK",
+                        .content = hrnObjStoreList(storage, query, param.listMax == 0 ? HRN_OBJ_STORE_LIST_MAX : param.listMax));
+                }
+                // Get object
+                else if (strEq(verb, HTTP_VERB_GET_STR))
+                {
+                    uint64_t offset = 0;
+                    const Variant *limit = NULL;
+
+                    if (range != NULL)
+                    {
+                        const StringList *const rangePart = strLstNewSplitZ(
+                            strSub(range, sizeof(HTTP_HEADER_RANGE_BYTES "=") - 1), "-");
+
+                        offset = cvtZToUInt64(strZ(strLstGet(rangePart, 0)));
+
+                        if (!strEmpty(strLstGet(rangePart, 1)))
+                            limit = varNewUInt64(cvtZToUInt64(strZ(strLstGet(rangePart, 1))) - offset + 1);
+                    }
+
+                    const Buffer *const object = storageGetP(
+                        storageNewReadP(storage, file, .ignoreMissing = true, .offset = offset, .limit = limit));
+
+                    if (object == NULL)
+                    {
+                        hrnObjStoreReplyP(write, param, 404, "Not Found");
+                    }
+                    else
+                    {
+                        hrnObjStoreReplyP(
+                            write, param, range == NULL ? 200 : 206, range == NULL ? "OK" : "Partial Content", .content = object);
+                    }
+                }
+                // Get object info
+                else if (strEq(verb, HTTP_VERB_HEAD_STR))
+                {
+                    const StorageInfo info = storageInfoP(storage, file, .ignoreMissing = true);
+
+                    if (!info.exists || info.type != storageTypeFile)
+                    {
+                        hrnObjStoreReplyP(write, param, 404, "Not Found");
+                    }
+                    else
+                    {
+                        hrnObjStoreReplyP(
+                            write, param, 200, "OK", .contentSize = info.size,
+                            .header = strNewFmt(
+                                HTTP_HEADER_LAST_MODIFIED ":%s\r\n", strZ(httpDateFromTime(info.timeModified))));
+                    }
+                }
+                // Put object or part of a multipart upload
+                else if (strEq(verb, HTTP_VERB_PUT_STR))
+                {
+                    const String *const uploadId = httpQueryGet(query, STRDEF("uploadId"));
+
+                    storagePutP(
+                        storageNewWriteP(
+                            storage,
+                            uploadId == NULL ?
+                                file :
+                                strNewFmt(
+                                    HRN_OBJ_STORE_PATH_UPLOAD "/%s/%s", strZ(uploadId),
+                                    strZ(httpQueryGet(query, STRDEF("partNumber")))),
+                            .noSyncFile = true, .noSyncPath = true),
+                        content);
+
+                    hrnObjStoreReplyP(write, param, 200, "OK", .header = strNewFmt(HTTP_HEADER_ETAG ":\"%u\"\r\n", requestTotal));
+                }
+                // Delete object
+                else if (strEq(verb, HTTP_VERB_DELETE_STR))
+                {
+                    storageRemoveP(storage, file);
+                    hrnObjStoreReplyP(write, param, 204, "No Content");
+                }
+                // Delete multiple objects
+                else if (strEq(verb, HTTP_VERB_POST_STR) && httpQueryGet(query, STRDEF("delete")) != NULL)
+                {
+                    const XmlNodeList *const objectList = xmlNodeChildList(
+                        xmlDocumentRoot(xmlDocumentNewBuf(content)), STRDEF("Object"));
+
+                    for (unsigned int objectIdx = 0; objectIdx < xmlNodeLstSize(objectList); objectIdx++)
+                    {
+                        storageRemoveP(
+                            storage,
+                            strNewFmt(
+                                HRN_OBJ_STORE_PATH_OBJECT "/%s",
+                                strZ(xmlNodeContent(xmlNodeChild(xmlNodeLstGet(objectList, objectIdx), STRDEF("Key"), true)))));
+                    }
+
+                    hrnObjStoreReplyP(write, param, 200, "OK", .content = BUFSTRDEF("<DeleteResult/>"));
+                }
+                // Begin multipart upload
+                else if (strEq(verb, HTTP_VERB_POST_STR) && httpQueryGet(query, STRDEF("uploads")) != NULL)
+                {
+                    uploadTotal++;
+
+                    hrnObjStoreReplyP(
+                        write, param, 200, "OK",
+                        .content = BUFSTR(
+                            strNewFmt(
+                                "<InitiateMultipartUploadResult><UploadId>%d-%u</UploadId></InitiateMultipartUploadResult>",
+                                getpid(), uploadTotal)));
+                }
+                // Complete multipart upload by concatenating the parts in order
+                else if (strEq(verb, HTTP_VERB_POST_STR) && httpQueryGet(query, STRDEF("uploadId")) != NULL)
+                {
+                    const String *const uploadPath = strNewFmt(
+                        HRN_OBJ_STORE_PATH_UPLOAD "/%s", strZ(httpQueryGet(query, STRDEF("uploadId"))));
+                    const XmlNodeList *const partList = xmlNodeChildList(
+                        xmlDocumentRoot(xmlDocumentNewBuf(content)), STRDEF("Part"));
+
+                    IoWrite *const objectWrite = storageWriteIo(
+                        storageNewWriteP(storage, file, .noSyncFile = true, .noSyncPath = true));
+                    ioWriteOpen(objectWrite);
+
+                    for (unsigned int partIdx = 0; partIdx < xmlNodeLstSize(partList); partIdx++)
+                    {
+                        ioWrite(
+                            objectWrite,
+                            storageGetP(
+                                storageNewReadP(
+                                    storage,
+                                    strNewFmt(
+                                        "%s/%s", strZ(uploadPath),
+                                        strZ(
+                                            xmlNodeContent(
+                                                xmlNodeChild(xmlNodeLstGet(partList, partIdx), STRDEF("PartNumber"), true)))))));
+                    }
+
+                    ioWriteClose(objectWrite);
+                    storagePathRemoveP(storage, uploadPath, .recurse = true);
+
+                    hrnObjStoreReplyP(
+                        write, param, 200, "OK",
+                        .content = BUFSTR(
+                            strNewFmt(
+                                "<CompleteMultipartUploadResult><ETag>\"%u\"</ETag></CompleteMultipartUploadResult>",
+                                requestTotal)));
+                }
+                else
+                    THROW_FMT(AssertError, "unsupported request '%s'", strZ(requestLine));
+            }
+        }
+        MEM_CONTEXT_TEMP_END();
+    }
+    while (!done);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+void
+hrnObjStoreRun(const String *const path, const unsigned int port, const HrnObjStoreRunParam param)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(STRING, path);
+        FUNCTION_HARNESS_PARAM(UINT, port);
+        FUNCTION_HARNESS_PARAM(TIME_MSEC, param.latency);
+        FUNCTION_HARNESS_PARAM(UINT, param.errorInterval);
+        FUNCTION_HARNESS_PARAM(UINT64, param.bytesPerSec);
+        FUNCTION_HARNESS_PARAM(UINT, param.listMax);
+    FUNCTION_HARNESS_END();
+
+    ASSERT(path != NULL);
+    ASSERT(port >= HRN_SERVER_PORT_MIN);
+
+    // Stop the server on SIGTERM. SA_RESTART is not set so accept() will be interrupted.
+    struct sigaction action = {.sa_handler = hrnObjStoreSignal};
+    THROW_ON_SYS_ERROR(sigaction(SIGTERM, &action, NULL) == -1, KernelError, "unable to set object store signal handler");
+
+    const Storage *const storage = storagePosixNewP(path, .write = true);
+    IoServer *const tlsServer = tlsServerNew(
+        hrnServerHost(), NULL, strNewFmt("%s/" HRN_SERVER_CERT_PREFIX "server.key", hrnPathRepo()),
+        strNewFmt("%s/" HRN_SERVER_CERT_PREFIX "server.crt", hrnPathRepo()), HRN_OBJ_STORE_TIMEOUT);
+    IoServer *const socketServer = sckServerNew(STRDEF("127.0.0.1"), port, HRN_OBJ_STORE_TIMEOUT);
+    List *const processList = lstNewP(sizeof(pid_t));
+
+    // Serve each connection in a separate process so the client can have as many concurrent connections as it needs
+    while (!hrnObjStoreLocal.stop)
+    {
+        IoSession *const socketSession = ioServerAccept(socketServer, NULL);
+
+        if (socketSession == NULL || hrnObjStoreLocal.stop)
+        {
+            ioSessionFree(socketSession);
+            continue;
+        }
+
+        const pid_t processId = fork();
+
+        if (processId == 0)
+        {
+            signal(SIGTERM, SIG_DFL);
+
+            // Errors are expected when the client drops the connection so they are ignored
+            TRY_BEGIN()
+            {
+                hrnObjStoreSession(ioServerAccept(tlsServer, socketSession), storage, param);
+            }
+            CATCH_ANY()
+            {
+            }
+            TRY_END();
+
+            exit(0);
+        }
+
+        THROW_ON_SYS_ERROR(processId == -1, KernelError, "unable to fork object store session");
+
+        lstAdd(processList, &processId);
+        ioSessionFree(socketSession);
+
+        // Reap sessions that have completed
+        while (waitpid(-1, NULL, WNOHANG) > 0);
+    }
+
+    // Stop any sessions still running and wait for them to exit
+    for (unsigned int processIdx = 0; processIdx < lstSize(processList); processIdx++)
+        kill(*(pid_t *)lstGet(processList, processIdx), SIGTERM);
+
+    while (waitpid(-1, NULL, 0) > 0);
+
+    ioServerFree(tlsServer);
+    ioServerFree(socketServer);
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
+
+/**********************************************************************************************************************************/
+void
+hrnObjStoreStop(const pid_t pid, const unsigned int port)
+{
+    FUNCTION_HARNESS_BEGIN();
+        FUNCTION_HARNESS_PARAM(INT, pid);
+        FUNCTION_HARNESS_PARAM(UINT, port);
+    FUNCTION_HARNESS_END();
+
+    THROW_ON_SYS_ERROR(kill(pid, SIGTERM) == -1, KernelError, "unable to signal object store");
+
+    // Connect to the server in case the signal arrived before accept() was called
+    TRY_BEGIN()
+    {
+        ioSessionFree(ioClientOpen(sckClientNew(STRDEF("127.0.0.1"), port, HRN_OBJ_STORE_TIMEOUT, HRN_OBJ_STORE_TIMEOUT)));
+    }
+    CATCH_ANY()
+    {
+    }
+    TRY_END();
+
+    FUNCTION_HARNESS_RETURN_VOID();
+}
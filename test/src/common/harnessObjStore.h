@@ -0,0 +1,38 @@
+/***********************************************************************************************************************************
+Object Store Test Harness
+
+Local S3-compatible server for measuring object store driver performance. Only the subset of the S3 API used by the driver is
+implemented (get, head, put, delete, multi-delete, list, and multipart upload) and request signatures are not checked. Objects are
+stored as files under the path passed to hrnObjStoreRun() so each connection can be served by a separate process. Latency, bandwidth
+limits, and throttling (503 SlowDown) can be injected to simulate real object stores.
+***********************************************************************************************************************************/
+#ifndef TEST_COMMON_HARNESS_OBJ_STORE_H
+#define TEST_COMMON_HARNESS_OBJ_STORE_H
+
+#include <sys/types.h>
+
+#include "common/time.h"
+#include "common/type/string.h"
+
+/***********************************************************************************************************************************
+Functions
+***********************************************************************************************************************************/
+// Run server until hrnObjStoreStop() is called. This function should be called in a forked process.
+typedef struct HrnObjStoreRunParam
+{
+    VAR_PARAM_HEADER;
+    TimeMSec latency;                                               // Delay before each response is sent
+    unsigned int errorInterval;                                     // Reply 503 SlowDown to every Nth request (0 disables)
+    uint64_t bytesPerSec;                                           // Limit content transfer rate per connection (0 disables)
+    unsigned int listMax;                                           // Maximum keys per list page (0 uses the S3 default of 1000)
+} HrnObjStoreRunParam;
+
+#define hrnObjStoreRunP(path, port, ...)                                                                                           \
+    hrnObjStoreRun(path, port, (HrnObjStoreRunParam){VAR_PARAM_INIT, __VA_ARGS__})
+
+void hrnObjStoreRun(const String *path, unsigned int port, HrnObjStoreRunParam param);
+
+// Stop the server running in the specified process
+void hrnObjStoreStop(pid_t pid, unsigned int port);
+
+#endif
@@ -349,7 +349,7 @@ hrnStorageWriteTestNew(
 
         StorageWrite *const posix = storageWritePosixNew(
             storageDriver(storagePosix), name, modeFile, modePath, user, group, timeModified, createPath, false, false, false,
-            truncate);
+            false, truncate, false, 0);
 
         // Copy the interface and update with our functions
         StorageWriteInterface interface = *storageWriteInterface(posix);
@@ -365,7 +365,7 @@ hrnStorageWriteTestNew(
             .version = storageWriteIo(
                 storageWritePosixNew(
                     storageDriver(storagePosix), hrnStorageTestVersionFind(storagePosix, name), modeFile, modePath, user, group,
-                    timeModified, createPath, false, false, false, truncate)),
+                    timeModified, createPath, false, false, false, false, truncate, false, 0)),
         };
     }
     OBJ_NEW_END();
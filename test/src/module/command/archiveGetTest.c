@@ -467,6 +467,88 @@ testRun(void)
             storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
             .remove = true);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("persisted WAL path list is used when it contains the requested segments");
+
+        // Remove read permission on the WAL path so the segments can only be found using the persisted list
+        HRN_STORAGE_MODE(storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/0000000100000001", .mode = 0300);
+
+        argList = strLstDup(argBaseList);
+        strLstAddZ(argList, "0000000100000001000000FE");
+        strLstAddZ(argList, "0000000100000001000000FF");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 0000000100000001000000FE...0000000100000001000000FF\n"
+            "P01 DETAIL: found 0000000100000001000000FE in the repo1: 10-1 archive\n"
+            "P01 DETAIL: found 0000000100000001000000FF in the repo1: 10-1 archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/0000000100000001000000FE", .remove = true);
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/0000000100000001000000FF", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        HRN_STORAGE_MODE(storageRepoIdxWrite(0), STORAGE_REPO_ARCHIVE "/10-1/0000000100000001");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("persisted WAL path list is removed when a segment in the list is missing");
+
+        argList = strLstDup(argBaseList);
+        strLstAddZ(argList, "000000010000000200000000");
+        strLstAddZ(argList, "000000010000000200000001");
+        HRN_CFG_LOAD(cfgCmdArchiveGet, argList, .role = cfgCmdRoleAsync);
+
+        HRN_STORAGE_PUT_EMPTY(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000200000000...000000010000000200000001\n"
+            "P01 DETAIL: found 000000010000000200000000 in the repo1: 10-1 archive\n"
+            "P00 DETAIL: unable to find 000000010000000200000001 in the archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000", .remove = true);
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000001.ok", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
+        TEST_STORAGE_EXISTS(
+            storageRepoWrite(), STORAGE_REPO_ARCHIVE "/10-1/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa",
+            .remove = true);
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000200000000...000000010000000200000001\n"
+            "P01   WARN: [FileReadError] raised from local-1 shim protocol: unable to get 000000010000000200000000:\n"
+            "            repo1: 10-1/0000000100000002/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+            " [FileMissingError] unable to open missing file '" TEST_PATH "/repo/archive/test2/10-1/0000000100000002"
+            "/000000010000000200000000-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa' for read\n"
+            "P00 DETAIL: unable to find 000000010000000200000001 in the archive");
+
+        TEST_RESULT_BOOL(storageExistsP(storageSpool(), STRDEF(STORAGE_SPOOL_ARCHIVE "/archive-get.list")), false, "no list");
+        TEST_STORAGE_LIST(
+            storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN,
+            "000000010000000200000000.error\n"
+            "000000010000000200000001.ok\n",
+            .remove = true);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("invalid persisted WAL path list is ignored");
+
+        HRN_STORAGE_PUT_Z(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE "/archive-get.list", "BOGUS");
+
+        TEST_RESULT_VOID(cmdArchiveGetAsync(), "archive async");
+
+        TEST_RESULT_LOG(
+            "P00   INFO: get 2 WAL file(s) from archive: 000000010000000200000000...000000010000000200000001\n"
+            "P00 DETAIL: unable to load WAL path list cache: [FormatError] unexpected EOF\n"
+            "P00 DETAIL: unable to find 000000010000000200000000 in the archive");
+
+        TEST_STORAGE_GET_EMPTY(storageSpoolWrite(), STORAGE_SPOOL_ARCHIVE_IN "/000000010000000200000000.ok", .remove = true);
+        TEST_STORAGE_LIST_EMPTY(storageSpool(), STORAGE_SPOOL_ARCHIVE_IN);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("warn on invalid file");
 
@@ -64,9 +64,9 @@ testBackupValidateFile(
         StorageRead *read = storageNewReadP(
             storage, strNewFmt("%s/%s", strZ(path), strZ(fileName)), .offset = file.bundleOffset,
             .limit = VARUINT64(file.sizeRepo));
-        const Buffer *const checksum = cryptoHashOne(hashTypeSha1, storageGetP(read));
+        const Buffer *const checksum = cryptoHashOne(manifestData->backupOptionChecksumType, storageGetP(read));
 
-        if (!bufEq(checksum, BUF(file.checksumRepoSha1, HASH_TYPE_SHA1_SIZE)))
+        if (!bufEq(checksum, BUF(file.checksumRepoSha1, manifestChecksumSize(manifest))))
             THROW_FMT(AssertError, "'%s' repo checksum does match manifest", strZ(file.name));
     }
 
@@ -157,7 +157,7 @@ testBackupValidateFile(
 
         strCatFmt(result, ", m=%s}", strZ(mapLog));
 
-        checksum = cryptoHashOne(hashTypeSha1, fileBuffer);
+        checksum = cryptoHashOne(manifestData->backupOptionChecksumType, fileBuffer);
     }
     // Else normal file
     else
@@ -181,7 +181,7 @@ testBackupValidateFile(
                 decompressFilterP(manifestData->backupOptionCompressType, .raw = raw));
         }
 
-        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(read)), cryptoHashNew(hashTypeSha1));
+        ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(read)), cryptoHashNew(manifestData->backupOptionChecksumType));
 
         size = bufUsed(storageGetP(read));
         checksum = pckReadBinP(
@@ -189,7 +189,7 @@ testBackupValidateFile(
     }
 
     // Validate checksum
-    if (!bufEq(checksum, BUF(file.checksumSha1, HASH_TYPE_SHA1_SIZE)))
+    if (!bufEq(checksum, BUF(file.checksumSha1, manifestChecksumSize(manifest))))
         THROW_FMT(AssertError, "'%s' checksum does match manifest", strZ(file.name));
 
     // Test size and repo-size
@@ -735,6 +735,23 @@ testRun(void)
         TEST_RESULT_UINT(segmentNumber(STRDEF("999.123")), 123, "Segment number");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("backupProcessFileCompressLong()"))
+    {
+        TEST_RESULT_BOOL(
+            backupProcessFileCompressLong(true, backupTypeFull, BACKUP_COMPRESS_LONG_SIZE_MIN, false), true, "large full");
+        TEST_RESULT_BOOL(
+            backupProcessFileCompressLong(true, backupTypeFull, BACKUP_COMPRESS_LONG_SIZE_MIN - 1, false), false, "small full");
+        TEST_RESULT_BOOL(
+            backupProcessFileCompressLong(true, backupTypeDiff, BACKUP_COMPRESS_LONG_SIZE_MIN, false), false, "large diff");
+        TEST_RESULT_BOOL(
+            backupProcessFileCompressLong(true, backupTypeIncr, BACKUP_COMPRESS_LONG_SIZE_MIN, false), false, "large incr");
+        TEST_RESULT_BOOL(
+            backupProcessFileCompressLong(true, backupTypeFull, BACKUP_COMPRESS_LONG_SIZE_MIN, true), false, "block incremental");
+        TEST_RESULT_BOOL(
+            backupProcessFileCompressLong(false, backupTypeFull, BACKUP_COMPRESS_LONG_SIZE_MIN, false), false, "disabled");
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("BlockMap"))
     {
@@ -1816,6 +1833,27 @@ testRun(void)
         TEST_STORAGE_LIST_EMPTY(storageRepo(), STORAGE_REPO_BACKUP, .comment = "check backup path removed");
 
         manifestResume->pub.data.backupOptionCompressType = compressTypeNone;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("cannot resume when checksum type does not match");
+
+        manifestResume->pub.data.backupOptionChecksumType = hashTypeXxHash;
+
+        manifestSave(
+            manifestResume,
+            storageWriteIo(
+                storageNewWriteP(
+                    storageRepoWrite(), STRDEF(STORAGE_REPO_BACKUP "/20191003-105320F/" BACKUP_MANIFEST_FILE INFO_COPY_EXT))));
+
+        TEST_RESULT_PTR(backupResumeFind(manifest, NULL), NULL, "find resumable backup");
+
+        TEST_RESULT_LOG(
+            "P00   WARN: backup '20191003-105320F' cannot be resumed:"
+            " new checksum type 'sha1' does not match resumable checksum type 'xxhash'");
+
+        TEST_STORAGE_LIST_EMPTY(storageRepo(), STORAGE_REPO_BACKUP, .comment = "check backup path removed");
+
+        manifestResume->pub.data.backupOptionChecksumType = hashTypeSha1;
     }
 
     // *****************************************************************************************************************************
@@ -1966,6 +2004,7 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptRepoRetentionFull, "1");
         hrnCfgArgRawBool(argList, cfgOptOnline, false);
         hrnCfgArgRawBool(argList, cfgOptCompress, true);
+        hrnCfgArgRawStrId(argList, cfgOptChecksumType, hashTypeXxHash);
         hrnCfgArgRawStrId(argList, cfgOptType, backupTypeDiff);
         HRN_CFG_LOAD(cfgCmdBackup, argList);
 
@@ -1973,7 +2012,8 @@ testRun(void)
 
         TEST_RESULT_LOG(
             "P00   INFO: last backup label = [FULL-1], version = " PROJECT_VERSION "\n"
-            "P00   WARN: diff backup cannot alter compress-type option to 'gz', reset to value in [FULL-1]");
+            "P00   WARN: diff backup cannot alter compress-type option to 'gz', reset to value in [FULL-1]\n"
+            "P00   WARN: diff backup cannot alter checksum-type option to 'xxhash', reset to value in [FULL-1]");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("offline incr backup to test unresumable backup");
@@ -2132,6 +2172,7 @@ testRun(void)
 
         // Replace checksums since they can differ between architectures (e.g. 32/64 bit)
         hrnLogReplaceAdd("\\) checksum [a-f0-9]{40}", "[a-f0-9]{40}$", "SHA1", false);
+        hrnLogReplaceAdd("\\) checksum [a-f0-9]{32}([^a-f0-9]|$)", "[a-f0-9]{32}", "XXHASH", false);
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("online 9.5 resume uncompressed full backup");
@@ -2172,7 +2213,8 @@ testRun(void)
 
             // Create a backup manifest that looks like a halted backup manifest
             Manifest *manifestResume = manifestNewBuild(
-                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL);
+                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL);
 
             manifestResume->pub.data.backupType = backupTypeFull;
             const String *resumeLabel = backupLabelCreate(backupTypeFull, NULL, backupTimeStart);
@@ -2250,7 +2292,8 @@ testRun(void)
 
             // Create a backup manifest that looks like a halted backup manifest
             Manifest *manifestResume = manifestNewBuild(
-                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL);
+                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL);
 
             manifestResume->pub.data.backupType = backupTypeFull;
             manifestResume->pub.data.backupOptionCompressType = compressTypeGz;
@@ -2410,7 +2453,8 @@ testRun(void)
 
             // Create a backup manifest that looks like a halted backup manifest
             Manifest *manifestResume = manifestNewBuild(
-                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL);
+                storagePg(), PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL);
 
             manifestResume->pub.data.backupOptionCompressType = compressTypeGz;
             const String *resumeLabel = backupLabelCreate(backupTypeFull, NULL, backupTimeStart - 100000);
@@ -2922,6 +2966,13 @@ testRun(void)
             hrnCfgArgRawBool(argList, cfgOptRepoHardlink, true);
             hrnCfgArgRawZ(argList, cfgOptManifestSaveThreshold, "1");
             hrnCfgArgRawBool(argList, cfgOptArchiveCopy, true);
+            hrnCfgArgRawZ(argList, cfgOptCompressThread, "2");
+            hrnCfgArgRawZ(argList, cfgOptCompressThreadSize, "8KiB");
+            hrnCfgArgRawBool(argList, cfgOptCompressLong, true);
+            hrnCfgArgRawBool(argList, cfgOptCompressAdapt, true);
+            hrnCfgArgRawBool(argList, cfgOptCompressSeek, true);
+            hrnCfgArgRawBool(argList, cfgOptPipeline, true);
+            hrnCfgArgRawZ(argList, cfgOptPipelineSize, "8KiB");
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
             // Move pg1-path and put a link in its place. This tests that backup works when pg1-path is a symlink yet should be
@@ -3216,6 +3267,7 @@ testRun(void)
             hrnCfgArgRawZ(argList, cfgOptAnnotation, "extra key=this is an annotation");
             hrnCfgArgRawZ(argList, cfgOptAnnotation, "source=this is another annotation");
             hrnCfgArgRawZ(argList, cfgOptPgVersionForce, "11");
+            hrnCfgArgRawStrId(argList, cfgOptChecksumType, hashTypeXxHash);
             HRN_CFG_LOAD(cfgCmdBackup, argList);
 
             // Create pg_control with unexpected catalog and control version
@@ -3260,16 +3312,16 @@ testRun(void)
                 "P00   INFO: check archive for segment 0000000105DB8EB000000000\n"
                 "P00 DETAIL: store zero-length file " TEST_PATH "/pg1/zero\n"
                 "P00 DETAIL: store zero-length file " TEST_PATH "/pg1/pg_tblspc/32768/PG_11_201809051/1/5\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/base/1/2 (24KB, [PCT]) checksum [SHA1]\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/base/1/1 (8KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/base/1/2 (24KB, [PCT]) checksum [XXHASH]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/base/1/1 (8KB, [PCT]) checksum [XXHASH]\n"
                 "P00   WARN: page misalignment in file " TEST_PATH "/pg1/base/1/1: file size 8207 is not divisible by page size"
                 " 8192\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/stuff.conf (bundle 1/0, 12B, [PCT]) checksum [SHA1]\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/postgresql.auto.conf (bundle 1/32, 12B, [PCT]) checksum [SHA1]\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/postgresql.conf (bundle 1/64, 11B, [PCT]) checksum [SHA1]\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/PG_VERSION (bundle 1/95, 2B, [PCT]) checksum [SHA1]\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/bigish.dat (bundle 2/0, 8KB, [PCT]) checksum [SHA1]\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/pg_control (bundle 3/0, 8KB, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/stuff.conf (bundle 1/0, 12B, [PCT]) checksum [XXHASH]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/postgresql.auto.conf (bundle 1/32, 12B, [PCT]) checksum [XXHASH]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/postgresql.conf (bundle 1/64, 11B, [PCT]) checksum [XXHASH]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/PG_VERSION (bundle 1/95, 2B, [PCT]) checksum [XXHASH]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/bigish.dat (bundle 2/0, 8KB, [PCT]) checksum [XXHASH]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/pg_control (bundle 3/0, 8KB, [PCT]) checksum [XXHASH]\n"
                 "P00   INFO: execute non-exclusive backup stop and wait for all WAL segments to archive\n"
                 "P00   INFO: backup stop archive = 0000000105DB8EB000000001, lsn = 5db8eb0/180000\n"
                 "P00 DETAIL: wrote 'backup_label' file returned from backup stop function\n"
@@ -3343,13 +3395,14 @@ testRun(void)
 
             TEST_RESULT_LOG(
                 "P00   INFO: last backup label = 20191030-014640F, version = " PROJECT_VERSION "\n"
+                "P00   WARN: diff backup cannot alter checksum-type option to 'sha1', reset to value in 20191030-014640F\n"
                 "P00   WARN: diff backup cannot alter 'checksum-page' option to 'false', reset to 'true' from 20191030-014640F\n"
                 "P00   INFO: execute non-exclusive backup start: backup begins after the next regular checkpoint completes\n"
                 "P00   INFO: backup start archive = 0000000105DBBF8000000000, lsn = 5dbbf80/0\n"
                 "P00   INFO: check archive for segment 0000000105DBBF8000000000\n"
                 "P00 DETAIL: store zero-length file " TEST_PATH "/pg1/zero\n"
-                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/pg_control (bundle 1/0, 8KB, [PCT]) checksum [SHA1]\n"
-                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/PG_VERSION (2B, [PCT]) checksum [SHA1]\n"
+                "P01 DETAIL: backup file " TEST_PATH "/pg1/global/pg_control (bundle 1/0, 8KB, [PCT]) checksum [XXHASH]\n"
+                "P01 DETAIL: match file from prior backup " TEST_PATH "/pg1/PG_VERSION (2B, [PCT]) checksum [XXHASH]\n"
                 "P00 DETAIL: reference pg_data/PG_VERSION to 20191030-014640F\n"
                 "P00   INFO: execute non-exclusive backup stop and wait for all WAL segments to archive\n"
                 "P00   INFO: backup stop archive = 0000000105DBBF8000000001, lsn = 5dbbf80/300000\n"
@@ -4,6 +4,8 @@ Test Common Command Routines
 #include <fcntl.h>
 #include <unistd.h>
 
+#include "common/io/filter/size.h"
+#include "common/io/filter/stat.h"
 #include "common/stat.h"
 #include "version.h"
 
@@ -127,6 +129,19 @@ testRun(void)
             "P00 DETAIL: statistics: {\"test\":{\"total\":1}}\n"
             "P00   INFO: restore command end: completed successfully");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("command end with filter stats");
+
+        ioFilterStatAdd(
+            SIZE_FILTER_TYPE, &(IoFilterStat){.bytesIn = 2 * 1024 * 1024, .timeCpu = 5 * 1000000, .timeWall = 7 * 1000000});
+
+        TEST_RESULT_VOID(cmdEnd(0, NULL), "command end");
+        TEST_RESULT_LOG(
+            "P00   INFO: filter size: in 2MB, out 0B, cpu 5ms, wall 7ms\n"
+            "P00 DETAIL: statistics: {\"filter.size.bytes-in\":{\"total\":2097152},\"filter.size.bytes-out\":{\"total\":0},"
+            "\"filter.size.cpu-ms\":{\"total\":5},\"filter.size.wall-ms\":{\"total\":7},\"test\":{\"total\":1}}\n"
+            "P00   INFO: restore command end: completed successfully");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("switch to a new command so some options are not valid");
 
@@ -226,6 +226,10 @@ testRun(void)
             "\n"
             "  --archive-mode                      preserve or disable archiving on restored\n"
             "                                      cluster [default=preserve]\n"
+            "  --block-incr-verify                 verify block incremental files after\n"
+            "                                      restore [default=y]\n"
+            "  --bundle-gap                        maximum gap to read through when\n"
+            "                                      restoring bundled files [default=1MiB]\n"
             "  --db-exclude                        restore excluding the specified databases\n"
             "  --db-include                        restore only specified databases\n"
             "                                      [current=db1, db2]\n"
@@ -233,9 +237,15 @@ testRun(void)
             "  --link-all                          restore all symlinks [default=n]\n"
             "  --link-map                          modify the destination of a symlink\n"
             "                                      [current=/link1=/dest1, /link2=/dest2]\n"
+            "  --preallocate                       preallocate space for restored files\n"
+            "                                      [default=n]\n"
             "  --recovery-option                   set an option in postgresql.auto.conf or\n"
             "                                      recovery.conf\n"
             "  --set                               backup set to restore [default=latest]\n"
+            "  --sparse                            restore all-zero pages as holes\n"
+            "                                      [default=n]\n"
+            "  --stripe                            stripe restore across repositories\n"
+            "                                      [default=n]\n"
             "  --tablespace-map                    restore a tablespace into the specified\n"
             "                                      directory\n"
             "  --tablespace-map-all                restore all tablespaces into the\n"
@@ -265,6 +275,7 @@ testRun(void)
             "                                      files [default=/etc/pgbackrest]\n"
             "  --delta                             restore or backup using checksums\n"
             "                                      [default=n]\n"
+            "  --filter-stat                       collect filter statistics [default=n]\n"
             "  --io-timeout                        I/O timeout [default=1m]\n"
             "  --lock-path                         path where lock files are stored\n"
             "                                      [default=/tmp/pgbackrest]\n"
@@ -355,6 +366,7 @@ testRun(void)
             "  --repo-sftp-private-key-file        SFTP private key file\n"
             "  --repo-sftp-private-key-passphrase  SFTP private key passphrase\n"
             "  --repo-sftp-public-key-file         SFTP public key file\n"
+            "  --repo-sftp-window-size             SFTP request window size\n"
             "  --repo-storage-ca-file              repository storage CA file\n"
             "  --repo-storage-ca-path              repository storage CA path\n"
             "  --repo-storage-host                 repository storage host\n"
@@ -1,6 +1,8 @@
 /***********************************************************************************************************************************
 Test Repo Commands
 ***********************************************************************************************************************************/
+#include "common/compress/helper.h"
+#include "common/compress/zst/seek.h"
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
 #include "storage/posix/storage.h"
@@ -814,6 +816,141 @@ testRun(void)
         TEST_RESULT_INT(storageGetProcess(ioBufferWriteNew(writeBuffer)), 0, "get");
         TEST_RESULT_BOOL(bufEq(writeBuffer, backupLabelBuffer), true, "get matches put");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get range with raw error");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawBool(argList, cfgOptRaw, true);
+        hrnCfgArgRawZ(argList, cfgOptOffset, "1");
+        strLstAddZ(argList, "seek.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        TEST_ERROR(
+            storageGetProcess(ioBufferWriteNew(bufNew(0))), OptionInvalidError,
+            "option 'offset' and 'limit' cannot be used with 'raw'");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get range from encrypted repo error");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawStrId(argList, cfgOptRepoCipherType, cipherTypeAes256Cbc);
+        hrnCfgArgRawZ(argList, cfgOptLimit, "1");
+        strLstAddZ(argList, "seek.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        TEST_ERROR(
+            storageGetProcess(ioBufferWriteNew(bufNew(0))), OptionInvalidError,
+            "option 'offset' and 'limit' cannot be used with an encrypted repository");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get range ignore missing file");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawBool(argList, cfgOptIgnoreMissing, true);
+        hrnCfgArgRawZ(argList, cfgOptLimit, "1");
+        strLstAddZ(argList, BOGUS_STR);
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        TEST_RESULT_INT(storageGetProcess(ioBufferWriteNew(bufNew(0))), 1, "get");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get range from file that is not seekable");
+
+        const Storage *const storageTest = storagePosixNewP(TEST_PATH_STR, .write = true);
+
+        HRN_STORAGE_PUT_Z(storageTest, "repo/short.zst", "SHORT");
+        HRN_STORAGE_PUT_Z(storageTest, "repo/plain.zst", "NOT A SEEKABLE FILE");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptLimit, "1");
+        strLstAddZ(argList, "short.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        TEST_ERROR(
+            storageGetProcess(ioBufferWriteNew(bufNew(0))), FormatError, "'short.zst' is not a seekable zst file");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptLimit, "1");
+        strLstAddZ(argList, "plain.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        TEST_ERROR(
+            storageGetProcess(ioBufferWriteNew(bufNew(0))), FormatError, "'plain.zst' is not a seekable zst file");
+
+        // Footer for a seek table that is larger than the file
+        HRN_STORAGE_PUT(storageTest, "repo/truncated.zst", BUF("\xE8\x03\x00\x00\x00\xB1\xEA\x92\x8F", 9));
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptLimit, "1");
+        strLstAddZ(argList, "truncated.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        TEST_ERROR(
+            storageGetProcess(ioBufferWriteNew(bufNew(0))), FormatError, "zst seek table requires 8017 bytes but 9 provided");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get range from seekable file");
+
+        // Three frames, the last one partial
+        Buffer *const seekBuffer = bufNew(ZST_SEEK_FRAME_SIZE * 5 / 2);
+
+        bufUsedSet(seekBuffer, bufSize(seekBuffer));
+
+        for (size_t seekIdx = 0; seekIdx < bufSize(seekBuffer); seekIdx++)
+            bufPtr(seekBuffer)[seekIdx] = (unsigned char)(seekIdx % 251);
+
+        StorageWrite *const seekWrite = storageNewWriteP(storageTest, STRDEF("repo/seek.zst"));
+        ioFilterGroupAdd(ioWriteFilterGroup(storageWriteIo(seekWrite)), compressFilterP(compressTypeZst, 1, .seek = true));
+        storagePutP(seekWrite, seekBuffer);
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptOffset, "1048566");
+        hrnCfgArgRawZ(argList, cfgOptLimit, "20");
+        strLstAddZ(argList, "seek.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        writeBuffer = bufNew(0);
+        TEST_RESULT_INT(storageGetProcess(ioBufferWriteNew(writeBuffer)), 0, "get range spanning frames");
+        TEST_RESULT_BOOL(bufEq(writeBuffer, BUF(bufPtrConst(seekBuffer) + 1048566, 20)), true, "range matches");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptOffset, "2097152");
+        strLstAddZ(argList, "seek.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        writeBuffer = bufNew(0);
+        TEST_RESULT_INT(storageGetProcess(ioBufferWriteNew(writeBuffer)), 0, "get range to end of file");
+        TEST_RESULT_BOOL(bufEq(writeBuffer, BUF(bufPtrConst(seekBuffer) + 2097152, 524288)), true, "range matches");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptOffset, "2621430");
+        hrnCfgArgRawZ(argList, cfgOptLimit, "1MiB");
+        strLstAddZ(argList, "seek.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        writeBuffer = bufNew(0);
+        TEST_RESULT_INT(storageGetProcess(ioBufferWriteNew(writeBuffer)), 0, "get range with limit past end of file");
+        TEST_RESULT_BOOL(bufEq(writeBuffer, BUF(bufPtrConst(seekBuffer) + 2621430, 10)), true, "range matches");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptRepoPath, TEST_PATH "/repo");
+        hrnCfgArgRawZ(argList, cfgOptOffset, "3MiB");
+        strLstAddZ(argList, "seek.zst");
+        HRN_CFG_LOAD(cfgCmdRepoGet, argList);
+
+        writeBuffer = bufNew(0);
+        TEST_RESULT_INT(storageGetProcess(ioBufferWriteNew(writeBuffer)), 0, "get range past end of file");
+        TEST_RESULT_UINT(bufUsed(writeBuffer), 0, "range is empty");
+
         // -------------------------------------------------------------------------------------------------------------------------
         // Reset env
         hrnCfgEnvKeyRemoveRaw(cfgOptRepoCipherPass, 1);
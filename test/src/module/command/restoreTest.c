@@ -262,6 +262,22 @@ testRun(void)
             "    block {no: 0, offset: 6}\n"
             "    block {no: 1, offset: 9}\n",
             "check delta");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block checksum mismatch");
+
+        BlockMap *blockMapInvalid = blockMapNewRead(
+            ioBufferReadNewOpen(BUF(bufPtr(destination) + (bufUsed(destination) - (size_t)mapSize), (size_t)mapSize)), 3, 5);
+        memset(blockMapGet(blockMapInvalid, 1)->checksum, 0, 5);
+
+        blockDelta = blockDeltaNew(blockMapInvalid, 3, 5, NULL, cipherTypeNone, NULL, compressTypeGz);
+        blockDeltaRead = blockDeltaReadGet(blockDelta, 0);
+        read = ioBufferReadNewOpen(destination);
+
+        TEST_RESULT_STR_Z(strNewBuf(blockDeltaNext(blockDelta, blockDeltaRead, read)->block), "123", "read block");
+        TEST_ERROR(
+            blockDeltaNext(blockDelta, blockDeltaRead, read), ChecksumError,
+            "block at offset 3 actual checksum 'a3844243ac' does not match expected checksum '0000000000'");
     }
 
     // *****************************************************************************************************************************
@@ -308,10 +324,161 @@ testRun(void)
         TEST_ERROR(
             restoreFile(
                 strNewFmt(STORAGE_REPO_BACKUP "/%s/%s.gz", strZ(repoFileReferenceFull), strZ(repoFile1)), repoIdx, compressTypeGz,
-                0, false, false, false, STRDEF("badpass"), NULL, fileList),
+                0, false, false, false, cipherTypeAes256Cbc, STRDEF("badpass"), hashTypeSha1, NULL, 0, true, false, fileList),
             ChecksumError,
             "error restoring 'normal': actual checksum 'd1cd8a7d11daa26814b93eb604e1d49ab4b43770' does not match expected checksum"
             " 'ffffffffffffffffffffffffffffffffffffffff'");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block incremental with more reads than are prefetched");
+
+        // Prior backup with a super block for each block
+        Buffer *const blockIncrPrior = bufNew(96);
+        memset(bufPtr(blockIncrPrior), 'A', bufSize(blockIncrPrior));
+        bufUsedSet(blockIncrPrior, bufSize(blockIncrPrior));
+
+        Buffer *const repoFilePrior = bufNew(0);
+        IoWrite *write = ioBufferWriteNew(repoFilePrior);
+        ioFilterGroupAdd(ioWriteFilterGroup(write), blockIncrNew(8, 8, 5, 0, 0, 0, NULL, NULL, NULL));
+        ioWriteOpen(write);
+        ioWrite(write, blockIncrPrior);
+        ioWriteClose(write);
+
+        size_t mapSize = (size_t)pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE));
+        HRN_STORAGE_PUT(storageRepoWrite(), STORAGE_REPO_BACKUP "/20190509F/pg_data/bi.pgbi", repoFilePrior);
+
+        // Update every other block so the blocks that are still in the prior backup each require a separate read
+        Buffer *const blockIncr = bufDup(blockIncrPrior);
+
+        for (unsigned int blockIdx = 0; blockIdx < 12; blockIdx += 2)
+            memset(bufPtr(blockIncr) + blockIdx * 8, 'B', 8);
+
+        Buffer *const repoFileBlockIncr = bufNew(0);
+        write = ioBufferWriteNew(repoFileBlockIncr);
+        ioFilterGroupAdd(
+            ioWriteFilterGroup(write),
+            blockIncrNew(8, 8, 5, 1, 0, 0, BUF(bufPtr(repoFilePrior) + bufUsed(repoFilePrior) - mapSize, mapSize), NULL, NULL));
+        ioWriteOpen(write);
+        ioWrite(write, blockIncr);
+        ioWriteClose(write);
+
+        mapSize = (size_t)pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE));
+        HRN_STORAGE_PUT(storageRepoWrite(), STORAGE_REPO_BACKUP "/20190509F_20190510I/pg_data/bi.pgbi", repoFileBlockIncr);
+
+        fileList = lstNewP(sizeof(RestoreFile));
+
+        file = (RestoreFile)
+        {
+            .name = STRDEF("bi"),
+            .checksum = cryptoHashOne(hashTypeSha1, blockIncr),
+            .size = bufUsed(blockIncr),
+            .timeModified = 1557432154,
+            .mode = 0600,
+            .offset = bufUsed(repoFileBlockIncr) - mapSize,
+            .limit = VARUINT64(mapSize),
+            .blockIncrMapSize = mapSize,
+            .blockIncrSize = 8,
+            .blockIncrChecksumSize = 5,
+            .manifestFile = STRDEF("pg_data/bi"),
+        };
+
+        lstAdd(fileList, &file);
+
+        StringList *const referenceList = strLstNew();
+        strLstAddZ(referenceList, "20190509F");
+        strLstAddZ(referenceList, "20190509F_20190510I");
+
+        TEST_RESULT_UINT(
+            ((RestoreFileResult *)lstGet(
+                restoreFile(
+                    STRDEF(STORAGE_REPO_BACKUP "/20190509F_20190510I/pg_data/bi.pgbi"), repoIdx, compressTypeNone, 0, false, false,
+                    false, cipherTypeNone, NULL, hashTypeSha1, referenceList, 0, true, false, fileList),
+                0))->blockIncrDeltaSize,
+            96, "restore file");
+        TEST_STORAGE_GET(
+            storagePg(), "bi", "BBBBBBBBAAAAAAAABBBBBBBBAAAAAAAABBBBBBBBAAAAAAAABBBBBBBBAAAAAAAABBBBBBBBAAAAAAAABBBBBBBBAAAAAAAA");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("block incremental file checksum mismatch");
+
+        ((RestoreFile *)lstGet(fileList, 0))->checksum = bufNewDecode(
+            encodingHex, STRDEF("ffffffffffffffffffffffffffffffffffffffff"));
+
+        TEST_ERROR(
+            restoreFile(
+                STRDEF(STORAGE_REPO_BACKUP "/20190509F_20190510I/pg_data/bi.pgbi"), repoIdx, compressTypeNone, 0, false, false,
+                false, cipherTypeNone, NULL, hashTypeSha1, referenceList, 0, true, false, fileList),
+            ChecksumError,
+            "error restoring 'bi': actual checksum '04d88c30a45706dae0d9be08326cd6b7d93e10f6' does not match expected checksum"
+            " 'ffffffffffffffffffffffffffffffffffffffff'");
+
+        TEST_TITLE("block incremental file checksum is not checked when verify is disabled (with preallocate)");
+
+        TEST_RESULT_UINT(
+            ((RestoreFileResult *)lstGet(
+                restoreFile(
+                    STRDEF(STORAGE_REPO_BACKUP "/20190509F_20190510I/pg_data/bi.pgbi"), repoIdx, compressTypeNone, 0, false, false,
+                    false, cipherTypeNone, NULL, hashTypeSha1, referenceList, 0, false, true, fileList),
+                0))->blockIncrDeltaSize,
+            96, "restore file");
+
+        TEST_TITLE("block incremental delta where no blocks need to be written");
+
+        // Block incremental files are never written sparse since they are written through the file descriptor
+        ((RestoreFile *)lstGet(fileList, 0))->sparse = true;
+
+        TEST_RESULT_UINT(
+            ((RestoreFileResult *)lstGet(
+                restoreFile(
+                    STRDEF(STORAGE_REPO_BACKUP "/20190509F_20190510I/pg_data/bi.pgbi"), repoIdx, compressTypeNone, 0, true, false,
+                    false, cipherTypeNone, NULL, hashTypeSha1, referenceList, 0, false, false, fileList),
+                0))->blockIncrDeltaSize,
+            0, "restore file");
+        TEST_STORAGE_GET(
+            storagePg(), "bi", "BBBBBBBBAAAAAAAABBBBBBBBAAAAAAAABBBBBBBBAAAAAAAABBBBBBBBAAAAAAAABBBBBBBBAAAAAAAABBBBBBBBAAAAAAAA");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sparse file");
+
+        Buffer *const sparseBuffer = bufNew(8192);
+        memset(bufPtr(sparseBuffer), 0, bufSize(sparseBuffer));
+        bufPtr(sparseBuffer)[8191] = 'X';
+        bufUsedSet(sparseBuffer, bufSize(sparseBuffer));
+
+        HRN_STORAGE_PUT(storageRepoWrite(), STORAGE_REPO_BACKUP "/20190509F/pg_data/sparse", sparseBuffer);
+
+        fileList = lstNewP(sizeof(RestoreFile));
+
+        file = (RestoreFile)
+        {
+            .name = STRDEF("sparse"),
+            .checksum = cryptoHashOne(hashTypeSha1, sparseBuffer),
+            .size = bufUsed(sparseBuffer),
+            .timeModified = 1557432154,
+            .mode = 0600,
+            .sparse = true,
+            .manifestFile = STRDEF("pg_data/sparse"),
+        };
+
+        lstAdd(fileList, &file);
+
+        TEST_RESULT_UINT(
+            ((RestoreFileResult *)lstGet(
+                restoreFile(
+                    STRDEF(STORAGE_REPO_BACKUP "/20190509F/pg_data/sparse"), repoIdx, compressTypeNone, 0, false, false, false,
+                    cipherTypeNone, NULL, hashTypeSha1, NULL, 0, true, false, fileList),
+                0))->result,
+            restoreResultCopy, "restore file");
+        TEST_RESULT_BOOL(bufEq(storageGetP(storageNewReadP(storagePg(), STRDEF("sparse"))), sparseBuffer), true, "check file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("files restored sparse");
+
+        TEST_RESULT_BOOL(restoreFileSparse(STRDEF("pg_data/base/1/2"), NULL), false, "sparse disabled");
+        TEST_RESULT_BOOL(restoreFileSparse(STRDEF("pg_data/base/1/2"), STRDEF("pg_data/pg_wal/")), true, "relation is sparse");
+        TEST_RESULT_BOOL(
+            restoreFileSparse(STRDEF("pg_data/pg_wal/000000010000000000000001"), STRDEF("pg_data/pg_wal/")), false,
+            "wal is not sparse");
     }
 
     // *****************************************************************************************************************************
@@ -1167,6 +1334,19 @@ testRun(void)
 
         userInitInternal();
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("restoreCleanBuildScanned()");
+
+        StringList *const targetScanned = strLstNew();
+        strLstAddZ(targetScanned, "pg_data");
+        strLstAddZ(targetScanned, "pg_tblspc/1/PG_9.5_201510051");
+
+        TEST_RESULT_BOOL(restoreCleanBuildScanned(targetScanned, STRDEF("pg_data/base")), true, "path in pg_data");
+        TEST_RESULT_BOOL(
+            restoreCleanBuildScanned(targetScanned, STRDEF("pg_tblspc/1/PG_9.5_201510051/1")), true, "path in tablespace");
+        TEST_RESULT_BOOL(restoreCleanBuildScanned(targetScanned, STRDEF("pg_tblspc/1/16384")), false, "path outside tablespace id");
+        TEST_RESULT_BOOL(restoreCleanBuildScanned(targetScanned, STRDEF("pg_data2/base")), false, "path with target prefix");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("directory with bad permissions/mode");
 
@@ -2152,6 +2332,119 @@ testRun(void)
             "HINT: was the target timeline created by promoting from a timeline < latest?");
     }
 
+    // *****************************************************************************************************************************
+    if (testBegin("restoreJob*() and restoreProgress()"))
+    {
+        List *const repoList = lstNewP(sizeof(RestoreJobRepo));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("single repo");
+
+        lstAdd(repoList, &(RestoreJobRepo){.repoIdx = 1});
+
+        TEST_RESULT_UINT(restoreJobRepoSelect(repoList, 100), 0, "select repo");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("no throughput measured");
+
+        lstAdd(repoList, &(RestoreJobRepo){.repoIdx = 0});
+
+        TEST_RESULT_UINT(restoreJobRepoSelect(repoList, 100), 0, "select first repo when nothing is running");
+
+        ((RestoreJobRepo *)lstGet(repoList, 0))->sizeRunning = 100;
+        TEST_RESULT_UINT(restoreJobRepoSelect(repoList, 100), 1, "select repo with less running");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("throughput measured");
+
+        *(RestoreJobRepo *)lstGet(repoList, 0) = (RestoreJobRepo){.repoIdx = 1, .sizeDone = 100, .timeDone = 100};
+        *(RestoreJobRepo *)lstGet(repoList, 1) = (RestoreJobRepo){.repoIdx = 0, .sizeDone = 100, .timeDone = 10};
+
+        TEST_RESULT_UINT(restoreJobRepoSelect(repoList, 100), 1, "select faster repo");
+
+        ((RestoreJobRepo *)lstGet(repoList, 1))->sizeRunning = 10000;
+        TEST_RESULT_UINT(restoreJobRepoSelect(repoList, 100), 0, "select slower repo when faster repo is busy");
+
+        lstAdd(repoList, &(RestoreJobRepo){.repoIdx = 2});
+        TEST_RESULT_UINT(restoreJobRepoSelect(repoList, 100), 2, "select unmeasured repo with average throughput");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("retried jobs");
+
+        RestoreJobData jobData = {.retryJobList = lstNewP(sizeof(ProtocolParallelJob *))};
+        ProtocolParallelJob *const job1 = protocolParallelJobNew(VARSTRDEF("job1"), PROTOCOL_COMMAND_RESTORE_FILE, NULL);
+        ProtocolParallelJob *const job2 = protocolParallelJobNew(VARSTRDEF("job2"), PROTOCOL_COMMAND_RESTORE_FILE, NULL);
+
+        lstAdd(jobData.retryJobList, &job1);
+        lstAdd(jobData.retryJobList, &job2);
+
+        TEST_RESULT_BOOL(restoreJobRetried(&jobData, job2), true, "job2 retried");
+        TEST_RESULT_BOOL(restoreJobRetried(&jobData, job2), false, "job2 no longer retried");
+        TEST_RESULT_BOOL(restoreJobRetried(&jobData, job1), true, "job1 retried");
+        TEST_RESULT_UINT(lstSize(jobData.retryJobList), 0, "no retried jobs");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("select queue");
+
+        jobData.queueList = lstNewP(sizeof(List *));
+        jobData.queueSizeList = lstNewP(sizeof(uint64_t));
+
+        for (unsigned int queueIdx = 0; queueIdx < 3; queueIdx++)
+        {
+            List *const queue = lstNewP(sizeof(ManifestFilePack *));
+            lstAdd(jobData.queueList, &queue);
+            lstAdd(jobData.queueSizeList, &(uint64_t){0});
+        }
+
+        TEST_RESULT_INT(restoreJobQueueSelect(&jobData, 0), -1, "all queues empty");
+
+        lstAdd(*(List **)lstGet(jobData.queueList, 0), &(ManifestFilePack *){NULL});
+        lstAdd(*(List **)lstGet(jobData.queueList, 1), &(ManifestFilePack *){NULL});
+        lstAdd(*(List **)lstGet(jobData.queueList, 2), &(ManifestFilePack *){NULL});
+        *(uint64_t *)lstGet(jobData.queueSizeList, 1) = 100;
+        *(uint64_t *)lstGet(jobData.queueSizeList, 2) = 100;
+
+        TEST_RESULT_INT(restoreJobQueueSelect(&jobData, 0), 0, "client queue with less remaining");
+        TEST_RESULT_INT(restoreJobQueueSelect(&jobData, 4), 1, "client queue");
+
+        lstClear(*(List **)lstGet(jobData.queueList, 0));
+
+        TEST_RESULT_INT(restoreJobQueueSelect(&jobData, 0), 1, "first queue with most remaining");
+        TEST_RESULT_INT(restoreJobQueueSelect(&jobData, 3), 2, "first queue with most remaining scanning back");
+
+        *(uint64_t *)lstGet(jobData.queueSizeList, 2) = 200;
+
+        TEST_RESULT_INT(restoreJobQueueSelect(&jobData, 0), 2, "queue with most remaining");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("progress");
+
+        harnessLogLevelSet(logLevelInfo);
+
+        RestoreProgress progress = {.sizeTotal = 1000};
+
+        TEST_RESULT_VOID(restoreProgress(&progress, 100, 1000), "progress not logged before interval");
+        TEST_RESULT_VOID(restoreProgress(&progress, 300, 30000), "progress logged");
+        TEST_RESULT_LOG("P00   INFO: restore progress 30.00% (300B of 1000B), 10B/s, estimated 0:01:10 remaining");
+        TEST_RESULT_UINT(progress.timeLast, 30000, "time last");
+        TEST_RESULT_UINT(progress.sizeLast, 300, "size last");
+
+        TEST_RESULT_VOID(restoreProgress(&progress, 900, 90000), "progress logged");
+        TEST_RESULT_LOG("P00   INFO: restore progress 90.00% (900B of 1000B), 10B/s, estimated 0:00:10 remaining");
+
+        TEST_RESULT_VOID(restoreProgress(&progress, 1000, 120000), "progress not logged when complete");
+
+        progress = (RestoreProgress){.sizeTotal = 10000};
+
+        TEST_RESULT_VOID(restoreProgress(&progress, 0, 30000), "progress logged without estimate");
+        TEST_RESULT_LOG("P00   INFO: restore progress 0.00% (0B of 9.8KB), 0B/s");
+
+        TEST_RESULT_VOID(restoreProgress(&progress, 1, 60000), "progress logged with long estimate");
+        TEST_RESULT_LOG("P00   INFO: restore progress 0.01% (1B of 9.8KB), 0B/s, estimated 166:39:00 remaining");
+
+        harnessLogLevelReset();
+    }
+
     // *****************************************************************************************************************************
     if (testBegin("cmdRestore()"))
     {
@@ -2296,6 +2589,7 @@ testRun(void)
                 "P01 DETAIL: restore file " TEST_PATH "/pg/PG_VERSION (4B, 100.00%%) checksum"
                 " d3b57b066120b2abc25be3bac96c87cfc8d82a6c\n"
                 "P00   INFO: write " TEST_PATH "/pg/recovery.conf\n"
+                "P00 DETAIL: sync filesystem '" TEST_PATH "/pg'\n"
                 "P00 DETAIL: sync path '" TEST_PATH "/pg'\n"
                 "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc'\n"
                 "P00   WARN: backup does not contain 'global/pg_control' -- cluster will not start\n"
@@ -2462,6 +2756,8 @@ testRun(void)
             "P01 DETAIL: restore file " TEST_PATH "/pg/pg_tblspc/1/16384/PG_VERSION (4B, 100.00%)"
             " checksum d3b57b066120b2abc25be3bac96c87cfc8d82a6c\n"
             "P00   WARN: recovery type is preserve but recovery file does not exist at '" TEST_PATH "/pg/recovery.conf'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/pg'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/ts/1'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc/1'\n"
@@ -2533,6 +2829,8 @@ testRun(void)
             "P01 DETAIL: restore file " TEST_PATH "/pg/pg_tblspc/1/16384/PG_VERSION (4B, [PCT])"
             " checksum d3b57b066120b2abc25be3bac96c87cfc8d82a6c\n"
             "P00   WARN: recovery type is preserve but recovery file does not exist at '" TEST_PATH "/pg/recovery.conf'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/pg'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/ts/1'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/pg_tblspc/1'\n"
@@ -2588,6 +2886,10 @@ testRun(void)
         hrnCfgArgRawZ(argList, cfgOptLinkMap, "postgresql.conf=../config/postgresql.conf");
         hrnCfgArgRawZ(argList, cfgOptLinkMap, "pg_hba.conf=../config/pg_hba.conf");
         hrnCfgArgRawZ(argList, cfgOptLinkMap, "pg_xact=../xact");
+        hrnCfgArgRawZ(argList, cfgOptBufferSize, "16KiB");
+        hrnCfgArgRawZ(argList, cfgOptBundleGap, "2");               // Read through the gap before zz but not the gap after yyy
+        hrnCfgArgRawBool(argList, cfgOptPreallocate, true);
+        hrnCfgArgRawBool(argList, cfgOptSparse, true);
         HRN_CFG_LOAD(cfgCmdRestore, argList);
 
         #define TEST_LABEL_FULL                                     "20161219-212741F"
@@ -2973,6 +3275,11 @@ testRun(void)
             "P01 DETAIL: restore file " TEST_PATH "/pg/global/999 (0B, [PCT])\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/global/888 (0B, [PCT])\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/zero-length (bundle 1/16, 0B, [PCT])\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/pg'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/config'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/wal'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/ts/1'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/xact'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/config'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/base'\n"
@@ -3167,6 +3474,10 @@ testRun(void)
             "P01 DETAIL: restore file " TEST_PATH "/pg/global/999 - exists and is zero size (0B, [PCT])\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/global/888 - exists and is zero size (0B, [PCT])\n"
             "P01 DETAIL: restore file " TEST_PATH "/pg/zero-length - exists and is zero size (bundle 1/16, 0B, [PCT])\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/pg'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/config'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/wal'\n"
+            "P00 DETAIL: sync filesystem '" TEST_PATH "/ts/1'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/config'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg'\n"
             "P00 DETAIL: sync path '" TEST_PATH "/pg/base'\n"
@@ -3270,6 +3581,9 @@ testRun(void)
 
         TEST_RESULT_VOID(hrnCmdBackup(), "backup");
 
+        // Copy the repo so there is a repo without the diff backup for stripe restore
+        HRN_SYSTEM_FMT("cp -r %s " TEST_PATH "/repo-full", strZ(repoPath));
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("diff backup with block incr");
 
@@ -3315,6 +3629,7 @@ testRun(void)
         HRN_CFG_LOAD(cfgCmdRestore, argList);
 
         TEST_RESULT_VOID(cmdRestore(), "restore");
+        TEST_RESULT_LOG_EMPTY_OR_CONTAINS("repo1: [FileMissingError] unable to load info file '/bogus/backup/test1/backup.info'");
 
         TEST_STORAGE_LIST(
             storagePg(), NULL,
@@ -3329,6 +3644,125 @@ testRun(void)
             "postgresql.auto.conf\n",
             .level = storageInfoLevelType);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("stripe restore across repos");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "test1");
+        hrnCfgArgRaw(argList, cfgOptPgPath, pgPath);
+        hrnCfgArgRawZ(argList, cfgOptSpoolPath, TEST_PATH "/spool");
+        hrnCfgArgRawBool(argList, cfgOptStripe, true);
+
+        for (unsigned int repoIdx = 1; repoIdx <= 5; repoIdx++)
+        {
+            hrnCfgArgKeyRawZ(argList, cfgOptRepoCipherType, repoIdx, "aes-256-cbc");
+            hrnCfgEnvKeyRawZ(cfgOptRepoCipherPass, repoIdx, TEST_CIPHER_PASS);
+        }
+
+        // Repo with the backup set, an identical copy, a copy without the backup set, a copy where the backup set does not match,
+        // and a repo that cannot be read
+        hrnCfgArgKeyRaw(argList, cfgOptRepoPath, 1, repoPath);
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 2, TEST_PATH "/repo-copy");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 3, TEST_PATH "/repo-full");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 4, TEST_PATH "/repo-mismatch");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 5, "/bogus");
+        HRN_CFG_LOAD(cfgCmdRestore, argList);
+
+        StringList *backupList = storageListP(
+            storageRepo(), STORAGE_REPO_BACKUP_STR, .expression = backupRegExpP(.full = true, .differential = true));
+        strLstSort(backupList, sortOrderDesc);
+        const String *const backupDiff = strLstGet(backupList, 0);
+        const String *const backupFull = strLstGet(backupList, 1);
+
+        HRN_SYSTEM_FMT("cp -r %s " TEST_PATH "/repo-copy", strZ(repoPath));
+        HRN_SYSTEM_FMT("cp -r %s " TEST_PATH "/repo-mismatch", strZ(repoPath));
+        HRN_SYSTEM_FMT(
+            "cp " TEST_PATH "/repo-mismatch/backup/test1/%s/" BACKUP_MANIFEST_FILE " " TEST_PATH "/repo-mismatch/backup/test1/%s/"
+            BACKUP_MANIFEST_FILE, strZ(backupFull), strZ(backupDiff));
+
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+
+        TEST_RESULT_VOID(cmdRestore(), "restore");
+        TEST_RESULT_LOG_FMT(
+            "P00   WARN: repo4: backup set %s does not match repo1 and will not be used for restore\n"
+            "P00   WARN: repo5: [FileMissingError] unable to load info file '/bogus/backup/test1/backup.info' or"
+            " '/bogus/backup/test1/backup.info.copy':\n"
+            "            FileMissingError: unable to open missing file '/bogus/backup/test1/backup.info' for read\n"
+            "            FileMissingError: unable to open missing file '/bogus/backup/test1/backup.info.copy' for read\n"
+            "            HINT: backup.info cannot be opened and is required to perform a backup.\n"
+            "            HINT: has a stanza-create been performed?",
+            strZ(backupDiff));
+
+        TEST_STORAGE_LIST(
+            storagePg(), NULL,
+            "PG_VERSION\n"
+            "base/\n"
+            "base/1/\n"
+            "base/1/2\n"
+            "base/1/3\n"
+            "base/1/44\n"
+            "global/\n"
+            "global/pg_control\n"
+            "postgresql.auto.conf\n",
+            .level = storageInfoLevelType);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("stripe restore retries on another repo");
+
+        HRN_STORAGE_REMOVE(
+            storageRepoWrite(), zNewFmt(STORAGE_REPO_BACKUP "/%s/bundle/1", strZ(backupDiff)), .errorOnMissing = true);
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+
+        TEST_RESULT_VOID(cmdRestore(), "restore");
+        TEST_RESULT_LOG_FMT(
+            "P00   WARN: repo4: backup set %s does not match repo1 and will not be used for restore\n"
+            "P00   WARN: repo5: [FileMissingError] unable to load info file '/bogus/backup/test1/backup.info' or"
+            " '/bogus/backup/test1/backup.info.copy':\n"
+            "            FileMissingError: unable to open missing file '/bogus/backup/test1/backup.info' for read\n"
+            "            FileMissingError: unable to open missing file '/bogus/backup/test1/backup.info.copy' for read\n"
+            "            HINT: backup.info cannot be opened and is required to perform a backup.\n"
+            "            HINT: has a stanza-create been performed?\n"
+            "P00   WARN: repo1: [FileMissingError] raised from local-1 shim protocol: unable to open missing file"
+            " '" TEST_PATH "/repo/backup/test1/%s/bundle/1' for read\n"
+            "            HINT: retrying on repo2.",
+            strZ(backupDiff), strZ(backupDiff));
+
+        TEST_STORAGE_GET(storagePg(), PG_PATH_BASE "/1/3", "contents");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("stripe restore errors when all repos fail");
+
+        HRN_STORAGE_REMOVE(
+            storageTest, zNewFmt(TEST_PATH "/repo-copy/backup/test1/%s/bundle/1", strZ(backupDiff)), .errorOnMissing = true);
+        HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+
+        TEST_ERROR_FMT(
+            cmdRestore(), FileMissingError,
+            "raised from local-1 shim protocol: unable to open missing file '" TEST_PATH "/repo-copy/backup/test1/%s/bundle/1'"
+            " for read",
+            strZ(backupDiff));
+
+        // Free local processes that were not freed because of the error
+        protocolFree();
+
+        TEST_RESULT_LOG_FMT(
+            "P00   WARN: repo4: backup set %s does not match repo1 and will not be used for restore\n"
+            "P00   WARN: repo5: [FileMissingError] unable to load info file '/bogus/backup/test1/backup.info' or"
+            " '/bogus/backup/test1/backup.info.copy':\n"
+            "            FileMissingError: unable to open missing file '/bogus/backup/test1/backup.info' for read\n"
+            "            FileMissingError: unable to open missing file '/bogus/backup/test1/backup.info.copy' for read\n"
+            "            HINT: backup.info cannot be opened and is required to perform a backup.\n"
+            "            HINT: has a stanza-create been performed?\n"
+            "P00   WARN: repo1: [FileMissingError] raised from local-1 shim protocol: unable to open missing file"
+            " '" TEST_PATH "/repo/backup/test1/%s/bundle/1' for read\n"
+            "            HINT: retrying on repo2.",
+            strZ(backupDiff), strZ(backupDiff));
+
+        // Restore the diff bundle to repo1
+        HRN_SYSTEM_FMT(
+            "cp " TEST_PATH "/repo-mismatch/backup/test1/%s/bundle/1 %s/backup/test1/%s/bundle/1", strZ(backupDiff),
+            strZ(repoPath), strZ(backupDiff));
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("delta restore with block incr");
 
@@ -3343,14 +3777,9 @@ testRun(void)
         hrnCfgEnvRawZ(cfgOptRepoCipherPass, TEST_CIPHER_PASS);
         HRN_CFG_LOAD(cfgCmdRestore, argList);
 
-        // Get last diff backup label and truncate bundle/1
+        // Truncate bundle/1 in the full backup
         hrnSleepRemainder();
 
-        StringList *backupList = storageListP(
-            storageRepo(), STORAGE_REPO_BACKUP_STR, .expression = backupRegExpP(.full = true));
-        strLstSort(backupList, sortOrderDesc);
-        const String *backupFull = strLstGet(backupList, 0);
-
         HRN_STORAGE_PUT(storageRepoWrite(), strZ(strNewFmt(STORAGE_REPO_BACKUP "/%s/bundle/1", strZ(backupFull))), NULL);
 
         // Make sure restore fails with the invalid file
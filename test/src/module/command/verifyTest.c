@@ -862,20 +862,24 @@ testRun(void)
         String *filePathName = strNewZ(STORAGE_REPO_ARCHIVE "/testfile");
         HRN_STORAGE_PUT_EMPTY(storageRepoWrite(), strZ(filePathName));
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeNone, HASH_TYPE_SHA1_ZERO_BUF, 0, NULL), verifyOk, "file ok");
+            verifyFile(filePathName, 0, NULL, compressTypeNone, hashTypeSha1, HASH_TYPE_SHA1_ZERO_BUF, 0, cipherTypeNone, NULL),
+            verifyOk, "file ok");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("file size invalid in archive");
 
         HRN_STORAGE_PUT_Z(storageRepoWrite(), strZ(filePathName), fileContents);
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeNone, fileChecksum, 0, NULL), verifySizeInvalid, "file size invalid");
+            verifyFile(filePathName, 0, NULL, compressTypeNone, hashTypeSha1, fileChecksum, 0, cipherTypeNone, NULL),
+            verifySizeInvalid, "file size invalid");
 
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("file missing in archive");
 
         TEST_RESULT_UINT(
-            verifyFile(strNewFmt(STORAGE_REPO_ARCHIVE "/missingFile"), 0, NULL, compressTypeNone, fileChecksum, 0, NULL),
+            verifyFile(
+                strNewFmt(STORAGE_REPO_ARCHIVE "/missingFile"), 0, NULL, compressTypeNone, hashTypeSha1, fileChecksum, 0,
+                cipherTypeNone, NULL),
             verifyFileMissing, "file missing");
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -889,11 +893,53 @@ testRun(void)
 
         strCatZ(filePathName, ".gz");
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeGz, fileChecksum, fileSize, STRDEF("pass")),
+            verifyFile(
+                filePathName, 0, NULL, compressTypeGz, hashTypeSha1, fileChecksum, fileSize, cipherTypeAes256Cbc, STRDEF("pass")),
             verifyOk, "file encrypted compressed ok");
         TEST_RESULT_UINT(
-            verifyFile(filePathName, 0, NULL, compressTypeGz, bufNewDecode(encodingHex, STRDEF("aa")), fileSize, STRDEF("pass")),
+            verifyFile(
+                filePathName, 0, NULL, compressTypeGz, hashTypeSha1, bufNewDecode(encodingHex, STRDEF("aa")), fileSize,
+                cipherTypeAes256Cbc, STRDEF("pass")),
             verifyChecksumMismatch, "file encrypted compressed checksum mismatch");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("authenticated encrypted/compressed file in backup");
+
+        filePathName = strCatZ(strNew(), STORAGE_REPO_BACKUP "/testfile-gcm");
+        HRN_STORAGE_PUT_Z(
+            storageRepoWrite(), strZ(filePathName), fileContents, .compressType = compressTypeGz, .cipherType = cipherTypeAes256Gcm,
+            .cipherPass = "pass");
+
+        strCatZ(filePathName, ".gz");
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeGz, hashTypeSha1, fileChecksum, fileSize, cipherTypeAes256Gcm, STRDEF("pass")),
+            verifyOk, "authenticated file ok");
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeGz, hashTypeSha1, bufNewDecode(encodingHex, STRDEF("aa")), fileSize,
+                cipherTypeAes256Gcm, STRDEF("pass")),
+            verifyChecksumMismatch, "authenticated file checksum mismatch");
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeGz, hashTypeSha1, fileChecksum, fileSize + 1, cipherTypeAes256Gcm,
+                STRDEF("pass")),
+            verifySizeInvalid, "authenticated file size invalid");
+        TEST_RESULT_UINT(
+            verifyFile(
+                STRDEF(STORAGE_REPO_BACKUP "/missing-gcm"), 0, NULL, compressTypeGz, hashTypeSha1, fileChecksum, fileSize,
+                cipherTypeAes256Gcm, STRDEF("pass")),
+            verifyFileMissing, "authenticated file missing");
+
+        // Truncate the file so authentication fails
+        Buffer *const fileGcm = storageGetP(storageNewReadP(storageRepo(), filePathName));
+        bufUsedSet(fileGcm, bufUsed(fileGcm) - 1);
+        HRN_STORAGE_PUT(storageRepoWrite(), strZ(filePathName), fileGcm);
+
+        TEST_RESULT_UINT(
+            verifyFile(
+                filePathName, 0, NULL, compressTypeGz, hashTypeSha1, fileChecksum, fileSize, cipherTypeAes256Gcm, STRDEF("pass")),
+            verifyChecksumMismatch, "authentication failed");
     }
 
     // *****************************************************************************************************************************
@@ -248,6 +248,64 @@ testRun(void)
 
         TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(decompress, gzDecompressToLog, buffer, sizeof(buffer)), "gzDecompressToLog");
         TEST_RESULT_Z(buffer, "{inputSame: true, done: true, availIn: 0}", "check log");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress with threads");
+
+        // Data must be large enough to be split into more jobs than fit in the ring and end with a partial chunk
+        Buffer *const decompressed = bufNew(1024 * 1024 + 1000);
+        char *const decompressedPtr = (char *)bufPtr(decompressed);
+
+        for (unsigned int dataIdx = 0; dataIdx < bufSize(decompressed) / 8; dataIdx++)
+        {
+            char line[9];
+            snprintf(line, sizeof(line), "%07u\n", dataIdx * 7919 % 1000003);
+            memcpy(decompressedPtr + dataIdx * 8, line, 8);
+        }
+
+        bufUsedSet(decompressed, bufSize(decompressed));
+
+        Buffer *compressed = NULL;
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeGz, 6, .thread = 2), decompressed, 65536, 65536), "compress");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeGz), compressed, 65536, 65536), decompressed), true,
+            "check decompressed");
+
+        Storage *const storageTest = storagePosixNewP(TEST_PATH_STR, .write = true);
+
+        storagePutP(storageNewWriteP(storageTest, STRDEF("test.gz")), compressed);
+        HRN_SYSTEM("gzip -dc " TEST_PATH "/test.gz > " TEST_PATH "/test.out");
+        TEST_RESULT_BOOL(
+            bufEq(decompressed, storageGetP(storageNewReadP(storageTest, STRDEF("test.out")))), true, "check gzip -dc output");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress with threads and small in/out buffers");
+
+        Buffer *const decompressedSmall = bufNewC(bufPtr(decompressed), 300000);
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeGz, 6, .thread = 3), decompressedSmall, 4093, 13), "compress");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeGz), compressed, 65536, 65536), decompressedSmall), true,
+            "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress no data with threads");
+
+        TEST_ASSIGN(compressed, testCompress(compressFilterP(compressTypeGz, 6, .thread = 2), bufNew(0), 1024, 1024), "compress");
+        TEST_RESULT_UINT(
+            bufUsed(testDecompress(decompressFilterP(compressTypeGz), compressed, 1024, 1024)), 0, "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("raw compress with threads is serial");
+
+        TEST_RESULT_BOOL(
+            bufEq(
+                testCompress(compressFilterP(compressTypeGz, 6, .raw = true, .thread = 2), decompressed, 65536, 65536),
+                testCompress(compressFilterP(compressTypeGz, 6, .raw = true), decompressed, 65536, 65536)),
+            true, "same as serial");
     }
 
     // *****************************************************************************************************************************
@@ -338,6 +396,254 @@ testRun(void)
         // Run standard test suite
         testSuite(compressTypeZst, "zstd -dc", 0);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress with threads");
+
+        // Data must be large enough to be split into multiple jobs
+        Buffer *const decompressed = bufNew(16 * 1024 * 1024);
+        char *const decompressedPtr = (char *)bufPtr(decompressed);
+
+        for (unsigned int dataIdx = 0; dataIdx < bufSize(decompressed) / 16; dataIdx++)
+        {
+            char line[17];
+            snprintf(line, sizeof(line), "%015u\n", dataIdx * 7919 % 1000003);
+            memcpy(decompressedPtr + dataIdx * 16, line, 16);
+        }
+
+        bufUsedSet(decompressed, bufSize(decompressed));
+
+        Buffer *compressed = NULL;
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeZst, 3, .thread = 4), decompressed, 1024 * 1024, 65536),
+            "compress");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeZst), compressed, 65536, 1024 * 1024), decompressed), true,
+            "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("adaptive compression does not restart for compressible data");
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeZst, 3, .adapt = true), decompressed, 1024 * 1024, 65536),
+            "compress");
+        TEST_RESULT_UINT(ZSTD_findFrameCompressedSize(bufPtr(compressed), bufUsed(compressed)), bufUsed(compressed), "one frame");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeZst), compressed, 65536, 1024 * 1024), decompressed), true,
+            "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("adaptive compression restarts at minimum level for incompressible data");
+
+        Buffer *const incompressible = bufNew(8 * 1024 * 1024);
+        unsigned char *const incompressiblePtr = bufPtr(incompressible);
+        uint64_t random = 0x2545F4914F6CDD1D;
+
+        for (size_t byteIdx = 0; byteIdx < bufSize(incompressible); byteIdx++)
+        {
+            random ^= random << 13;
+            random ^= random >> 7;
+            random ^= random << 17;
+            incompressiblePtr[byteIdx] = (unsigned char)random;
+        }
+
+        bufUsedSet(incompressible, bufSize(incompressible));
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeZst, 3, .adapt = true), incompressible, 1024 * 1024, 65536),
+            "compress");
+        TEST_RESULT_BOOL(
+            ZSTD_findFrameCompressedSize(bufPtr(compressed), bufUsed(compressed)) < bufUsed(compressed), true, "two frames");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeZst), compressed, 65536, 1024 * 1024), incompressible), true,
+            "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("decompress frames that end before the output buffer is full");
+
+        // Adaptive compression ends a frame and starts a new one, so the decompressor returns at the end of the first frame with
+        // input remaining even though the output buffer is not full
+        compressed = testCompress(compressFilterP(compressTypeZst, 3), bufNewC("FRAME1", 6), 1024, 1024);
+        bufCat(compressed, testCompress(compressFilterP(compressTypeZst, 3), bufNewC("FRAME2", 6), 1024, 1024));
+
+        TEST_RESULT_STR_Z(
+            strNewBuf(testDecompress(decompressFilterP(compressTypeZst), compressed, 1024, 1024)), "FRAME1FRAME2",
+            "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("adaptive compression disabled with threads");
+
+        IoFilter *filter = compressFilterP(compressTypeZst, 3, .thread = 2, .adapt = true);
+        TEST_RESULT_BOOL(((ZstCompress *)ioFilterDriver(filter))->adapt, false, "adapt disabled");
+        ioFilterFree(filter);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("threads and long distance matching require libzstd >= 1.4.0");
+
+        TEST_RESULT_VOID(zstCompressParamCheck(4, true), "supported by current version");
+        TEST_RESULT_VOID(zstCompressParamCheckVersion(10308, 1, false), "no threads or long distance matching");
+        TEST_ERROR(
+            zstCompressParamCheckVersion(10308, 2, false), OptionInvalidValueError,
+            "compress-thread > 1 requires libzstd >= 1.4.0 but " PROJECT_NAME " was built with 1.3.8");
+        TEST_ERROR(
+            zstCompressParamCheckVersion(10308, 0, true), OptionInvalidValueError,
+            "compress-long requires libzstd >= 1.4.0 but " PROJECT_NAME " was built with 1.3.8");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("compress with long distance matching");
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeZst, 3, .longDistance = true), decompressed, 1024 * 1024, 65536),
+            "compress");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeZst), compressed, 65536, 1024 * 1024), decompressed), true,
+            "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("seekable compression");
+
+        // Input ends on a frame boundary so no empty frame should be written
+        Buffer *const seekable = bufNewC(bufPtr(decompressed), 4 * ZST_SEEK_FRAME_SIZE);
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeZst, 3, .seek = true), seekable, 1024 * 1024 - 1, 65536),
+            "compress");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeZst), compressed, 65536, 1024 * 1024), seekable), true,
+            "check decompressed");
+
+        size_t seekTableSize = 0;
+        ZstSeekTable *seekTable = NULL;
+
+        TEST_ASSIGN(seekTableSize, zstSeekTableSize(compressed), "seek table size");
+        TEST_RESULT_UINT(seekTableSize, 8 + 4 * 8 + 9, "four frames");
+        TEST_ASSIGN(seekTable, zstSeekTableNew(compressed), "seek table");
+        TEST_RESULT_UINT(zstSeekTableSizeDecompressed(seekTable), bufUsed(seekable), "decompressed size");
+
+        // Write the file so ranges can be read from storage
+        Storage *const storageTest = storagePosixNewP(TEST_PATH_STR, .write = true);
+        storagePutP(storageNewWriteP(storageTest, STRDEF("seek.zst")), compressed);
+
+        const uint64_t rangeList[][2] =
+        {
+            {0, 1},                                                 // First byte
+            {ZST_SEEK_FRAME_SIZE - 10, 20},                         // Spans two frames
+            {ZST_SEEK_FRAME_SIZE * 2, ZST_SEEK_FRAME_SIZE},         // Exactly one frame
+            {ZST_SEEK_FRAME_SIZE * 4 - 1, 1},                       // Last byte
+        };
+
+        for (unsigned int rangeIdx = 0; rangeIdx < LENGTH_OF(rangeList); rangeIdx++)
+        {
+            const uint64_t offset = rangeList[rangeIdx][0];
+            const uint64_t size = rangeList[rangeIdx][1];
+            const ZstSeekRange range = zstSeekTableRange(seekTable, offset, size);
+
+            TEST_RESULT_BOOL(range.skip < ZST_SEEK_FRAME_SIZE, true, "skip is within the first frame");
+
+            // Decompress only the frames in the range
+            StorageRead *const read = storageNewReadP(
+                storageTest, STRDEF("seek.zst"), .offset = range.offset, .limit = VARUINT64(range.size));
+            ioFilterGroupAdd(ioReadFilterGroup(storageReadIo(read)), decompressFilterP(compressTypeZst));
+
+            Buffer *const result = storageGetP(read);
+
+            TEST_RESULT_BOOL(
+                bufEq(BUF(bufPtr(result) + range.skip, (size_t)size), BUF(bufPtr(seekable) + offset, (size_t)size)), true,
+                "check range");
+        }
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("seekable compression with small in/out buffers");
+
+        Buffer *const seekableSmall = bufNewC(bufPtr(decompressed), ZST_SEEK_FRAME_SIZE + 999);
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeZst, 3, .seek = true), seekableSmall, 65537, 7), "compress");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeZst), compressed, 65536, 1024 * 1024), seekableSmall), true,
+            "check decompressed");
+
+        seekTable = zstSeekTableNew(compressed);
+        TEST_RESULT_UINT(zstSeekTableSizeDecompressed(seekTable), bufUsed(seekableSmall), "decompressed size");
+
+        const ZstSeekRange range = zstSeekTableRange(seekTable, ZST_SEEK_FRAME_SIZE, 999);
+        TEST_RESULT_UINT(range.skip, 0, "range skip");
+        TEST_RESULT_UINT(range.offset + range.size, bufUsed(compressed) - zstSeekTableSize(compressed), "range ends at seek table");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("seekable compression with no data");
+
+        TEST_ASSIGN(
+            compressed, testCompress(compressFilterP(compressTypeZst, 3, .seek = true), bufNew(0), 1024, 1024), "compress");
+        TEST_RESULT_UINT(zstSeekTableSize(compressed), 0, "no seek table");
+        TEST_RESULT_UINT(
+            bufUsed(testDecompress(decompressFilterP(compressTypeZst), compressed, 1024, 1024)), 0, "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("seekable compression restarts at end of input without writing an empty frame");
+
+        Buffer *const incompressibleSample = bufNewC(bufPtr(incompressible), 4 * ZST_SEEK_FRAME_SIZE);
+
+        TEST_ASSIGN(
+            compressed,
+            testCompress(compressFilterP(compressTypeZst, 3, .adapt = true, .seek = true), incompressibleSample, 65536, 65536),
+            "compress");
+        TEST_RESULT_UINT(zstSeekTableSize(compressed), 8 + 4 * 8 + 9, "four frames");
+        TEST_RESULT_BOOL(
+            bufEq(testDecompress(decompressFilterP(compressTypeZst), compressed, 1024, 1024), incompressibleSample), true,
+            "check decompressed");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("seek table with checksums and empty frames");
+
+        // Table with an empty frame and checksums (which are not used)
+        const unsigned char seekTableChecksum[] =
+        {
+            0x5e, 0x2a, 0x4d, 0x18, 0x2d, 0x00, 0x00, 0x00,         // Skippable frame magic and size
+            0x0a, 0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00,         // Frame 1 (10 compressed bytes, 100 decompressed bytes)
+            0xff, 0xff, 0xff, 0xff,                                 // Frame 1 checksum
+            0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,         // Frame 2 (empty)
+            0xff, 0xff, 0xff, 0xff,                                 // Frame 2 checksum
+            0x14, 0x00, 0x00, 0x00, 0xc8, 0x00, 0x00, 0x00,         // Frame 3 (20 compressed bytes, 200 decompressed bytes)
+            0xff, 0xff, 0xff, 0xff,                                 // Frame 3 checksum
+            0x03, 0x00, 0x00, 0x00, 0x80, 0xb1, 0xea, 0x92, 0x8f,   // Footer with three frames and checksum flag
+        };
+
+        TEST_RESULT_UINT(zstSeekTableSize(BUF(seekTableChecksum, sizeof(seekTableChecksum))), 53, "seek table size");
+        TEST_ASSIGN(seekTable, zstSeekTableNew(BUF(seekTableChecksum, sizeof(seekTableChecksum))), "seek table");
+        TEST_RESULT_UINT(zstSeekTableSizeDecompressed(seekTable), 300, "decompressed size");
+
+        ZstSeekRange rangeChecksum = zstSeekTableRange(seekTable, 100, 1);
+        TEST_RESULT_UINT(rangeChecksum.offset, 15, "offset skips empty frame");
+        TEST_RESULT_UINT(rangeChecksum.size, 20, "size");
+        TEST_RESULT_UINT(rangeChecksum.skip, 0, "skip");
+
+        rangeChecksum = zstSeekTableRange(seekTable, 99, 2);
+        TEST_RESULT_UINT(rangeChecksum.offset, 0, "offset");
+        TEST_RESULT_UINT(rangeChecksum.size, 35, "size includes empty frame");
+        TEST_RESULT_UINT(rangeChecksum.skip, 99, "skip");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("seek table errors");
+
+        TEST_RESULT_UINT(zstSeekTableSize(BUFSTRDEF("NOT A SEEK TABLE")), 0, "no seek table");
+        TEST_ERROR(zstSeekTableNew(BUFSTRDEF("NOT A SEEK TABLE")), FormatError, "zst seek table not found");
+        TEST_ERROR(
+            zstSeekTableNew(BUF(seekTableChecksum + 1, sizeof(seekTableChecksum) - 1)), FormatError,
+            "zst seek table requires 53 bytes but 52 provided");
+
+        Buffer *const seekTableInvalid = bufNewC(seekTableChecksum, sizeof(seekTableChecksum));
+
+        bufPtr(seekTableInvalid)[0] = 0;
+        TEST_ERROR(zstSeekTableNew(seekTableInvalid), FormatError, "zst seek table has invalid header");
+
+        bufPtr(seekTableInvalid)[0] = 0x5e;
+        bufPtr(seekTableInvalid)[4] = 0;
+        TEST_ERROR(zstSeekTableNew(seekTableInvalid), FormatError, "zst seek table has invalid header");
+
+        bufPtr(seekTableInvalid)[bufUsed(seekTableInvalid) - 5] = 0x84;
+        TEST_ERROR(zstSeekTableNew(seekTableInvalid), FormatError, "zst seek table descriptor has reserved bits set (0x84)");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("zstError()");
 
@@ -349,14 +655,18 @@ testRun(void)
 
         char buffer[STACK_TRACE_PARAM_MAX];
 
-        ZstCompress *compress = (ZstCompress *)ioFilterDriver(zstCompressNew(14, false));
+        ZstCompress *compress = (ZstCompress *)ioFilterDriver(zstCompressNewP(14));
 
         compress->inputSame = true;
         compress->inputOffset = 49;
         compress->flushing = true;
 
         TEST_RESULT_VOID(FUNCTION_LOG_OBJECT_FORMAT(compress, zstCompressToLog, buffer, sizeof(buffer)), "zstCompressToLog");
-        TEST_RESULT_Z(buffer, "{level: 14, inputSame: true, inputOffset: 49, flushing: true}", "check log");
+        TEST_RESULT_Z(
+            buffer,
+            "{level: 14, thread: 0, longDistance: false, adapt: false, restart: false, seek: false, frameEnd: false, frameIn: 0,"
+            " inputSame: true, inputOffset: 49, flushing: true}",
+            "check log");
 
         ZstDecompress *decompress = (ZstDecompress *)ioFilterDriver(zstDecompressNew(false));
 
@@ -289,6 +289,133 @@ testRun(void)
 
         ioFilterFree(blockDecryptFilter);
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("authenticated encrypt");
+
+        blockEncryptFilter = cipherBlockNewP(cipherModeEncrypt, cipherTypeAes256Gcm, testPass);
+        blockEncrypt = (CipherBlock *)ioFilterDriver(blockEncryptFilter);
+        TEST_RESULT_BOOL(blockEncrypt->authenticate, true, "authenticate is true");
+
+        bufUsedZero(encryptBuffer);
+
+        ioFilterProcessInOut(blockEncryptFilter, testPlainText, encryptBuffer);
+        ioFilterProcessInOut(blockEncryptFilter, testPlainText, encryptBuffer);
+        TEST_RESULT_UINT(
+            bufUsed(encryptBuffer), CIPHER_BLOCK_HEADER_AUTH_SIZE + strlen(TEST_PLAINTEXT) * 2, "data is not buffered");
+
+        ioFilterProcessInOut(blockEncryptFilter, NULL, encryptBuffer);
+        TEST_RESULT_UINT(
+            bufUsed(encryptBuffer), CIPHER_BLOCK_HEADER_AUTH_SIZE + strlen(TEST_PLAINTEXT) * 2 + CIPHER_BLOCK_TAG_SIZE,
+            "tag on flush");
+        TEST_RESULT_BOOL(ioFilterDone(blockEncryptFilter), true, "filter is done");
+
+        ioFilterFree(blockEncryptFilter);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("authenticated decrypt in one pass");
+
+        blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass);
+
+        bufUsedZero(decryptBuffer);
+
+        ioFilterProcessInOut(blockDecryptFilter, encryptBuffer, decryptBuffer);
+        TEST_RESULT_UINT(bufUsed(decryptBuffer), strlen(TEST_PLAINTEXT) * 2, "tag is held back");
+
+        ioFilterProcessInOut(blockDecryptFilter, NULL, decryptBuffer);
+        TEST_RESULT_STR_Z(strNewBuf(decryptBuffer), TEST_PLAINTEXT TEST_PLAINTEXT, "check final decrypt buffer");
+
+        ioFilterFree(blockDecryptFilter);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("authenticated decrypt one byte at a time");
+
+        blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass);
+        blockDecrypt = (CipherBlock *)ioFilterDriver(blockDecryptFilter);
+
+        bufUsedZero(decryptBuffer);
+
+        for (size_t encryptIdx = 0; encryptIdx < bufUsed(encryptBuffer); encryptIdx++)
+            ioFilterProcessInOut(blockDecryptFilter, bufNewC(bufPtr(encryptBuffer) + encryptIdx, 1), decryptBuffer);
+
+        TEST_RESULT_UINT(blockDecrypt->tagSize, CIPHER_BLOCK_TAG_SIZE, "tag is held back");
+
+        ioFilterProcessInOut(blockDecryptFilter, NULL, decryptBuffer);
+        TEST_RESULT_STR_Z(strNewBuf(decryptBuffer), TEST_PLAINTEXT TEST_PLAINTEXT, "check final decrypt buffer");
+
+        ioFilterFree(blockDecryptFilter);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("decrypt with mismatched cipher type fails");
+
+        TEST_RESULT_BOOL(memcmp(bufPtr(encryptBuffer), CIPHER_BLOCK_MAGIC_AUTH, CIPHER_BLOCK_MAGIC_SIZE) == 0, true, "gcm magic");
+
+        blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Cbc, testPass);
+
+        TEST_ERROR(
+            ioFilterProcessInOut(blockDecryptFilter, encryptBuffer, decryptBuffer), CryptoError,
+            "cipher header is for aes-256-gcm but aes-256-cbc was requested\n"
+            "HINT: has repo-cipher-type changed since the stanza was created?");
+
+        ioFilterFree(blockDecryptFilter);
+
+        blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass);
+
+        TEST_ERROR(
+            ioFilterProcessInOut(blockDecryptFilter, BUFSTRDEF(CIPHER_BLOCK_MAGIC "12345678" "123456789012"), decryptBuffer),
+            CryptoError,
+            "cipher header is for aes-256-cbc but aes-256-gcm was requested\n"
+            "HINT: has repo-cipher-type changed since the stanza was created?");
+
+        ioFilterFree(blockDecryptFilter);
+
+        blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass);
+
+        TEST_ERROR(
+            ioFilterProcessInOut(blockDecryptFilter, BUFSTRDEF("XXXXXXXX12345678123456789012"), decryptBuffer), CryptoError,
+            "cipher header invalid");
+
+        ioFilterFree(blockDecryptFilter);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("authenticated decrypt with modified nonce fails");
+
+        bufPtr(encryptBuffer)[CIPHER_BLOCK_HEADER_SIZE] ^= 0xFF;
+
+        blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass);
+
+        bufUsedZero(decryptBuffer);
+
+        ioFilterProcessInOut(blockDecryptFilter, encryptBuffer, decryptBuffer);
+        TEST_ERROR(ioFilterProcessInOut(blockDecryptFilter, NULL, decryptBuffer), CryptoError, "cipher authentication failed");
+
+        ioFilterFree(blockDecryptFilter);
+
+        bufPtr(encryptBuffer)[CIPHER_BLOCK_HEADER_SIZE] ^= 0xFF;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("authenticated decrypt of modified data fails");
+
+        bufPtr(encryptBuffer)[CIPHER_BLOCK_HEADER_AUTH_SIZE] ^= 0xFF;
+
+        blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass);
+
+        bufUsedZero(decryptBuffer);
+
+        ioFilterProcessInOut(blockDecryptFilter, encryptBuffer, decryptBuffer);
+        TEST_ERROR(ioFilterProcessInOut(blockDecryptFilter, NULL, decryptBuffer), CryptoError, "cipher authentication failed");
+
+        ioFilterFree(blockDecryptFilter);
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("authenticated decrypt with missing tag fails");
+
+        blockDecryptFilter = cipherBlockNewP(cipherModeDecrypt, cipherTypeAes256Gcm, testPass, .raw = true);
+
+        ioFilterProcessInOut(blockDecryptFilter, BUFSTRDEF("12345678" "123456789012" "123"), decryptBuffer);
+        TEST_ERROR(ioFilterProcessInOut(blockDecryptFilter, NULL, decryptBuffer), CryptoError, "cipher tag missing");
+
+        ioFilterFree(blockDecryptFilter);
+
         // Helper function
         // -------------------------------------------------------------------------------------------------------------------------
         IoFilterGroup *filterGroup = ioFilterGroupNew();
@@ -393,6 +520,30 @@ testRun(void)
         TEST_RESULT_STR_Z(
             strNewEncode(encodingHex, cryptoHashOne(hashTypeSha1, BUFSTRDEF(""))), HASH_TYPE_SHA1_ZERO, "    check empty hash");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("xxhash");
+
+        TEST_ASSIGN(hash, cryptoHashNew(hashTypeXxHash), "create xxhash hash");
+        TEST_RESULT_VOID(ioFilterProcessIn(hash, BUFSTRDEF("12345")), "add 12345");
+        TEST_RESULT_VOID(ioFilterProcessIn(hash, BUFSTRDEF("\n")), "add \\n");
+        TEST_RESULT_STR_Z(
+            strNewEncode(encodingHex, pckReadBinP(pckReadNew(ioFilterResult(hash)))), "1a3e11127b8856b804f0f99dc9fa4b56",
+            "check hash");
+        TEST_RESULT_STR_Z(
+            strNewEncode(encodingHex, cryptoHashOne(hashTypeXxHash, BUFSTRDEF(""))), HASH_TYPE_XXHASH_ZERO, "check empty hash");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("hash size and zero hash");
+
+        TEST_RESULT_UINT(cryptoHashSize(hashTypeMd5), HASH_TYPE_M5_SIZE, "md5 size");
+        TEST_RESULT_UINT(cryptoHashSize(hashTypeSha1), HASH_TYPE_SHA1_SIZE, "sha1 size");
+        TEST_RESULT_UINT(cryptoHashSize(hashTypeSha256), HASH_TYPE_SHA256_SIZE, "sha256 size");
+        TEST_RESULT_UINT(cryptoHashSize(hashTypeXxHash), HASH_TYPE_XXHASH_SIZE, "xxhash size");
+
+        TEST_RESULT_STR_Z(strNewEncode(encodingHex, cryptoHashZero(hashTypeSha1)), HASH_TYPE_SHA1_ZERO, "sha1 zero");
+        TEST_RESULT_STR_Z(strNewEncode(encodingHex, cryptoHashZero(hashTypeSha256)), HASH_TYPE_SHA256_ZERO, "sha256 zero");
+        TEST_RESULT_STR_Z(strNewEncode(encodingHex, cryptoHashZero(hashTypeXxHash)), HASH_TYPE_XXHASH_ZERO, "xxhash zero");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_RESULT_STR_Z(
             strNewEncode(
@@ -138,8 +138,8 @@ testRun(void)
         static const ErrorHandlerFunction testErrorHandlerList[] = {testErrorHandler};
         errorHandlerSet(testErrorHandlerList, LENGTH_OF(testErrorHandlerList));
 
-        assert(errorContext.handlerList[0] == testErrorHandler);
-        assert(errorContext.handlerTotal == 1);
+        assert(errorHandler.list[0] == testErrorHandler);
+        assert(errorHandler.total == 1);
 
         // -------------------------------------------------------------------------------------------------------------------------
         assert(errorTryDepth() == 0);
@@ -695,6 +695,127 @@ testRun(void)
                     "*** Response Content ***:\n"
                     "CONTENT");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("hedge threshold");
+
+                TEST_RESULT_UINT(httpClientHedgeThreshold(client), 0, "no threshold without enough samples");
+
+                for (unsigned int sampleIdx = 0; sampleIdx < 31; sampleIdx++)
+                    httpClientLatencyAdd(client, 0);
+
+                TEST_RESULT_UINT(httpClientHedgeThreshold(client), 0, "no threshold without enough samples");
+
+                httpClientLatencyAdd(client, 999999999);
+
+                TEST_RESULT_UINT(httpClientHedgeThreshold(client), 1, "threshold at 95th percentile");
+
+                client->hedgePercentile = 100;
+                TEST_RESULT_UINT(httpClientHedgeThreshold(client), 8388608, "threshold at 100th percentile");
+
+                client->hedgePercentile = 0;
+                TEST_RESULT_UINT(httpClientHedgeThreshold(client), 0, "hedging disabled");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("no hedge when disabled");
+
+                hrnServerScriptAccept(http);
+
+                hrnServerScriptExpectZ(http, "GET /hedge HTTP/1.1\r\n" TEST_USER_AGENT "\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 200 OK\r\ncontent-length:1\r\n\r\n0");
+
+                TEST_ASSIGN(request, httpRequestNewP(client, STRDEF("GET"), STRDEF("/hedge")), "request");
+                TEST_RESULT_VOID(httpRequestHedge(request), "hedge");
+                TEST_ASSIGN(response, httpRequestResponse(request, true), "response");
+                TEST_RESULT_STR_Z(strNewBuf(httpResponseContent(response)), "0", "check response content");
+
+                client->hedgePercentile = 95;
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("response before hedge threshold");
+
+                memset(client->latencyBucket, 0, sizeof(client->latencyBucket));
+                client->latencyTotal = 0;
+
+                for (unsigned int sampleIdx = 0; sampleIdx < 32; sampleIdx++)
+                    httpClientLatencyAdd(client, 1000);
+
+                hrnServerScriptExpectZ(http, "GET /hedge HTTP/1.1\r\n" TEST_USER_AGENT "\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 200 OK\r\ncontent-length:1\r\n\r\n1");
+
+                TEST_ASSIGN(request, httpRequestNewP(client, STRDEF("GET"), STRDEF("/hedge")), "request");
+                TEST_RESULT_VOID(httpRequestHedge(request), "hedge");
+                TEST_ASSIGN(response, httpRequestResponse(request, true), "response");
+                TEST_RESULT_STR_Z(strNewBuf(httpResponseContent(response)), "1", "check response content");
+                TEST_RESULT_UINT(client->latencyTotal, 33, "latency added");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("hedge responds first");
+
+                memset(client->latencyBucket, 0, sizeof(client->latencyBucket));
+                client->latencyTotal = 0;
+
+                for (unsigned int sampleIdx = 0; sampleIdx < 32; sampleIdx++)
+                    httpClientLatencyAdd(client, 100);
+
+                hrnServerScriptExpectZ(http, "GET /hedge HTTP/1.1\r\n" TEST_USER_AGENT "\r\n");
+                hrnServerScriptAccept(http);
+                hrnServerScriptExpectZ(http, "GET /hedge HTTP/1.1\r\n" TEST_USER_AGENT "\r\n");
+                hrnServerScriptReplyZ(http, "HTTP/1.1 200 OK\r\ncontent-length:1\r\n\r\n2");
+
+                TEST_ASSIGN(request, httpRequestNewP(client, STRDEF("GET"), STRDEF("/hedge")), "request");
+                TEST_RESULT_VOID(httpRequestHedge(request), "hedge");
+                TEST_ASSIGN(response, httpRequestResponse(request, true), "response");
+                TEST_RESULT_STR_Z(strNewBuf(httpResponseContent(response)), "2", "check response content");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("original responds first after hedge");
+
+                hrnServerScriptExpectZ(http, "GET /hedge HTTP/1.1\r\n" TEST_USER_AGENT "\r\n");
+                hrnServerScriptSleep(http, 250);
+                hrnServerScriptReplyZ(http, "HTTP/1.1 200 OK\r\ncontent-length:1\r\n\r\n3");
+
+                TEST_ASSIGN(request, httpRequestNewP(client, STRDEF("GET"), STRDEF("/hedge")), "request");
+                TEST_RESULT_VOID(httpRequestHedge(request), "hedge");
+                TEST_ASSIGN(response, httpRequestResponse(request, true), "response");
+                TEST_RESULT_STR_Z(strNewBuf(httpResponseContent(response)), "3", "check response content");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("original responds after hedge fails to connect");
+
+                memset(client->latencyBucket, 0, sizeof(client->latencyBucket));
+                client->latencyTotal = 0;
+
+                for (unsigned int sampleIdx = 0; sampleIdx < 32; sampleIdx++)
+                    httpClientLatencyAdd(client, 100);
+
+                IoClient *const ioClient = client->ioClient;
+                client->ioClient = sckClientNew(hrnServerHost(), hrnServerPortNext(), 100, 100);
+
+                hrnServerScriptExpectZ(http, "GET /hedge HTTP/1.1\r\n" TEST_USER_AGENT "\r\n");
+                hrnServerScriptSleep(http, 250);
+                hrnServerScriptReplyZ(http, "HTTP/1.1 200 OK\r\ncontent-length:1\r\n\r\n5");
+
+                TEST_ASSIGN(request, httpRequestNewP(client, STRDEF("GET"), STRDEF("/hedge")), "request");
+                TEST_RESULT_VOID(httpRequestHedge(request), "hedge");
+                TEST_ASSIGN(response, httpRequestResponse(request, true), "response");
+                TEST_RESULT_STR_Z(strNewBuf(httpResponseContent(response)), "5", "check response content");
+
+                client->ioClient = ioClient;
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("no response before timeout after hedge");
+
+                client->pub.timeout = 50;
+
+                hrnServerScriptExpectZ(http, "GET /hedge HTTP/1.1\r\n" TEST_USER_AGENT "\r\n");
+                hrnServerScriptSleep(http, 500);
+                hrnServerScriptReplyZ(http, "HTTP/1.1 200 OK\r\ncontent-length:1\r\n\r\n4");
+
+                TEST_ASSIGN(request, httpRequestNewP(client, STRDEF("GET"), STRDEF("/hedge")), "request");
+                TEST_RESULT_VOID(httpRequestHedge(request), "hedge");
+                TEST_ASSIGN(response, httpRequestResponse(request, true), "response");
+                TEST_RESULT_STR_Z(strNewBuf(httpResponseContent(response)), "4", "check response content");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("end server process");
 
@@ -964,6 +1085,24 @@ testRun(void)
                     bufEq(requestMulti->boundaryRaw, BUFSTRDEF(HTTP_MULTIPART_BOUNDARY_INIT HTTP_MULTIPART_BOUNDARY_EXTRA)),
                     true, "max boundary");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("session is ready when response is buffered by tls");
+
+                ioBufferSizeSet(35);
+
+                hrnServerScriptAccept(http);
+
+                hrnServerScriptExpectZ(http, "GET / HTTP/1.1\r\n" TEST_USER_AGENT "\r\n");
+                hrnServerScriptReplyZ(
+                    http,
+                    "HTTP/1.1 200 OK\r\ncontent-length:100\r\n\r\n"
+                    "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+
+                TEST_ASSIGN(response, httpRequestResponse(httpRequestNewP(client, STRDEF("GET"), STRDEF("/")), false), "request");
+                TEST_RESULT_BOOL(ioSessionPending(response->session->ioSession), true, "tls data pending");
+                TEST_RESULT_BOOL(httpSessionReadyRead(response->session, 0), true, "session ready");
+                TEST_RESULT_UINT(bufUsed(httpResponseContent(response)), 100, "read response");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("end server process");
 
@@ -125,6 +125,36 @@ ioTestFilterSizeNew(const StringId type)
     return ioFilterNewP(type, this, NULL, .in = ioTestFilterSizeProcess, .result = ioTestFilterSizeResult);
 }
 
+/***********************************************************************************************************************************
+Test filter that throws an error on input
+***********************************************************************************************************************************/
+static void
+ioTestFilterErrorProcess(THIS_VOID, const Buffer *buffer)
+{
+    THIS(IoTestFilterSize);
+
+    FUNCTION_LOG_BEGIN(logLevelTrace);
+        FUNCTION_LOG_PARAM_P(VOID, this);
+        FUNCTION_LOG_PARAM(BUFFER, buffer);
+    FUNCTION_LOG_END();
+
+    THROW_FMT(FormatError, "error after %zu bytes", this->size);
+
+    FUNCTION_LOG_RETURN_VOID();
+}
+
+static IoFilter *
+ioTestFilterErrorNew(void)
+{
+    OBJ_NEW_BEGIN(IoTestFilterSize, .childQty = MEM_CONTEXT_QTY_MAX)
+    {
+        *this = (IoTestFilterSize){0};
+    }
+    OBJ_NEW_END();
+
+    return ioFilterNewP(strIdFromZ("error"), this, NULL, .in = ioTestFilterErrorProcess, .result = ioTestFilterSizeResult);
+}
+
 /***********************************************************************************************************************************
 Test filter to multiply input to the output. It can also flush out a variable number of bytes at the end.
 ***********************************************************************************************************************************/
@@ -399,6 +429,101 @@ testRun(void)
         TEST_RESULT_VOID(ioFilterFree(bufferFilter), "    free buffer filter");
         TEST_RESULT_VOID(ioFilterGroupFree(ioReadFilterGroup(bufferRead)), "    free filter group object");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("pipelined filter group");
+
+        ioBufferSizeSet(2);
+
+        TEST_ASSIGN(bufferRead, ioBufferReadNew(BUFSTRDEF("123")), "create buffer read object");
+        ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioSizeNew());
+        ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioTestFilterMultiplyNew(STRID5("double", 0xac155e40), 2, 2, 'X'));
+        ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioTestFilterMultiplyNew(STRID5("single", 0xac3b9330), 1, 0, 'Z'));
+        ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioSizeNew());
+        ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioTestFilterMultiplyNew(STRID5("single", 0xac3b9330), 1, 1, 'Y'));
+        TEST_RESULT_VOID(ioFilterGroupPipelineSet(ioReadFilterGroup(bufferRead), true), "set pipelined");
+
+        TEST_RESULT_BOOL(ioReadOpen(bufferRead), true, "open");
+
+        buffer = bufNew(1);
+        Buffer *bufferAll = bufNew(0);
+
+        while (!ioReadEof(bufferRead))
+        {
+            bufUsedZero(buffer);
+            ioRead(bufferRead, buffer);
+            bufCat(bufferAll, buffer);
+        }
+
+        TEST_RESULT_STR_Z(strNewBuf(bufferAll), "112233XXY", "check read");
+        TEST_RESULT_VOID(ioReadClose(bufferRead), "close");
+        TEST_RESULT_STR_Z(
+            hrnPackToStr(ioFilterGroupResultAll(ioReadFilterGroup(bufferRead))),
+            "1:strid:size, 2:pack:<1:u64:3>, 3:strid:double, 5:strid:single, 7:strid:size, 8:pack:<1:u64:8>, 9:strid:single",
+            "check filter result all");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("pipelined filter group with only one filter is serial");
+
+        bufferRead = ioBufferReadNew(BUFSTRDEF("123"));
+        ioFilterGroupPipelineSet(ioReadFilterGroup(bufferRead), true);
+
+        TEST_RESULT_BOOL(ioReadOpen(bufferRead), true, "open");
+        TEST_RESULT_PTR(ioReadFilterGroup(bufferRead)->pipeline, NULL, "no pipeline");
+        TEST_RESULT_STR_Z(strNewBuf(ioReadBuf(bufferRead)), "123", "check read");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("pipelined filter group error");
+
+        bufferRead = ioBufferReadNew(BUFSTRDEF("123"));
+        ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioSizeNew());
+        ioFilterGroupAdd(ioReadFilterGroup(bufferRead), ioTestFilterErrorNew());
+        ioFilterGroupPipelineSet(ioReadFilterGroup(bufferRead), true);
+
+        TEST_RESULT_BOOL(ioReadOpen(bufferRead), true, "open");
+        TEST_ERROR(ioReadBuf(bufferRead), FormatError, "error after 0 bytes");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("free pipelined filter group while stages are waiting for input");
+
+        IoFilterGroup *pipelineGroup = ioFilterGroupNew();
+        ioFilterGroupAdd(pipelineGroup, ioSizeNew());
+        ioFilterGroupAdd(pipelineGroup, ioTestFilterMultiplyNew(STRID5("double", 0xac155e40), 2, 3, 'X'));
+        ioFilterGroupAdd(pipelineGroup, ioTestFilterMultiplyNew(STRID5("single", 0xac3b9330), 1, 1, 'Y'));
+        ioFilterGroupPipelineSet(pipelineGroup, true);
+        ioFilterGroupOpen(pipelineGroup);
+
+        // Give stages time to wait for input
+        sleepMSec(100);
+
+        TEST_RESULT_VOID(ioFilterGroupFree(pipelineGroup), "free");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("free pipelined filter group while stages are waiting for output");
+
+        pipelineGroup = ioFilterGroupNew();
+        ioFilterGroupAdd(pipelineGroup, ioSizeNew());
+        ioFilterGroupAdd(pipelineGroup, ioTestFilterMultiplyNew(STRID5("double", 0xac155e40), 2, 3, 'X'));
+        ioFilterGroupAdd(pipelineGroup, ioTestFilterMultiplyNew(STRID5("single", 0xac3b9330), 1, 1, 'Y'));
+        ioFilterGroupPipelineSet(pipelineGroup, true);
+        ioFilterGroupOpen(pipelineGroup);
+
+        buffer = bufNew(2);
+
+        for (unsigned int inputIdx = 0; inputIdx < 32; inputIdx++)
+        {
+            do
+            {
+                bufUsedZero(buffer);
+                ioFilterGroupProcess(pipelineGroup, BUFSTRDEF("abcde"), buffer);
+            }
+            while (ioFilterGroupInputSame(pipelineGroup));
+        }
+
+        // Give stages time to fill the queues
+        sleepMSec(250);
+
+        TEST_RESULT_VOID(ioFilterGroupFree(pipelineGroup), "free");
+
         // Set filter group results
         // -------------------------------------------------------------------------------------------------------------------------
         IoFilterGroup *filterGroup = ioFilterGroupNew();
@@ -599,6 +724,91 @@ testRun(void)
             pckReadU64P(ioFilterGroupResultP(filterGroup, ioFilterType(sizeFilter))), 9, "    check filter result");
         TEST_RESULT_UINT(
             pckReadU64P(ioFilterGroupResultP(filterGroup, STRID5("size2", 0x1c2e9330))), 22, "    check filter result");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("pipelined filter group");
+
+        buffer = bufNew(0);
+
+        TEST_ASSIGN(bufferWrite, ioBufferWriteNew(buffer), "create buffer write object");
+        filterGroup = ioWriteFilterGroup(bufferWrite);
+        ioFilterGroupAdd(filterGroup, ioSizeNew());
+        ioFilterGroupAdd(filterGroup, ioTestFilterMultiplyNew(STRID5("double", 0xac155e40), 2, 3, 'X'));
+        ioFilterGroupAdd(filterGroup, ioTestFilterMultiplyNew(STRID5("single", 0xac3b9330), 1, 1, 'Y'));
+        ioFilterGroupAdd(filterGroup, ioTestFilterSizeNew(STRID5("size2", 0x1c2e9330)));
+        ioFilterGroupPipelineSet(filterGroup, true);
+
+        TEST_RESULT_VOID(ioWriteOpen(bufferWrite), "open");
+        TEST_RESULT_VOID(ioWriteLine(bufferWrite, BUFSTRDEF("AB")), "write line");
+        TEST_RESULT_VOID(ioWriteStr(bufferWrite, STRDEF("Z")), "write string");
+        TEST_RESULT_VOID(ioWriteStr(bufferWrite, STRDEF("12345")), "write bytes");
+        TEST_RESULT_VOID(ioWriteClose(bufferWrite), "close");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "AABB\n\nZZ1122334455XXXY", "check write");
+        TEST_RESULT_STR_Z(
+            hrnPackToStr(ioFilterGroupResultAll(filterGroup)),
+            "1:strid:size, 2:pack:<1:u64:9>, 3:strid:double, 5:strid:single, 7:strid:size2, 8:pack:<1:u64:22>, 9:strid:buffer",
+            "check filter result all");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("filter stats");
+
+        TEST_RESULT_PTR(ioFilterStatTotalList(), NULL, "no totals");
+        TEST_RESULT_PTR(ioFilterStatPack(), NULL, "no totals to pack");
+
+        TEST_RESULT_VOID(ioFilterStatEnabledSet(true), "enable stats");
+        TEST_RESULT_BOOL(ioFilterStatEnabled(), true, "stats enabled");
+
+        for (unsigned int pipelineIdx = 0; pipelineIdx < 2; pipelineIdx++)
+        {
+            buffer = bufNew(0);
+            bufferWrite = ioBufferWriteNew(buffer);
+            filterGroup = ioWriteFilterGroup(bufferWrite);
+            ioFilterGroupAdd(filterGroup, ioSizeNew());
+            ioFilterGroupAdd(filterGroup, ioTestFilterMultiplyNew(STRID5("double", 0xac155e40), 2, 3, 'X'));
+            ioFilterGroupAdd(filterGroup, ioTestFilterMultiplyNew(STRID5("single", 0xac3b9330), 1, 1, 'Y'));
+            ioFilterGroupAdd(filterGroup, ioTestFilterSizeNew(STRID5("size2", 0x1c2e9330)));
+            ioFilterGroupPipelineSet(filterGroup, pipelineIdx == 1);
+
+            ioWriteOpen(bufferWrite);
+            ioWriteLine(bufferWrite, BUFSTRDEF("AB"));
+            ioWriteStr(bufferWrite, STRDEF("Z"));
+            ioWriteStr(bufferWrite, STRDEF("12345"));
+            ioWriteClose(bufferWrite);
+        }
+
+        String *const statStr = strNew();
+
+        for (unsigned int totalIdx = 0; totalIdx < lstSize(ioFilterStatTotalList()); totalIdx++)
+        {
+            const IoFilterStatTotal *const total = lstGet(ioFilterStatTotalList(), totalIdx);
+
+            strCatFmt(
+                statStr, "%s%s in %" PRIu64 ", out %" PRIu64, totalIdx == 0 ? "" : ", ", strZ(strIdToStr(total->type)),
+                total->stat.bytesIn, total->stat.bytesOut);
+
+            ASSERT(total->stat.timeWall > 0);
+        }
+
+        TEST_RESULT_STR_Z(
+            statStr, "size in 18, out 0, double in 18, out 42, single in 42, out 44, size2 in 44, out 0, buffer in 44, out 44",
+            "check totals for serial and pipelined");
+
+        Pack *statPack = NULL;
+        TEST_ASSIGN(statPack, ioFilterStatPack(), "pack totals");
+        TEST_RESULT_UINT(lstSize(ioFilterStatTotalList()), 0, "totals reset");
+        TEST_RESULT_PTR(ioFilterStatPack(), NULL, "no totals to pack");
+
+        TEST_RESULT_VOID(ioFilterStatMerge(NULL), "merge no totals");
+        TEST_RESULT_VOID(ioFilterStatMerge(statPack), "merge totals");
+        TEST_RESULT_VOID(ioFilterStatMerge(statPack), "merge totals again");
+        TEST_RESULT_UINT(lstSize(ioFilterStatTotalList()), 5, "totals merged");
+        TEST_RESULT_UINT(
+            ((IoFilterStatTotal *)lstGet(ioFilterStatTotalList(), 1))->stat.bytesOut, 84, "double out is merged twice");
+
+        TEST_RESULT_VOID(ioFilterStatAdd(STRID5("double", 0xac155e40), &(IoFilterStat){0}), "skip filter that was not called");
+        TEST_RESULT_UINT(lstSize(ioFilterStatTotalList()), 5, "totals unchanged");
+
+        TEST_RESULT_VOID(ioFilterStatEnabledSet(false), "disable stats");
     }
 
     // *****************************************************************************************************************************
@@ -1133,7 +1133,9 @@ testRun(void)
                 TEST_ASSIGN(session, ioClientOpen(client), "open client");
                 TlsSession *tlsSession = (TlsSession *)session->pub.driver;
 
-                TEST_RESULT_INT(ioSessionFd(session), -1, "no fd for tls session");
+                TEST_RESULT_INT(ioSessionFd(session), ioSessionFd(tlsSession->ioSession), "tls session uses socket fd");
+                TEST_RESULT_BOOL(ioSessionPending(session), false, "no tls data pending");
+                TEST_RESULT_BOOL(ioSessionPending(tlsSession->ioSession), false, "socket session does not buffer");
 
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("ioClientToLog() and ioSessionToLog()");
@@ -27,9 +27,11 @@ testRun(void)
         TEST_RESULT_UINT(lstSize(statLocalData.stat), 1, "stat list has one stat");
         TEST_RESULT_VOID(statInc(statHttpSession), "inc http.session");
         TEST_RESULT_UINT(lstSize(statLocalData.stat), 2, "stat list has two stats");
+        TEST_RESULT_VOID(statAdd(statTlsClient, 5), "add tls.client");
+        TEST_RESULT_UINT(lstSize(statLocalData.stat), 2, "stat list has two stats");
 
         TEST_RESULT_STR_Z(
-            statToJson(), "{\"http.session\":{\"total\":1},\"tls.client\":{\"total\":2}}", "stat output");
+            statToJson(), "{\"http.session\":{\"total\":1},\"tls.client\":{\"total\":7}}", "stat output");
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
@@ -529,6 +529,21 @@ testRun(void)
             "P00   WARN: 'compress' and 'compress-type' options should not both be set\n"
             "            HINT: 'compress-type' is preferred and 'compress' is deprecated.");
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("zst threads and long distance matching supported by libzstd");
+
+        argList = strLstNew();
+        hrnCfgArgRawZ(argList, cfgOptStanza, "db");
+        hrnCfgArgKeyRawZ(argList, cfgOptPgPath, 1, "/pg1");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoPath, 1, "/repo1");
+        hrnCfgArgKeyRawZ(argList, cfgOptRepoRetentionFull, 1, "1");
+        hrnCfgArgRawStrId(argList, cfgOptCompressType, CFGOPTVAL_COMPRESS_TYPE_ZST);
+        hrnCfgArgRawZ(argList, cfgOptCompressThread, "2");
+        hrnCfgArgRawBool(argList, cfgOptCompressLong, true);
+        HRN_CFG_LOAD(cfgCmdBackup, argList);
+
+        TEST_RESULT_UINT(cfgOptionUInt(cfgOptCompressThread), 2, "compress-thread=2");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("S3 default chunk size");
 
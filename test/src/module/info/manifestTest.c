@@ -288,8 +288,8 @@ testRun(void)
         // Test tablespace error
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, NULL, exclusionList,
-                pckWriteResult(tablespaceList)),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, hashTypeSha1,
+                NULL, exclusionList, pckWriteResult(tablespaceList)),
             AssertError,
             "tablespace with oid 1 not found in tablespace map\n"
             "HINT: was a tablespace created or dropped during the backup?");
@@ -313,8 +313,8 @@ testRun(void)
         TEST_ASSIGN(
             manifest,
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, NULL, NULL,
-                pckWriteResult(tablespaceList)),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, hashTypeSha1,
+                NULL, NULL, pckWriteResult(tablespaceList)),
             "build manifest");
         TEST_RESULT_VOID(manifestBackupLabelSet(manifest, STRDEF("20190818-084502F")), "backup label set");
 
@@ -410,7 +410,8 @@ testRun(void)
         TEST_ASSIGN(
             manifest,
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, true, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             "build manifest");
 
         contentSave = bufNew(0);
@@ -483,7 +484,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_96, hrnPgCatalogVersion(PG_VERSION_96), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_96, hrnPgCatalogVersion(PG_VERSION_96), 0, false, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             LinkDestinationError,
             "link 'pg_xlog/wal' (" TEST_PATH "/wal) destination is the same directory as link 'pg_xlog' (" TEST_PATH "/wal)");
 
@@ -539,7 +541,8 @@ testRun(void)
         TEST_ASSIGN(
             manifest,
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, true, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, true, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             "build manifest");
 
         contentSave = bufNew(0);
@@ -634,7 +637,8 @@ testRun(void)
         // Tablespace link errors when correct version not found
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_12, hrnPgCatalogVersion(PG_VERSION_12), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_12, hrnPgCatalogVersion(PG_VERSION_12), 0, false, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             FileOpenError, "unable to get info for missing path/file '" TEST_PATH "/pg/pg_tblspc/1/PG_12_201909212'");
 
         // Remove the link inside pg/pg_tblspc
@@ -653,7 +657,8 @@ testRun(void)
         TEST_ASSIGN(
             manifest,
             manifestNewBuild(
-                storagePg, PG_VERSION_12, hrnPgCatalogVersion(PG_VERSION_12), 0, true, false, true, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_12, hrnPgCatalogVersion(PG_VERSION_12), 0, true, false, true, false, hashTypeXxHash,
+                NULL, NULL, NULL),
             "build manifest");
 
         contentSave = bufNew(0);
@@ -673,6 +678,7 @@ testRun(void)
                     TEST_MANIFEST_DB_12
                     TEST_MANIFEST_OPTION_ARCHIVE
                     TEST_MANIFEST_OPTION_CHECKSUM_PAGE_FALSE
+                    "option-checksum-type=\"xxhash\"\n"
                     TEST_MANIFEST_OPTION_ONLINE_TRUE
                     "\n"
                     "[backup:target]\n"
@@ -728,6 +734,19 @@ testRun(void)
                     TEST_MANIFEST_PATH_DEFAULT)),
             "check manifest");
 
+        TEST_TITLE("reload manifest with xxhash checksums");
+
+        Manifest *manifestLoad = NULL;
+        TEST_ASSIGN(manifestLoad, manifestNewLoad(ioBufferReadNew(contentSave)), "load manifest");
+        TEST_RESULT_UINT(manifestData(manifestLoad)->backupOptionChecksumType, hashTypeXxHash, "check checksum type");
+        TEST_RESULT_STR_Z(
+            strNewEncode(
+                encodingHex,
+                BUF(
+                    manifestFileFind(manifestLoad, STRDEF("pg_data/base/1/555_init")).checksumSha1,
+                    manifestChecksumSize(manifestLoad))),
+            HASH_TYPE_XXHASH_ZERO, "check zero-length file checksum");
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("run 13, offline, block incr");
 
@@ -776,7 +795,7 @@ testRun(void)
         TEST_ASSIGN(
             manifest,
             manifestNewBuild(
-                storagePg, PG_VERSION_13, hrnPgCatalogVersion(PG_VERSION_13), 1570000000, false, false, true, true,
+                storagePg, PG_VERSION_13, hrnPgCatalogVersion(PG_VERSION_13), 1570000000, false, false, true, true, hashTypeSha1,
                 &manifestBuildBlockIncrMap, NULL, NULL),
             "build manifest");
 
@@ -852,7 +871,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             LinkDestinationError, "link 'link' destination '" TEST_PATH "/pg/base' is in PGDATA");
 
         THROW_ON_SYS_ERROR(unlink(TEST_PATH "/pg/link") == -1, FileRemoveError, "unable to remove symlink");
@@ -864,7 +884,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             LinkExpectedError, "'pg_data/pg_tblspc/somedir' is not a symlink - pg_tblspc should contain only symlinks");
 
         HRN_STORAGE_PATH_REMOVE(storagePgWrite, MANIFEST_TARGET_PGTBLSPC "/somedir");
@@ -876,7 +897,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             LinkExpectedError, "'pg_data/pg_tblspc/somefile' is not a symlink - pg_tblspc should contain only symlinks");
 
         TEST_STORAGE_EXISTS(storagePgWrite, MANIFEST_TARGET_PGTBLSPC "/somefile", .remove = true);
@@ -888,7 +910,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, true, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, true, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             FileOpenError, "unable to get info for missing path/file '" TEST_PATH "/pg/link-to-link'");
 
         THROW_ON_SYS_ERROR(unlink(TEST_PATH "/pg/link-to-link") == -1, FileRemoveError, "unable to remove symlink");
@@ -904,7 +927,8 @@ testRun(void)
 
         TEST_ERROR(
             manifestNewBuild(
-                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, NULL, NULL, NULL),
+                storagePg, PG_VERSION_95, hrnPgCatalogVersion(PG_VERSION_95), 0, false, false, false, false, hashTypeSha1,
+                NULL, NULL, NULL),
             LinkDestinationError, "link '" TEST_PATH "/pg/linktolink' cannot reference another link '" TEST_PATH "/linktest'");
 
         #undef TEST_MANIFEST_HEADER
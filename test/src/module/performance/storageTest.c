@@ -9,10 +9,15 @@ stress testing as needed.
 ***********************************************************************************************************************************/
 #include "common/harnessConfig.h"
 #include "common/harnessFork.h"
+#include "common/harnessObjStore.h"
+#include "common/harnessServer.h"
 #include "common/harnessStorage.h"
 
+#include "command/backup/blockIncr.h"
+#include "command/restore/file.h"
 #include "common/compress/gz/compress.h"
 #include "common/compress/lz4/compress.h"
+#include "common/compress/zst/compress.h"
 #include "common/crypto/hash.h"
 #include "common/io/bufferRead.h"
 #include "common/io/bufferWrite.h"
@@ -20,12 +25,14 @@ stress testing as needed.
 #include "common/io/fdWrite.h"
 #include "common/io/filter/filter.h"
 #include "common/io/filter/sink.h"
+#include "common/io/filter/stat.h"
 #include "common/io/io.h"
 #include "common/type/object.h"
 #include "protocol/client.h"
 #include "protocol/server.h"
 #include "storage/posix/storage.h"
 #include "storage/remote/protocol.h"
+#include "storage/s3/helper.h"
 
 /***********************************************************************************************************************************
 Driver to test storageNewItrP()
@@ -271,8 +278,14 @@ testRun(void)
         uint64_t md5Total = 1;
         uint64_t sha1Total = 1;
         uint64_t sha256Total = 1;
+        uint64_t sha1SmallTotal = 1;
         uint64_t gzip6Total = 1;
+        uint64_t gzip6ThreadTotal = 1;
         uint64_t lz41Total = 1;
+        uint64_t zst3Total = 1;
+        uint64_t zst3ThreadTotal = 1;
+        uint64_t chainSerialTotal = 1;
+        uint64_t chainPipelineTotal = 1;
 
         for (unsigned int idx = 0; idx < iteration; idx++)
         {
@@ -319,17 +332,52 @@ testRun(void)
             }
             MEM_CONTEXT_TEMP_END();
 
+            // -------------------------------------------------------------------------------------------------------------------------
+            TEST_LOG_FMT("sha1 8KiB files iteration %u", idx + 1);
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                const size_t smallSize = 8192;
+                const uint64_t benchMarkBegin = timeMSec();
+
+                for (size_t inputIdx = 0; inputIdx < bufUsed(input); inputIdx += smallSize)
+                {
+                    MEM_CONTEXT_TEMP_BEGIN()
+                    {
+                        IoFilter *const hash = cryptoHashNew(hashTypeSha1);
+
+                        ioFilterProcessIn(hash, BUF(bufPtrConst(input) + inputIdx, smallSize));
+                        ioFilterResult(hash);
+                    }
+                    MEM_CONTEXT_TEMP_END();
+                }
+
+                sha1SmallTotal += timeMSec() - benchMarkBegin;
+            }
+            MEM_CONTEXT_TEMP_END();
+
             // -------------------------------------------------------------------------------------------------------------------------
             TEST_LOG_FMT("gzip -6 iteration %u", idx + 1);
 
             MEM_CONTEXT_TEMP_BEGIN()
             {
                 BENCHMARK_BEGIN();
-                BENCHMARK_FILTER_ADD(gzCompressNew(6, false));
+                BENCHMARK_FILTER_ADD(gzCompressNewP(6));
                 BENCHMARK_END(gzip6Total);
             }
             MEM_CONTEXT_TEMP_END();
 
+            // -------------------------------------------------------------------------------------------------------------------------
+            TEST_LOG_FMT("gzip -6 with 4 threads iteration %u", idx + 1);
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                BENCHMARK_BEGIN();
+                BENCHMARK_FILTER_ADD(gzCompressNewP(6, .thread = 4));
+                BENCHMARK_END(gzip6ThreadTotal);
+            }
+            MEM_CONTEXT_TEMP_END();
+
             // -------------------------------------------------------------------------------------------------------------------------
             TEST_LOG_FMT("lz4 -1 iteration %u", idx + 1);
 
@@ -340,6 +388,60 @@ testRun(void)
                 BENCHMARK_END(lz41Total);
             }
             MEM_CONTEXT_TEMP_END();
+
+#ifdef HAVE_LIBZST
+            // -------------------------------------------------------------------------------------------------------------------------
+            TEST_LOG_FMT("zst -3 iteration %u", idx + 1);
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                BENCHMARK_BEGIN();
+                BENCHMARK_FILTER_ADD(zstCompressNewP(3));
+                BENCHMARK_END(zst3Total);
+            }
+            MEM_CONTEXT_TEMP_END();
+
+            // -------------------------------------------------------------------------------------------------------------------------
+            TEST_LOG_FMT("zst -3 with 4 threads iteration %u", idx + 1);
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                BENCHMARK_BEGIN();
+                BENCHMARK_FILTER_ADD(zstCompressNewP(3, .thread = 4));
+                BENCHMARK_END(zst3ThreadTotal);
+            }
+            MEM_CONTEXT_TEMP_END();
+#endif // HAVE_LIBZST
+
+            // -------------------------------------------------------------------------------------------------------------------------
+            TEST_LOG_FMT("sha1/gzip -6 serial iteration %u", idx + 1);
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                BENCHMARK_BEGIN();
+                BENCHMARK_FILTER_ADD(cryptoHashNew(hashTypeSha1));
+                BENCHMARK_FILTER_ADD(gzCompressNewP(6));
+                BENCHMARK_END(chainSerialTotal);
+            }
+            MEM_CONTEXT_TEMP_END();
+
+            // -------------------------------------------------------------------------------------------------------------------------
+            TEST_LOG_FMT("sha1/gzip -6 pipelined iteration %u", idx + 1);
+
+            // Collect filter stats so the time spent in each stage can be reported
+            ioFilterStatEnabledSet(true);
+
+            MEM_CONTEXT_TEMP_BEGIN()
+            {
+                BENCHMARK_BEGIN();
+                BENCHMARK_FILTER_ADD(cryptoHashNew(hashTypeSha1));
+                BENCHMARK_FILTER_ADD(gzCompressNewP(6));
+                ioFilterGroupPipelineSet(ioWriteFilterGroup(write), true);
+                BENCHMARK_END(chainPipelineTotal);
+            }
+            MEM_CONTEXT_TEMP_END();
+
+            ioFilterStatEnabledSet(false);
         }
 
         // -------------------------------------------------------------------------------------------------------------------------
@@ -354,8 +456,416 @@ testRun(void)
         TEST_RESULT("md5", md5Total);
         TEST_RESULT("sha1", sha1Total);
         TEST_RESULT("sha256", sha256Total);
+        TEST_RESULT("sha1 8KiB files", sha1SmallTotal);
         TEST_RESULT("gzip -6", gzip6Total);
+        TEST_RESULT("gzip -6 with 4 threads", gzip6ThreadTotal);
         TEST_RESULT("lz4 -1", lz41Total);
+#ifdef HAVE_LIBZST
+        TEST_RESULT("zst -3", zst3Total);
+        TEST_RESULT("zst -3 with 4 threads", zst3ThreadTotal);
+#endif // HAVE_LIBZST
+        TEST_RESULT("sha1/gzip -6 serial", chainSerialTotal);
+        TEST_RESULT("sha1/gzip -6 pipelined", chainPipelineTotal);
+
+        // Report each stage of the pipeline. The stage with the lowest throughput per CPU second limits the
+        // throughput of the pipeline.
+        const List *const statTotalList = ioFilterStatTotalList();
+
+        for (unsigned int statIdx = 0; statTotalList != NULL && statIdx < lstSize(statTotalList); statIdx++)
+        {
+            const IoFilterStatTotal *const statTotal = lstGet(statTotalList, statIdx);
+            const uint64_t timeCpuMs = statTotal->stat.timeCpu / 1000000;
+            const uint64_t timeWallMs = statTotal->stat.timeWall / 1000000;
+
+            TEST_LOG_FMT(
+                "sha1/gzip -6 pipelined stage %s cpu time %" PRIu64 "ms, wall time %" PRIu64 "ms, avg throughput: %" PRIu64 "MB/s",
+                strZ(strIdToStr(statTotal->type)), timeCpuMs, timeWallMs,
+                statTotal->stat.bytesIn * 1000 / (statTotal->stat.timeCpu == 0 ? 1 : statTotal->stat.timeCpu));
+        }
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("benchmark object store"))
+    {
+        // 4MiB files with a 1MiB upload chunk size so multipart uploads are exercised
+        ASSERT(TEST_SCALE <= 1000);
+        const unsigned int fileTotal = 8 * TEST_SCALE;
+        const size_t fileSize = 4 * 1024 * 1024;
+
+        static const StorageHelper storageHelperList[] = {STORAGE_S3_HELPER, STORAGE_END_HELPER};
+        storageHelperInit(storageHelperList);
+
+        Buffer *const file = bufNew(fileSize);
+        memset(bufPtr(file), 'x', fileSize);
+        bufUsedSet(file, fileSize);
+
+        // Object store conditions to benchmark
+        static const struct
+        {
+            const char *name;                                       // Description of conditions
+            HrnObjStoreRunParam param;                              // Object store parameters
+        } benchmarkList[] =
+        {
+            {.name = "no latency"},
+            {.name = "20ms latency", .param = {.latency = 20}},
+            {.name = "20ms latency, throttle every 10th request", .param = {.latency = 20, .errorInterval = 10}},
+            {.name = "100MB/s per connection", .param = {.bytesPerSec = 100 * 1000 * 1000}},
+        };
+
+        for (unsigned int benchmarkIdx = 0; benchmarkIdx < LENGTH_OF(benchmarkList); benchmarkIdx++)
+        {
+            // ---------------------------------------------------------------------------------------------------------------------
+            TEST_TITLE_FMT("%u file(s) of %zuMiB with %s", fileTotal, fileSize / 1024 / 1024, benchmarkList[benchmarkIdx].name);
+
+            const unsigned int port = hrnServerPortNext();
+
+            HRN_FORK_BEGIN(.timeout = 60000)
+            {
+                HRN_FORK_CHILD_BEGIN(.prefix = "object store")
+                {
+                    hrnObjStoreRun(
+                        strNewFmt(TEST_PATH "/obj-store-%u", benchmarkIdx), port, benchmarkList[benchmarkIdx].param);
+                }
+                HRN_FORK_CHILD_END();
+
+                HRN_FORK_PARENT_BEGIN()
+                {
+                    StringList *argList = strLstNew();
+                    hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+                    hrnCfgArgRawZ(argList, cfgOptRepoType, "s3");
+                    hrnCfgArgRawZ(argList, cfgOptRepoPath, "/");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Bucket, "bucket");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Region, "us-east-1");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Endpoint, "s3.amazonaws.com");
+                    hrnCfgArgRawFmt(argList, cfgOptRepoStorageHost, "%s:%u", strZ(hrnServerHost()), port);
+                    hrnCfgArgRawZ(argList, cfgOptRepoStorageUploadChunkSize, "1MiB");
+
+                    // TLS can only be verified in a container
+                    if (TEST_IN_CONTAINER)
+                        hrnCfgArgRawZ(argList, cfgOptRepoStorageCaFile, HRN_SERVER_CA);
+                    else
+                        hrnCfgArgRawBool(argList, cfgOptRepoStorageVerifyTls, false);
+
+                    hrnCfgEnvRawZ(cfgOptRepoS3Key, "key");
+                    hrnCfgEnvRawZ(cfgOptRepoS3KeySecret, "secret");
+                    HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+
+                    Storage *const s3 = storageRepoGet(0, true);
+
+                    // Put files
+                    TimeMSec timeBegin = timeMSec();
+
+                    for (unsigned int fileIdx = 0; fileIdx < fileTotal; fileIdx++)
+                        storagePutP(storageNewWriteP(s3, strNewFmt("path/%02u/file%u", fileIdx % 16, fileIdx)), file);
+
+                    TEST_LOG_FMT(
+                        "put in %" PRIu64 "ms, %" PRIu64 "MB/s", timeMSec() - timeBegin,
+                        (uint64_t)fileTotal * fileSize * MSEC_PER_SEC / (timeMSec() - timeBegin + 1) / 1000000);
+
+                    // List files
+                    timeBegin = timeMSec();
+
+                    uint64_t listTotal = 0;
+                    StorageIterator *storageItr = storageNewItrP(s3, STRDEF("path"), .recurse = true);
+
+                    while (storageItrMore(storageItr))
+                    {
+                        if (storageItrNext(storageItr).type == storageTypeFile)
+                            listTotal++;
+                    }
+
+                    TEST_RESULT_UINT(listTotal, fileTotal, "check list total");
+
+                    TEST_LOG_FMT("list in %" PRIu64 "ms", timeMSec() - timeBegin);
+
+                    // Get files
+                    timeBegin = timeMSec();
+
+                    for (unsigned int fileIdx = 0; fileIdx < fileTotal; fileIdx++)
+                    {
+                        MEM_CONTEXT_TEMP_BEGIN()
+                        {
+                            storageGetP(storageNewReadP(s3, strNewFmt("path/%02u/file%u", fileIdx % 16, fileIdx)));
+                        }
+                        MEM_CONTEXT_TEMP_END();
+                    }
+
+                    TEST_LOG_FMT(
+                        "get in %" PRIu64 "ms, %" PRIu64 "MB/s", timeMSec() - timeBegin,
+                        (uint64_t)fileTotal * fileSize * MSEC_PER_SEC / (timeMSec() - timeBegin + 1) / 1000000);
+
+                    // Remove files
+                    timeBegin = timeMSec();
+
+                    storagePathRemoveP(s3, STRDEF("path"), .recurse = true);
+                    TEST_RESULT_BOOL(storageItrMore(storageNewItrP(s3, STRDEF("path"))), false, "check files removed");
+
+                    TEST_LOG_FMT("remove in %" PRIu64 "ms", timeMSec() - timeBegin);
+
+                    // Stop the object store
+                    hrnObjStoreStop(HRN_FORK_PROCESS_ID(0), port);
+                }
+                HRN_FORK_PARENT_END();
+            }
+            HRN_FORK_END();
+        }
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("benchmark object store path remove"))
+    {
+        // Small files in subpaths with a small list page size so a recursive list requires many pages
+        ASSERT(TEST_SCALE <= 1000);
+        const unsigned int pathTotal = 16;
+        const unsigned int fileTotal = 64 * TEST_SCALE;
+        const unsigned int listMax = 100;
+
+        static const StorageHelper storageHelperList[] = {STORAGE_S3_HELPER, STORAGE_END_HELPER};
+        storageHelperInit(storageHelperList);
+
+        // Object store conditions and partitions to benchmark
+        static const struct
+        {
+            const char *name;                                       // Description of conditions
+            unsigned int partitionMax;                              // Maximum concurrent partition list requests
+            HrnObjStoreRunParam param;                              // Object store parameters
+        } benchmarkList[] =
+        {
+            {.name = "no latency, 1 partition", .partitionMax = 1},
+            {.name = "no latency, 8 partitions", .partitionMax = 8},
+            {.name = "20ms latency, 1 partition", .partitionMax = 1, .param = {.latency = 20}},
+            {.name = "20ms latency, 8 partitions", .partitionMax = 8, .param = {.latency = 20}},
+        };
+
+        for (unsigned int benchmarkIdx = 0; benchmarkIdx < LENGTH_OF(benchmarkList); benchmarkIdx++)
+        {
+            // ---------------------------------------------------------------------------------------------------------------------
+            TEST_TITLE_FMT(
+                "remove %u path(s) of %u file(s) with %s", pathTotal, fileTotal, benchmarkList[benchmarkIdx].name);
+
+            const String *const objStorePath = strNewFmt(TEST_PATH "/obj-store-remove-%u", benchmarkIdx);
+            HrnObjStoreRunParam runParam = benchmarkList[benchmarkIdx].param;
+            runParam.listMax = listMax;
+
+            // Create objects directly in the object store path since putting them through the object store would be slow with
+            // latency
+            const Storage *const objStore = storagePosixNewP(objStorePath, .write = true);
+
+            for (unsigned int pathIdx = 0; pathIdx < pathTotal; pathIdx++)
+            {
+                MEM_CONTEXT_TEMP_BEGIN()
+                {
+                    for (unsigned int fileIdx = 0; fileIdx < fileTotal; fileIdx++)
+                    {
+                        storagePutP(
+                            storageNewWriteP(
+                                objStore, strNewFmt("object/path/%02u/file%05u", pathIdx, fileIdx), .noSyncFile = true,
+                                .noSyncPath = true),
+                            BUFSTRDEF("x"));
+                    }
+                }
+                MEM_CONTEXT_TEMP_END();
+            }
+
+            const unsigned int port = hrnServerPortNext();
+
+            HRN_FORK_BEGIN(.timeout = 60000)
+            {
+                HRN_FORK_CHILD_BEGIN(.prefix = "object store")
+                {
+                    hrnObjStoreRun(objStorePath, port, runParam);
+                }
+                HRN_FORK_CHILD_END();
+
+                HRN_FORK_PARENT_BEGIN()
+                {
+                    StringList *argList = strLstNew();
+                    hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+                    hrnCfgArgRawZ(argList, cfgOptRepoType, "s3");
+                    hrnCfgArgRawZ(argList, cfgOptRepoPath, "/");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Bucket, "bucket");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Region, "us-east-1");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Endpoint, "s3.amazonaws.com");
+                    hrnCfgArgRawFmt(argList, cfgOptRepoStorageHost, "%s:%u", strZ(hrnServerHost()), port);
+
+                    // TLS can only be verified in a container
+                    if (TEST_IN_CONTAINER)
+                        hrnCfgArgRawZ(argList, cfgOptRepoStorageCaFile, HRN_SERVER_CA);
+                    else
+                        hrnCfgArgRawBool(argList, cfgOptRepoStorageVerifyTls, false);
+
+                    hrnCfgEnvRawZ(cfgOptRepoS3Key, "key");
+                    hrnCfgEnvRawZ(cfgOptRepoS3KeySecret, "secret");
+                    HRN_CFG_LOAD(cfgCmdArchivePush, argList);
+
+                    Storage *const s3 = storageRepoGet(0, true);
+                    ((StorageS3 *)storageDriver(s3))->partitionMax = benchmarkList[benchmarkIdx].partitionMax;
+
+                    // Remove files
+                    const TimeMSec timeBegin = timeMSec();
+
+                    storagePathRemoveP(s3, STRDEF("path"), .recurse = true);
+
+                    TEST_LOG_FMT("remove in %" PRIu64 "ms", timeMSec() - timeBegin);
+
+                    TEST_RESULT_BOOL(storageItrMore(storageNewItrP(s3, STRDEF("path"))), false, "check files removed");
+
+                    // Stop the object store
+                    hrnObjStoreStop(HRN_FORK_PROCESS_ID(0), port);
+                }
+                HRN_FORK_PARENT_END();
+            }
+            HRN_FORK_END();
+        }
+    }
+
+    // *****************************************************************************************************************************
+    if (testBegin("benchmark block incremental restore"))
+    {
+        // File with one block changed in each backup so restore must read from every reference
+        ASSERT(TEST_SCALE <= 1000);
+        const unsigned int referenceTotal = 30;
+        const size_t blockSize = 8192;
+        const unsigned int restoreTotal = 4 * TEST_SCALE;
+
+        static const StorageHelper storageHelperList[] = {STORAGE_S3_HELPER, STORAGE_END_HELPER};
+        storageHelperInit(storageHelperList);
+
+        // Object store conditions to benchmark
+        static const struct
+        {
+            const char *name;                                       // Description of conditions
+            HrnObjStoreRunParam param;                              // Object store parameters
+        } benchmarkList[] =
+        {
+            {.name = "no latency"},
+            {.name = "20ms latency", .param = {.latency = 20}},
+        };
+
+        for (unsigned int benchmarkIdx = 0; benchmarkIdx < LENGTH_OF(benchmarkList); benchmarkIdx++)
+        {
+            // ---------------------------------------------------------------------------------------------------------------------
+            TEST_TITLE_FMT(
+                "%u restore(s) of a file with %u references with %s", restoreTotal, referenceTotal,
+                benchmarkList[benchmarkIdx].name);
+
+            const unsigned int port = hrnServerPortNext();
+
+            HRN_FORK_BEGIN(.timeout = 60000)
+            {
+                HRN_FORK_CHILD_BEGIN(.prefix = "object store")
+                {
+                    hrnObjStoreRun(
+                        strNewFmt(TEST_PATH "/obj-store-bi-%u", benchmarkIdx), port, benchmarkList[benchmarkIdx].param);
+                }
+                HRN_FORK_CHILD_END();
+
+                HRN_FORK_PARENT_BEGIN()
+                {
+                    StringList *argList = strLstNew();
+                    hrnCfgArgRawZ(argList, cfgOptStanza, "test");
+                    hrnCfgArgRawZ(argList, cfgOptPgPath, TEST_PATH "/pg");
+                    hrnCfgArgRawZ(argList, cfgOptRepoType, "s3");
+                    hrnCfgArgRawZ(argList, cfgOptRepoPath, "/");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Bucket, "bucket");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Region, "us-east-1");
+                    hrnCfgArgRawZ(argList, cfgOptRepoS3Endpoint, "s3.amazonaws.com");
+                    hrnCfgArgRawFmt(argList, cfgOptRepoStorageHost, "%s:%u", strZ(hrnServerHost()), port);
+
+                    // TLS can only be verified in a container
+                    if (TEST_IN_CONTAINER)
+                        hrnCfgArgRawZ(argList, cfgOptRepoStorageCaFile, HRN_SERVER_CA);
+                    else
+                        hrnCfgArgRawBool(argList, cfgOptRepoStorageVerifyTls, false);
+
+                    hrnCfgEnvRawZ(cfgOptRepoS3Key, "key");
+                    hrnCfgEnvRawZ(cfgOptRepoS3KeySecret, "secret");
+                    HRN_CFG_LOAD(cfgCmdRestore, argList);
+
+                    HRN_STORAGE_PATH_CREATE(storagePgWrite(), NULL, .mode = 0700);
+
+                    // Write a backup for each reference that changes one block
+                    Buffer *const file = bufNew(blockSize * referenceTotal);
+                    memset(bufPtr(file), 0, bufSize(file));
+                    bufUsedSet(file, bufSize(file));
+
+                    StringList *const referenceList = strLstNew();
+                    const String *repoFileName = NULL;
+                    Buffer *repoFile = NULL;
+                    size_t mapSize = 0;
+
+                    for (unsigned int referenceIdx = 0; referenceIdx < referenceTotal; referenceIdx++)
+                    {
+                        strLstAddFmt(referenceList, "backup-%02u", referenceIdx);
+                        memset(bufPtr(file) + referenceIdx * blockSize, (int)referenceIdx + 1, blockSize);
+
+                        Buffer *const repoFileNext = bufNew(0);
+                        IoWrite *const write = ioBufferWriteNew(repoFileNext);
+                        ioFilterGroupAdd(
+                            ioWriteFilterGroup(write),
+                            blockIncrNew(
+                                blockSize, blockSize, 11, referenceIdx, 0, 0,
+                                repoFile == NULL ? NULL : BUF(bufPtr(repoFile) + bufUsed(repoFile) - mapSize, mapSize), NULL,
+                                NULL));
+                        ioWriteOpen(write);
+                        ioWrite(write, file);
+                        ioWriteClose(write);
+
+                        repoFile = repoFileNext;
+                        mapSize = (size_t)pckReadU64P(ioFilterGroupResultP(ioWriteFilterGroup(write), BLOCK_INCR_FILTER_TYPE));
+
+                        repoFileName = strNewFmt(
+                            STORAGE_REPO_BACKUP "/%s/pg_data/file.pgbi", strZ(strLstGet(referenceList, referenceIdx)));
+
+                        storagePutP(storageNewWriteP(storageRepoWrite(), repoFileName), repoFile);
+                    }
+
+                    // Restore the file
+                    const TimeMSec timeBegin = timeMSec();
+
+                    for (unsigned int restoreIdx = 0; restoreIdx < restoreTotal; restoreIdx++)
+                    {
+                        MEM_CONTEXT_TEMP_BEGIN()
+                        {
+                            storageRemoveP(storagePgWrite(), STRDEF("file"));
+
+                            List *const fileList = lstNewP(sizeof(RestoreFile));
+
+                            const RestoreFile restoreFileData =
+                            {
+                                .name = STRDEF("file"),
+                                .checksum = cryptoHashOne(hashTypeSha1, file),
+                                .size = bufUsed(file),
+                                .mode = 0600,
+                                .offset = bufUsed(repoFile) - mapSize,
+                                .limit = VARUINT64(mapSize),
+                                .blockIncrMapSize = mapSize,
+                                .blockIncrSize = blockSize,
+                                .blockIncrChecksumSize = 11,
+                                .manifestFile = STRDEF("pg_data/file"),
+                            };
+
+                            lstAdd(fileList, &restoreFileData);
+
+                            restoreFile(
+                                repoFileName, 0, compressTypeNone, 0, false, false, false, cipherTypeNone, NULL, hashTypeSha1,
+                                referenceList, 0, true, false, fileList);
+                        }
+                        MEM_CONTEXT_TEMP_END();
+                    }
+
+                    TEST_LOG_FMT("restore in %" PRIu64 "ms", timeMSec() - timeBegin);
+
+                    TEST_RESULT_BOOL(bufEq(storageGetP(storageNewReadP(storagePg(), STRDEF("file"))), file), true, "check file");
+                    HRN_STORAGE_PATH_REMOVE(storagePgWrite(), NULL, .recurse = true);
+
+                    // Stop the object store
+                    hrnObjStoreStop(HRN_FORK_PROCESS_ID(0), port);
+                }
+                HRN_FORK_PARENT_END();
+            }
+            HRN_FORK_END();
+        }
     }
 
     FUNCTION_HARNESS_RETURN_VOID();
@@ -883,6 +883,7 @@ testRun(void)
 
         TEST_RESULT_VOID(storagePathCreateP(storageTest, pathName), "create path to sync");
         TEST_RESULT_VOID(storagePathSyncP(storageTest, pathName), "sync path");
+        TEST_RESULT_VOID(storagePathSyncP(storageTest, pathName, .fs = true), "sync filesystem");
     }
 
     // *****************************************************************************************************************************
@@ -1233,6 +1234,7 @@ testRun(void)
         }
         MEM_CONTEXT_TEMP_END();
 
+        TEST_RESULT_VOID(storageReadPrefetch(file), "prefetch does nothing");
         TEST_RESULT_BOOL(ioReadOpen(storageReadIo(file)), true, "open file");
         TEST_RESULT_STR(storageReadName(file), fileName, "check file name");
         TEST_RESULT_UINT(storageReadType(file), STORAGE_POSIX_TYPE, "check file type");
@@ -1433,6 +1435,111 @@ testRun(void)
         TEST_STORAGE_GET(storageTest, "no-truncate", "ABC");
         TEST_RESULT_UINT(storageInfoP(storageTest, STRDEF("no-truncate")).mode, 0600, "check mode");
         TEST_RESULT_INT(storageInfoP(storageTest, STRDEF("no-truncate")).timeModified, 77777, "check time");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("preallocate");
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("preallocate"), .noAtomic = true, .preallocate = 8), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_UINT(storageInfoP(storageTest, STRDEF("preallocate")).size, 0, "size is not changed");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUFSTRDEF("ABCDEFGH")), "write file");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+
+        TEST_STORAGE_GET(storageTest, "preallocate", "ABCDEFGH");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("preallocate ignores invalid size");
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("preallocate"), .noAtomic = true, .preallocate = UINT64_MAX),
+            "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+
+        TEST_STORAGE_GET_EMPTY(storageTest, "preallocate");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("preallocate error");
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("preallocate"), .noAtomic = true, .preallocate = INT64_MAX),
+            "new write file");
+        TEST_ERROR(
+            ioWriteOpen(storageWriteIo(file)), FileWriteError,
+            "unable to preallocate '" TEST_PATH "/preallocate': [27] File too large");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sync defer");
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("sync-defer"), .noAtomic = true, .syncDefer = true), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUFSTRDEF("DEFER")), "write file");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+        TEST_RESULT_VOID(storagePathSyncP(storageTest, NULL, .fs = true), "sync filesystem");
+
+        TEST_STORAGE_GET(storageTest, "sync-defer", "DEFER");
+
+        TEST_TITLE("sync defer falls back to fsync when syncfs() does not report writeback errors");
+
+        TEST_RESULT_BOOL(storagePosixSyncDeferRelease("Linux", "6.1.0-13-amd64"), true, "Linux 6.1");
+        TEST_RESULT_BOOL(storagePosixSyncDeferRelease("Linux", "5.8.0"), true, "Linux 5.8");
+        TEST_RESULT_BOOL(storagePosixSyncDeferRelease("Linux", "5.7.19"), false, "Linux 5.7");
+        TEST_RESULT_BOOL(storagePosixSyncDeferRelease("Linux", "5"), false, "Linux 5 without minor");
+        TEST_RESULT_BOOL(storagePosixSyncDeferRelease("Linux", "4.18.0-553.el8"), false, "Linux 4.18");
+        TEST_RESULT_BOOL(storagePosixSyncDeferRelease("SunOS", "5.11"), false, "not Linux");
+
+        storagePosixSyncDeferResult = false;
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("sync-defer"), .noAtomic = true, .syncDefer = true), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), BUFSTRDEF("FSYNC")), "write file");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+
+        TEST_STORAGE_GET(storageTest, "sync-defer", "FSYNC");
+
+        storagePosixSyncDeferResult = -1;
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sparse");
+
+        // Data is written to the driver in chunks of the buffer size so the blocks checked for zeroes are aligned with the file
+        ioBufferSizeSet(8192);
+
+        // Data followed by a zero block, a block starting with data, a block ending with data, a zero block, and a partial block
+        Buffer *sparseBuffer = bufNew(4 * 4096 + 4096 + 10);
+        memset(bufPtr(sparseBuffer), 0, bufSize(sparseBuffer));
+        memset(bufPtr(sparseBuffer), 'X', 100);
+        bufPtr(sparseBuffer)[2 * 4096] = 'Y';
+        bufPtr(sparseBuffer)[4 * 4096 - 1] = 'Z';
+        bufUsedSet(sparseBuffer, bufSize(sparseBuffer));
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("sparse"), .noAtomic = true, .sparse = true), "new write file");
+        TEST_RESULT_BOOL(storageWriteSparse(file), true, "file will be sparse");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), sparseBuffer), "write file");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+
+        TEST_RESULT_BOOL(bufEq(storageGetP(storageNewReadP(storageTest, STRDEF("sparse"))), sparseBuffer), true, "check file");
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("sparse with trailing hole");
+
+        sparseBuffer = bufNew(4096);
+        memset(bufPtr(sparseBuffer), 0, bufSize(sparseBuffer));
+        bufUsedSet(sparseBuffer, bufSize(sparseBuffer));
+
+        TEST_ASSIGN(
+            file, storageNewWriteP(storageTest, STRDEF("sparse"), .noAtomic = true, .sparse = true), "new write file");
+        TEST_RESULT_VOID(ioWriteOpen(storageWriteIo(file)), "open file");
+        TEST_RESULT_VOID(ioWrite(storageWriteIo(file), sparseBuffer), "write file");
+        TEST_RESULT_VOID(ioWriteClose(storageWriteIo(file)), "close file");
+
+        TEST_RESULT_BOOL(bufEq(storageGetP(storageNewReadP(storageTest, STRDEF("sparse"))), sparseBuffer), true, "check file");
+        TEST_RESULT_UINT(storageInfoP(storageTest, STRDEF("sparse")).size, 4096, "check size");
     }
 
     // *****************************************************************************************************************************
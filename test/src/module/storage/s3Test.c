@@ -493,6 +493,18 @@ testRun(void)
                     strNewBuf(storageGetP(storageNewReadP(s3, STRDEF("file.txt"), .offset = 1, .limit = VARUINT64(21)))),
                     "this is a sample file", "get file");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get file with prefetch");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/file.txt", .range = "1-21");
+                testResponseP(service, .content = "this is a sample file");
+
+                StorageRead *read = NULL;
+                TEST_ASSIGN(read, storageNewReadP(s3, STRDEF("file.txt"), .offset = 1, .limit = VARUINT64(21)), "new read");
+                TEST_RESULT_VOID(storageReadPrefetch(read), "prefetch");
+                TEST_RESULT_VOID(storageReadPrefetch(read), "prefetch again does nothing");
+                TEST_RESULT_STR_Z(strNewBuf(storageGetP(read)), "this is a sample file", "get file");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("get file with retry");
 
@@ -764,7 +776,6 @@ testRun(void)
                 testRequestP(service, s3, HTTP_VERB_GET, "/file.txt", .accessKey = "x", .securityToken = "z", .sseC = "rA1P");
                 testResponseP(service, .code = 303, .content = "CONTENT");
 
-                StorageRead *read = NULL;
                 TEST_ASSIGN(read, storageNewReadP(s3, STRDEF("file.txt"), .ignoreMissing = true), "new read file");
                 TEST_RESULT_BOOL(storageReadIgnoreMissing(read), true, "check ignore missing");
                 TEST_RESULT_STR_Z(storageReadName(read), "/file.txt", "check name");
@@ -1382,7 +1393,7 @@ testRun(void)
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("remove files from root");
 
-                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2");
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2");
                 testResponseP(
                     service,
                     .content =
@@ -1392,6 +1403,18 @@ testRun(void)
                         "    <Contents>"
                         "        <Key>test1.txt</Key>"
                         "    </Contents>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>path1/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "</ListBucketResult>");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path1%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
                         "    <Contents>"
                         "        <Key>path1/xxx.zzz</Key>"
                         "    </Contents>"
@@ -1413,7 +1436,7 @@ testRun(void)
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("remove files in empty subpath (nothing to do)");
 
-                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2F");
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=path%2F");
                 testResponseP(
                     service,
                     .content =
@@ -1427,7 +1450,7 @@ testRun(void)
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("remove files with continuation");
 
-                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2Fto%2F");
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=path%2Fto%2F");
                 testResponseP(
                     service,
                     .content =
@@ -1443,7 +1466,18 @@ testRun(void)
                         "    </Contents>"
                         "</ListBucketResult>");
 
-                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?continuation-token=continue&list-type=2&prefix=path%2Fto%2F");
+                testRequestP(
+                    service, s3, HTTP_VERB_GET,
+                    "/bucket/?continuation-token=continue&delimiter=%2F&list-type=2&prefix=path%2Fto%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "</ListBucketResult>");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2Fto%2Ftest3%2F");
                 testResponseP(
                     service,
                     .content =
@@ -1451,10 +1485,10 @@ testRun(void)
                         "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
                         "    <IsTruncated>false</IsTruncated>"
                         "    <Contents>"
-                        "        <Key>path/to/test3.txt</Key>"
+                        "        <Key>path/to/test3/test3.txt</Key>"
                         "    </Contents>"
                         "    <Contents>"
-                        "        <Key>path/to/test2.txt</Key>"
+                        "        <Key>path/to/test3/test2.txt</Key>"
                         "    </Contents>"
                         "</ListBucketResult>");
 
@@ -1464,7 +1498,7 @@ testRun(void)
                         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
                         "<Delete><Quiet>true</Quiet>"
                         "<Object><Key>path/to/test1.txt</Key></Object>"
-                        "<Object><Key>path/to/test3.txt</Key></Object>"
+                        "<Object><Key>path/to/test3/test3.txt</Key></Object>"
                         "</Delete>\n");
                 testResponseP(service);
 
@@ -1473,16 +1507,73 @@ testRun(void)
                     .content =
                         "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
                         "<Delete><Quiet>true</Quiet>"
-                        "<Object><Key>path/to/test2.txt</Key></Object>"
+                        "<Object><Key>path/to/test3/test2.txt</Key></Object>"
                         "</Delete>\n");
                 testResponseP(service);
 
                 TEST_RESULT_VOID(storagePathRemoveP(s3, STRDEF("/path/to"), .recurse = true), "remove");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("remove subpaths as partitions");
+
+                // Limit concurrent list requests so the requests are sequential for testing
+                driver->partitionMax = 1;
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=path%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>path/a/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "   <CommonPrefixes>"
+                        "       <Prefix>path/b/</Prefix>"
+                        "   </CommonPrefixes>"
+                        "</ListBucketResult>");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2Fa%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/a/1.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2Fb%2F");
+                testResponseP(
+                    service,
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                        "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+                        "    <IsTruncated>false</IsTruncated>"
+                        "    <Contents>"
+                        "        <Key>path/b/2.txt</Key>"
+                        "    </Contents>"
+                        "</ListBucketResult>");
+
+                testRequestP(
+                    service, s3, HTTP_VERB_POST, "/bucket/?delete=",
+                    .content =
+                        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                        "<Delete><Quiet>true</Quiet>"
+                        "<Object><Key>path/a/1.txt</Key></Object>"
+                        "<Object><Key>path/b/2.txt</Key></Object>"
+                        "</Delete>\n");
+                testResponseP(service);
+
+                TEST_RESULT_VOID(storagePathRemoveP(s3, STRDEF("/path"), .recurse = true), "remove");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 TEST_TITLE("path remove error and retry");
 
-                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?list-type=2&prefix=path%2F");
+                testRequestP(service, s3, HTTP_VERB_GET, "/bucket/?delimiter=%2F&list-type=2&prefix=path%2F");
                 testResponseP(
                     service,
                     .content =
@@ -1655,6 +1746,23 @@ testRun(void)
                 TEST_RESULT_PTR(
                     storageGetP(storageNewReadP(s3, STRDEF("missing_file"), .ignoreMissing = true)), NULL, "missing file");
 
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get file with prefetch and time limit");
+
+                testRequestP(service, s3, HTTP_VERB_GET, "/path/3/test_file?versionId=bbbb", .requesterPays = true);
+                testResponseP(service, .content = "123456");
+
+                TEST_ASSIGN(read, storageNewReadP(s3, STRDEF("/path/3/test_file")), "new read");
+                TEST_RESULT_VOID(storageReadPrefetch(read), "prefetch");
+                TEST_RESULT_STR_Z(strNewBuf(storageGetP(read)), "123456", "get file");
+
+                // -----------------------------------------------------------------------------------------------------------------
+                TEST_TITLE("get missing file with prefetch and time limit");
+
+                TEST_ASSIGN(read, storageNewReadP(s3, STRDEF("missing_file"), .ignoreMissing = true), "new read");
+                TEST_RESULT_VOID(storageReadPrefetch(read), "prefetch does nothing");
+                TEST_RESULT_PTR(storageGetP(read), NULL, "missing file");
+
                 // -----------------------------------------------------------------------------------------------------------------
                 hrnServerScriptEnd(service);
             }
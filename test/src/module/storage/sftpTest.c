@@ -6129,6 +6129,178 @@ testRun(void)
 
         memContextFree(objMemContext((StorageSftp *)storageDriver(storageTest)));
 
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get - read window larger than buffer size");
+
+        hrnLibSsh2ScriptSet((HrnLibSsh2 [])
+        {
+            HRNLIBSSH2_MACRO_STARTUP(),
+            {.function = HRNLIBSSH2_SFTP_OPEN_EX, .param = "[\"" TEST_PATH "/test.txt\",1,0,0]"},
+            {.function = HRNLIBSSH2_SFTP_FSTAT_EX, .param = "[0]", .resultInt = LIBSSH2_ERROR_EAGAIN},
+            {.function = HRNLIBSSH2_SESSION_BLOCK_DIRECTIONS, .resultInt = SSH2_NO_BLOCK_READING_WRITING},
+            {.function = HRNLIBSSH2_SFTP_FSTAT_EX, .param = "[0]", .flags = LIBSSH2_SFTP_ATTR_SIZE, .filesize = 9},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = 4, .readBuffer = STRDEF("TEST")},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = 3, .readBuffer = STRDEF("FIL")},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = LIBSSH2_ERROR_EAGAIN},
+            {.function = HRNLIBSSH2_SESSION_BLOCK_DIRECTIONS, .resultInt = SSH2_NO_BLOCK_READING_WRITING},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = 2, .readBuffer = STRDEF("E\n")},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = 0},
+            {.function = HRNLIBSSH2_SFTP_CLOSE_HANDLE},
+            HRNLIBSSH2_MACRO_SHUTDOWN()
+        });
+
+        storageTest = storageSftpNewP(
+            cfgOptionIdxStr(cfgOptRepoPath, repoIdx), cfgOptionIdxStr(cfgOptRepoSftpHost, repoIdx),
+            cfgOptionIdxUInt(cfgOptRepoSftpHostPort, repoIdx), cfgOptionIdxStr(cfgOptRepoSftpHostUser, repoIdx),
+            cfgOptionUInt64(cfgOptIoTimeout), cfgOptionIdxStr(cfgOptRepoSftpPrivateKeyFile, repoIdx),
+            cfgOptionIdxStrId(cfgOptRepoSftpHostKeyHashType, repoIdx), .modeFile = STORAGE_MODE_FILE_DEFAULT,
+            .modePath = STORAGE_MODE_PATH_DEFAULT, .keyPub = cfgOptionIdxStrNull(cfgOptRepoSftpPublicKeyFile, repoIdx),
+            .keyPassphrase = cfgOptionIdxStrNull(cfgOptRepoSftpPrivateKeyPassphrase, repoIdx),
+            .hostFingerprint = cfgOptionIdxStrNull(cfgOptRepoSftpHostFingerprint, repoIdx),
+            .hostKeyCheckType = cfgOptionIdxStrId(cfgOptRepoSftpHostKeyCheckType, repoIdx),
+            .knownHosts = strLstNewVarLst(cfgOptionIdxLst(cfgOptRepoSftpKnownHost, repoIdx)), .write = true, .window = 4);
+
+        TEST_ASSIGN(buffer, storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"))), "get text");
+        TEST_RESULT_UINT(bufSize(buffer), 9, "check size");
+        TEST_RESULT_BOOL(memcmp(bufPtrConst(buffer), "TESTFILE\n", bufSize(buffer)) == 0, true, "check content");
+
+        memContextFree(objMemContext((StorageSftp *)storageDriver(storageTest)));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get - read window does not request past limit");
+
+        hrnLibSsh2ScriptSet((HrnLibSsh2 [])
+        {
+            HRNLIBSSH2_MACRO_STARTUP(),
+            {.function = HRNLIBSSH2_SFTP_OPEN_EX, .param = "[\"" TEST_PATH "/test.txt\",1,0,0]"},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = 4, .readBuffer = STRDEF("TEST")},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[1]", .resultInt = 1, .readBuffer = STRDEF("F")},
+            {.function = HRNLIBSSH2_SFTP_CLOSE_HANDLE},
+            HRNLIBSSH2_MACRO_SHUTDOWN()
+        });
+
+        storageTest = storageSftpNewP(
+            cfgOptionIdxStr(cfgOptRepoPath, repoIdx), cfgOptionIdxStr(cfgOptRepoSftpHost, repoIdx),
+            cfgOptionIdxUInt(cfgOptRepoSftpHostPort, repoIdx), cfgOptionIdxStr(cfgOptRepoSftpHostUser, repoIdx),
+            cfgOptionUInt64(cfgOptIoTimeout), cfgOptionIdxStr(cfgOptRepoSftpPrivateKeyFile, repoIdx),
+            cfgOptionIdxStrId(cfgOptRepoSftpHostKeyHashType, repoIdx), .modeFile = STORAGE_MODE_FILE_DEFAULT,
+            .modePath = STORAGE_MODE_PATH_DEFAULT, .keyPub = cfgOptionIdxStrNull(cfgOptRepoSftpPublicKeyFile, repoIdx),
+            .keyPassphrase = cfgOptionIdxStrNull(cfgOptRepoSftpPrivateKeyPassphrase, repoIdx),
+            .hostFingerprint = cfgOptionIdxStrNull(cfgOptRepoSftpHostFingerprint, repoIdx),
+            .hostKeyCheckType = cfgOptionIdxStrId(cfgOptRepoSftpHostKeyCheckType, repoIdx),
+            .knownHosts = strLstNewVarLst(cfgOptionIdxLst(cfgOptRepoSftpKnownHost, repoIdx)), .write = true, .window = 4);
+
+        TEST_ASSIGN(
+            buffer, storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"), .limit = VARUINT64(5))), "get text");
+        TEST_RESULT_UINT(bufSize(buffer), 5, "check size");
+        TEST_RESULT_BOOL(memcmp(bufPtrConst(buffer), "TESTF", bufSize(buffer)) == 0, true, "check content");
+
+        memContextFree(objMemContext((StorageSftp *)storageDriver(storageTest)));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("get - read window sized to the data to be read");
+
+        hrnLibSsh2ScriptSet((HrnLibSsh2 [])
+        {
+            HRNLIBSSH2_MACRO_STARTUP(),
+            // Window sized to file size
+            {.function = HRNLIBSSH2_SFTP_OPEN_EX, .param = "[\"" TEST_PATH "/test.txt\",1,0,0]"},
+            {.function = HRNLIBSSH2_SFTP_FSTAT_EX, .param = "[0]", .flags = LIBSSH2_SFTP_ATTR_SIZE, .filesize = 3},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[3]", .resultInt = 3, .readBuffer = STRDEF("ABC")},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[3]", .resultInt = 0},
+            {.function = HRNLIBSSH2_SFTP_CLOSE_HANDLE},
+            // Window sized to limit
+            {.function = HRNLIBSSH2_SFTP_OPEN_EX, .param = "[\"" TEST_PATH "/test.txt\",1,0,0]"},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[2]", .resultInt = 2, .readBuffer = STRDEF("TE")},
+            {.function = HRNLIBSSH2_SFTP_CLOSE_HANDLE},
+            // Full window when fstat fails
+            {.function = HRNLIBSSH2_SFTP_OPEN_EX, .param = "[\"" TEST_PATH "/test.txt\",1,0,0]"},
+            {.function = HRNLIBSSH2_SFTP_FSTAT_EX, .param = "[0]", .resultInt = LIBSSH2_ERROR_SFTP_PROTOCOL},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = 3, .readBuffer = STRDEF("XYZ")},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = 0},
+            {.function = HRNLIBSSH2_SFTP_CLOSE_HANDLE},
+            // Full window when fstat does not return the size
+            {.function = HRNLIBSSH2_SFTP_OPEN_EX, .param = "[\"" TEST_PATH "/test.txt\",1,0,0]"},
+            {.function = HRNLIBSSH2_SFTP_FSTAT_EX, .param = "[0]"},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[4]", .resultInt = 0},
+            {.function = HRNLIBSSH2_SFTP_CLOSE_HANDLE},
+            // No window when offset is past the end of the file
+            {.function = HRNLIBSSH2_SFTP_OPEN_EX, .param = "[\"" TEST_PATH "/test.txt\",1,0,0]"},
+            {.function = HRNLIBSSH2_SFTP_SEEK64, .param = "[5]"},
+            {.function = HRNLIBSSH2_SFTP_FSTAT_EX, .param = "[0]", .flags = LIBSSH2_SFTP_ATTR_SIZE, .filesize = 3},
+            {.function = HRNLIBSSH2_SFTP_READ, .param = "[2]", .resultInt = 0},
+            {.function = HRNLIBSSH2_SFTP_CLOSE_HANDLE},
+            HRNLIBSSH2_MACRO_SHUTDOWN()
+        });
+
+        storageTest = storageSftpNewP(
+            cfgOptionIdxStr(cfgOptRepoPath, repoIdx), cfgOptionIdxStr(cfgOptRepoSftpHost, repoIdx),
+            cfgOptionIdxUInt(cfgOptRepoSftpHostPort, repoIdx), cfgOptionIdxStr(cfgOptRepoSftpHostUser, repoIdx),
+            cfgOptionUInt64(cfgOptIoTimeout), cfgOptionIdxStr(cfgOptRepoSftpPrivateKeyFile, repoIdx),
+            cfgOptionIdxStrId(cfgOptRepoSftpHostKeyHashType, repoIdx), .modeFile = STORAGE_MODE_FILE_DEFAULT,
+            .modePath = STORAGE_MODE_PATH_DEFAULT, .keyPub = cfgOptionIdxStrNull(cfgOptRepoSftpPublicKeyFile, repoIdx),
+            .keyPassphrase = cfgOptionIdxStrNull(cfgOptRepoSftpPrivateKeyPassphrase, repoIdx),
+            .hostFingerprint = cfgOptionIdxStrNull(cfgOptRepoSftpHostFingerprint, repoIdx),
+            .hostKeyCheckType = cfgOptionIdxStrId(cfgOptRepoSftpHostKeyCheckType, repoIdx),
+            .knownHosts = strLstNewVarLst(cfgOptionIdxLst(cfgOptRepoSftpKnownHost, repoIdx)), .write = true, .window = 4);
+
+        TEST_ASSIGN(buffer, storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"))), "get file size");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "ABC", "check content");
+        TEST_ASSIGN(
+            buffer, storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"), .limit = VARUINT64(2))), "get limit");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "TE", "check content");
+        TEST_ASSIGN(buffer, storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"))), "get fstat error");
+        TEST_RESULT_STR_Z(strNewBuf(buffer), "XYZ", "check content");
+        TEST_ASSIGN(buffer, storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"))), "get fstat no size");
+        TEST_RESULT_UINT(bufUsed(buffer), 0, "check size");
+        TEST_ASSIGN(
+            buffer, storageGetP(storageNewReadP(storageTest, STRDEF(TEST_PATH "/test.txt"), .offset = 5)), "get past end");
+        TEST_RESULT_UINT(bufUsed(buffer), 0, "check size");
+
+        memContextFree(objMemContext((StorageSftp *)storageDriver(storageTest)));
+
+        // -------------------------------------------------------------------------------------------------------------------------
+        TEST_TITLE("put - write window larger than buffer size");
+
+        ioBufferSizeSet(3);
+
+        hrnLibSsh2ScriptSet((HrnLibSsh2 [])
+        {
+            HRNLIBSSH2_MACRO_STARTUP(),
+            {.function = HRNLIBSSH2_SFTP_OPEN_EX, .param = "[\"" TEST_PATH "/test.txt.pgbackrest.tmp\",26,416,0]"},
+            {.function = HRNLIBSSH2_SFTP_WRITE, .param = "[4]", .resultInt = 2},
+            {.function = HRNLIBSSH2_SFTP_WRITE, .param = "[4]", .resultInt = 1},
+            {.function = HRNLIBSSH2_SFTP_WRITE, .param = "[3]", .resultInt = 3},
+            {.function = HRNLIBSSH2_SFTP_WRITE, .param = "[3]", .resultInt = LIBSSH2_ERROR_EAGAIN},
+            {.function = HRNLIBSSH2_SESSION_BLOCK_DIRECTIONS, .resultInt = SSH2_NO_BLOCK_READING_WRITING},
+            {.function = HRNLIBSSH2_SFTP_WRITE, .param = "[3]", .resultInt = 1},
+            {.function = HRNLIBSSH2_SFTP_WRITE, .param = "[2]", .resultInt = 2},
+            {.function = HRNLIBSSH2_SFTP_FSYNC, .resultInt = LIBSSH2_ERROR_NONE},
+            {.function = HRNLIBSSH2_SFTP_CLOSE_HANDLE, .resultInt = LIBSSH2_ERROR_NONE},
+            {.function = HRNLIBSSH2_SFTP_RENAME_EX,
+             .param = "[\"" TEST_PATH "/test.txt.pgbackrest.tmp\",\"" TEST_PATH "/test.txt\",7]",
+             .resultInt = LIBSSH2_ERROR_NONE},
+            HRNLIBSSH2_MACRO_SHUTDOWN()
+        });
+
+        storageTest = storageSftpNewP(
+            cfgOptionIdxStr(cfgOptRepoPath, repoIdx), cfgOptionIdxStr(cfgOptRepoSftpHost, repoIdx),
+            cfgOptionIdxUInt(cfgOptRepoSftpHostPort, repoIdx), cfgOptionIdxStr(cfgOptRepoSftpHostUser, repoIdx),
+            cfgOptionUInt64(cfgOptIoTimeout), cfgOptionIdxStr(cfgOptRepoSftpPrivateKeyFile, repoIdx),
+            cfgOptionIdxStrId(cfgOptRepoSftpHostKeyHashType, repoIdx), .modeFile = STORAGE_MODE_FILE_DEFAULT,
+            .modePath = STORAGE_MODE_PATH_DEFAULT, .keyPub = cfgOptionIdxStrNull(cfgOptRepoSftpPublicKeyFile, repoIdx),
+            .keyPassphrase = cfgOptionIdxStrNull(cfgOptRepoSftpPrivateKeyPassphrase, repoIdx),
+            .hostFingerprint = cfgOptionIdxStrNull(cfgOptRepoSftpHostFingerprint, repoIdx),
+            .hostKeyCheckType = cfgOptionIdxStrId(cfgOptRepoSftpHostKeyCheckType, repoIdx),
+            .knownHosts = strLstNewVarLst(cfgOptionIdxLst(cfgOptRepoSftpKnownHost, repoIdx)), .write = true, .window = 4);
+
+        TEST_RESULT_VOID(
+            storagePutP(storageNewWriteP(storageTest, STRDEF(TEST_PATH "/test.txt")), BUFSTRDEF("TESTFILE\n")), "put test file");
+
+        memContextFree(objMemContext((StorageSftp *)storageDriver(storageTest)));
+
+        ioBufferSizeSet(2);
+
         // -------------------------------------------------------------------------------------------------------------------------
         TEST_TITLE("error on invalid read offset bytes");
 
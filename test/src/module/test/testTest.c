@@ -334,6 +334,7 @@ testRun(void)
                         "        lib_lz4,\n"
                         "        lib_pq,\n"
                         "        lib_ssh2,\n"
+                        "        lib_thread,\n"
                         "        lib_xml,\n"
                         "        lib_yaml,\n"
                         "        lib_z,\n"
@@ -457,6 +458,7 @@ testRun(void)
                         "        lib_lz4,\n"
                         "        lib_pq,\n"
                         "        lib_ssh2,\n"
+                        "        lib_thread,\n"
                         "        lib_xml,\n"
                         "        lib_yaml,\n"
                         "        lib_z,\n"
@@ -684,6 +686,7 @@ testRun(void)
                         "        lib_lz4,\n"
                         "        lib_pq,\n"
                         "        lib_ssh2,\n"
+                        "        lib_thread,\n"
                         "        lib_xml,\n"
                         "        lib_yaml,\n"
                         "        lib_z,\n"
@@ -868,6 +871,7 @@ testRun(void)
                         "        lib_lz4,\n"
                         "        lib_pq,\n"
                         "        lib_ssh2,\n"
+                        "        lib_thread,\n"
                         "        lib_xml,\n"
                         "        lib_yaml,\n"
                         "        lib_z,\n"
@@ -1045,6 +1049,7 @@ testRun(void)
                         "        lib_lz4,\n"
                         "        lib_pq,\n"
                         "        lib_ssh2,\n"
+                        "        lib_thread,\n"
                         "        lib_xml,\n"
                         "        lib_yaml,\n"
                         "        lib_z,\n"